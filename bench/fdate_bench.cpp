@@ -0,0 +1,465 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <benchmark/benchmark.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "CalendarTable.hpp"
+#include "DateTime.hpp"
+#include "DateTimeFormat.hpp"
+#include "TimeDelta.hpp"
+#include "datetime_wrapper.hpp"
+
+//=============================================================================
+// Entry points of the Fortran driver
+//=============================================================================
+
+extern "C" {
+auto fdate_bench_ftn_strptime(int count) -> int64_t;
+auto fdate_bench_ftn_strftime(int count) -> int64_t;
+auto fdate_bench_ftn_to_iso_string(int count) -> int64_t;
+auto fdate_bench_ftn_year(int count) -> int64_t;
+auto fdate_bench_ftn_julian_day(int count) -> double;
+auto fdate_bench_ftn_timedelta_to_string(int count) -> int64_t;
+}
+
+namespace {
+
+/** @brief Calls per iteration of the language boundary benchmarks */
+constexpr int BOUNDARY_CALLS = 1000;
+
+/** @brief Number of distinct timestamps cycled through by the getters */
+constexpr size_t SAMPLE_COUNT = 1024;
+
+/** @brief Spacing of the TimeDeltas formatted by the benchmarks */
+constexpr int64_t TIMEDELTA_STEP_MS = 3723004;
+
+/** @brief Number of distinct TimeDeltas formatted by the benchmarks */
+constexpr int TIMEDELTA_COUNT = 500;
+
+/** @brief A sample string for each of the automatically detected formats */
+struct s_FormatSample {
+  const char* format;
+  const char* sample;
+};
+
+/** @brief The auto-detected formats in order of precedence */
+constexpr std::array<s_FormatSample, 11> FORMAT_SAMPLES = {{
+    {"%Y-%m-%d %H:%M:%S", "2024-03-15 14:30:25"},
+    {"%Y-%m-%dT%H:%M:%SZ", "2024-03-15T14:30:25Z"},
+    {"%Y-%m-%dT%H:%M:%S", "2024-03-15T14:30:25"},
+    {"%Y/%m/%d %H:%M:%S", "2024/03/15 14:30:25"},
+    {"%Y.%m.%d %H:%M:%S", "2024.03.15 14:30:25"},
+    {"%Y%m%d%H%M%S", "20240315143025"},
+    {"%Y/%m/%d %H:%M", "2024/03/15 14:30"},
+    {"%Y-%m-%d", "2024-03-15"},
+    {"%Y/%m/%d", "2024/03/15"},
+    {"%Y.%m.%d", "2024.03.15"},
+    {"%Y%m%d", "20240315"},
+}};
+
+/**
+ * @brief Timestamps spread over several centuries with sub-second parts
+ */
+auto sample_timestamps() -> const std::vector<int64_t>& {
+  static const auto timestamps = [] {
+    std::vector<int64_t> values(SAMPLE_COUNT);
+    int64_t t = DateTime(1850, 1, 1).timestamp();
+    for (auto& value : values) {
+      value = t;
+      t += 7919LL * 3600LL * 1000LL + 123;
+    }
+    return values;
+  }();
+  return timestamps;
+}
+
+/**
+ * @brief Timestamps spread over the window of CalendarTable
+ */
+auto sample_window_timestamps() -> const std::vector<int64_t>& {
+  static const auto timestamps = [] {
+    constexpr int64_t MS_PER_DAY = 86400000;
+    const auto span = static_cast<int64_t>(CalendarTable::DAY_COUNT) - 1;
+    std::vector<int64_t> values(SAMPLE_COUNT);
+    for (size_t i = 0; i < SAMPLE_COUNT; ++i) {
+      const auto day = CalendarTable::FIRST_DAY +
+                       span * static_cast<int64_t>(i) /
+                           static_cast<int64_t>(SAMPLE_COUNT - 1);
+      values[i] = day * MS_PER_DAY + static_cast<int64_t>(i) * 84317;
+    }
+    return values;
+  }();
+  return timestamps;
+}
+
+//=============================================================================
+// C++ API
+//=============================================================================
+
+void BM_StrptimeAuto(benchmark::State& state) {
+  const auto& entry = FORMAT_SAMPLES[static_cast<size_t>(state.range(0))];
+  const std::string str(entry.sample);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DateTime::strptime(str));
+  }
+  state.SetLabel(entry.format);
+}
+BENCHMARK(BM_StrptimeAuto)->DenseRange(0, FORMAT_SAMPLES.size() - 1);
+
+void BM_StrptimeExplicit(benchmark::State& state) {
+  const auto& entry = FORMAT_SAMPLES[static_cast<size_t>(state.range(0))];
+  const std::string str(entry.sample);
+  const std::string format(entry.format);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DateTime::strptime(str, format));
+  }
+  state.SetLabel(entry.format);
+}
+BENCHMARK(BM_StrptimeExplicit)->DenseRange(0, FORMAT_SAMPLES.size() - 1);
+
+void BM_StrptimeCompiled(benchmark::State& state) {
+  const auto& entry = FORMAT_SAMPLES[static_cast<size_t>(state.range(0))];
+  const std::string str(entry.sample);
+  const DateTimeFormat format(entry.format);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(DateTime::strptime(str, format));
+  }
+  state.SetLabel(entry.format);
+}
+BENCHMARK(BM_StrptimeCompiled)->DenseRange(0, FORMAT_SAMPLES.size() - 1);
+
+void BM_Strftime(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  size_t i = 0;
+  for (auto _ : state) {
+    const DateTime date(timestamps[i++ % SAMPLE_COUNT]);
+    benchmark::DoNotOptimize(date.strftime("%Y-%m-%d %H:%M:%S"));
+  }
+}
+BENCHMARK(BM_Strftime);
+
+void BM_StrftimeMilliseconds(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  size_t i = 0;
+  for (auto _ : state) {
+    const DateTime date(timestamps[i++ % SAMPLE_COUNT]);
+    benchmark::DoNotOptimize(date.strftime_w_milliseconds("%Y-%m-%d %H:%M:%S"));
+  }
+}
+BENCHMARK(BM_StrftimeMilliseconds);
+
+void BM_ToIsoString(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  size_t i = 0;
+  for (auto _ : state) {
+    const DateTime date(timestamps[i++ % SAMPLE_COUNT]);
+    benchmark::DoNotOptimize(date.to_iso_string());
+  }
+}
+BENCHMARK(BM_ToIsoString);
+
+void BM_ToIsoStringMilliseconds(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  size_t i = 0;
+  for (auto _ : state) {
+    const DateTime date(timestamps[i++ % SAMPLE_COUNT]);
+    benchmark::DoNotOptimize(date.to_iso_string_msec());
+  }
+}
+BENCHMARK(BM_ToIsoStringMilliseconds);
+
+template <auto Getter>
+void BM_Getter(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  size_t i = 0;
+  for (auto _ : state) {
+    const DateTime date(timestamps[i++ % SAMPLE_COUNT]);
+    benchmark::DoNotOptimize((date.*Getter)());
+  }
+}
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::year);
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::month);
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::day);
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::hour);
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::minute);
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::second);
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::millisecond);
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::julianDayNumber);
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::julianDay);
+BENCHMARK_TEMPLATE(BM_Getter, &DateTime::julianCentury);
+
+// The same getters for dates inside the window of the calendar table, to
+// compare builds with and without FDATE_ENABLE_CALENDAR_TABLE
+template <auto Getter>
+void BM_GetterInWindow(benchmark::State& state) {
+  const auto& timestamps = sample_window_timestamps();
+  size_t i = 0;
+  for (auto _ : state) {
+    const DateTime date(timestamps[i++ % SAMPLE_COUNT]);
+    benchmark::DoNotOptimize((date.*Getter)());
+  }
+}
+BENCHMARK_TEMPLATE(BM_GetterInWindow, &DateTime::year);
+BENCHMARK_TEMPLATE(BM_GetterInWindow, &DateTime::month);
+BENCHMARK_TEMPLATE(BM_GetterInWindow, &DateTime::day);
+BENCHMARK_TEMPLATE(BM_GetterInWindow, &DateTime::julianDayNumber);
+
+// Day to civil date conversion with the date library and with the tables,
+// independent of the build option
+void BM_CivilFromDaysGeneral(benchmark::State& state) {
+  const auto& timestamps = sample_window_timestamps();
+  size_t i = 0;
+  for (auto _ : state) {
+    const auto days = date::floor<date::days>(
+        date::sys_time<std::chrono::milliseconds>(
+            std::chrono::milliseconds(timestamps[i++ % SAMPLE_COUNT])));
+    const date::year_month_day ymd{days};
+    benchmark::DoNotOptimize(ymd);
+  }
+}
+BENCHMARK(BM_CivilFromDaysGeneral);
+
+void BM_CivilFromDaysTable(benchmark::State& state) {
+  const auto& timestamps = sample_window_timestamps();
+  size_t i = 0;
+  for (auto _ : state) {
+    const auto days = date::floor<date::days>(
+                          date::sys_time<std::chrono::milliseconds>(
+                              std::chrono::milliseconds(
+                                  timestamps[i++ % SAMPLE_COUNT])))
+                          .time_since_epoch()
+                          .count();
+    int year = 0;
+    unsigned month = 0;
+    unsigned day = 0;
+    CalendarTable::to_civil(days, year, month, day);
+    benchmark::DoNotOptimize(year);
+    benchmark::DoNotOptimize(month);
+    benchmark::DoNotOptimize(day);
+  }
+}
+BENCHMARK(BM_CivilFromDaysTable);
+
+void BM_TimeDeltaToString(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  size_t i = 0;
+  for (auto _ : state) {
+    const auto span = TimeDelta::fromMilliseconds(
+        timestamps[i++ % SAMPLE_COUNT] - timestamps[0]);
+    benchmark::DoNotOptimize(span.toString());
+  }
+}
+BENCHMARK(BM_TimeDeltaToString);
+
+//=============================================================================
+// C interface called from C++
+//
+// Each iteration makes BOUNDARY_CALLS calls, the same as the matching
+// Fortran driver benchmark below, so the two report comparable item rates.
+//=============================================================================
+
+void BM_CStrptime(benchmark::State& state) {
+  static constexpr char str[] = "2024-03-15 14:30:25";
+  static constexpr char format[] = "%Y-%m-%d %H:%M:%S";
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int i = 0; i < BOUNDARY_CALLS; ++i) {
+      sum += f_datetime_strptime(str, format, sizeof(str) - 1,
+                                 sizeof(format) - 1);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_CStrptime);
+
+void BM_CStrftime(benchmark::State& state) {
+  static constexpr char format[] = "%Y-%m-%d %H:%M:%S";
+  const auto& timestamps = sample_timestamps();
+  std::array<char, 65> buffer{};
+  for (auto _ : state) {
+    for (int i = 0; i < BOUNDARY_CALLS; ++i) {
+      f_datetime_strftime(timestamps[static_cast<size_t>(i) % SAMPLE_COUNT],
+                          format, buffer.data(), sizeof(format) - 1,
+                          static_cast<int>(buffer.size()));
+      benchmark::DoNotOptimize(buffer.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_CStrftime);
+
+void BM_CToIsoString(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  std::array<char, 65> buffer{};
+  for (auto _ : state) {
+    for (int i = 0; i < BOUNDARY_CALLS; ++i) {
+      f_datetime_to_iso_string(
+          timestamps[static_cast<size_t>(i) % SAMPLE_COUNT], buffer.data(),
+          static_cast<int>(buffer.size()));
+      benchmark::DoNotOptimize(buffer.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_CToIsoString);
+
+void BM_CYear(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  for (auto _ : state) {
+    int64_t sum = 0;
+    for (int i = 0; i < BOUNDARY_CALLS; ++i) {
+      sum += f_datetime_get_year(
+          timestamps[static_cast<size_t>(i) % SAMPLE_COUNT]);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_CYear);
+
+void BM_CJulianDay(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  for (auto _ : state) {
+    double sum = 0.0;
+    for (int i = 0; i < BOUNDARY_CALLS; ++i) {
+      sum += f_datetime_get_julian_day(
+          timestamps[static_cast<size_t>(i) % SAMPLE_COUNT]);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_CJulianDay);
+
+void BM_CTimeDeltaToString(benchmark::State& state) {
+  std::array<char, 65> buffer{};
+  for (auto _ : state) {
+    for (int i = 0; i < BOUNDARY_CALLS; ++i) {
+      f_timedelta_to_string((i % TIMEDELTA_COUNT) * TIMEDELTA_STEP_MS,
+                            buffer.data(), static_cast<int>(buffer.size()));
+      benchmark::DoNotOptimize(buffer.data());
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_CTimeDeltaToString);
+
+void BM_CStrptimeArray(benchmark::State& state) {
+  static constexpr char format[] = "%Y-%m-%d %H:%M:%S";
+  constexpr int width = 19;
+  std::string strs;
+  for (int i = 0; i < BOUNDARY_CALLS; ++i) {
+    strs += "2024-03-15 14:30:25";
+  }
+  std::vector<int64_t> dt_ms(BOUNDARY_CALLS);
+  auto valid = std::make_unique<bool[]>(BOUNDARY_CALLS);
+  for (auto _ : state) {
+    f_datetime_strptime_array(strs.data(), width, BOUNDARY_CALLS, format,
+                              sizeof(format) - 1, dt_ms.data(),
+                              valid.get());
+    benchmark::DoNotOptimize(dt_ms.data());
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_CStrptimeArray);
+
+void BM_CGetFieldsArray(benchmark::State& state) {
+  const auto& timestamps = sample_timestamps();
+  const auto n = static_cast<int>(SAMPLE_COUNT);
+  std::vector<int> year(SAMPLE_COUNT), month(SAMPLE_COUNT), day(SAMPLE_COUNT),
+      hour(SAMPLE_COUNT), minute(SAMPLE_COUNT), second(SAMPLE_COUNT),
+      millisecond(SAMPLE_COUNT);
+  for (auto _ : state) {
+    f_datetime_get_fields_array(timestamps.data(), n, year.data(),
+                                month.data(), day.data(), hour.data(),
+                                minute.data(), second.data(),
+                                millisecond.data());
+    benchmark::DoNotOptimize(year.data());
+  }
+  state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_CGetFieldsArray);
+
+//=============================================================================
+// Fortran interface
+//
+// The driver loops BOUNDARY_CALLS times over the type bound procedures of
+// mod_datetime, so the difference from the BM_C* benchmarks above is the cost
+// of the Fortran wrappers and the string conversions they make.
+//=============================================================================
+
+void BM_FortranStrptime(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fdate_bench_ftn_strptime(BOUNDARY_CALLS));
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_FortranStrptime);
+
+void BM_FortranStrftime(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fdate_bench_ftn_strftime(BOUNDARY_CALLS));
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_FortranStrftime);
+
+void BM_FortranToIsoString(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fdate_bench_ftn_to_iso_string(BOUNDARY_CALLS));
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_FortranToIsoString);
+
+void BM_FortranYear(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fdate_bench_ftn_year(BOUNDARY_CALLS));
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_FortranYear);
+
+void BM_FortranJulianDay(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(fdate_bench_ftn_julian_day(BOUNDARY_CALLS));
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_FortranJulianDay);
+
+void BM_FortranTimeDeltaToString(benchmark::State& state) {
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        fdate_bench_ftn_timedelta_to_string(BOUNDARY_CALLS));
+  }
+  state.SetItemsProcessed(state.iterations() * BOUNDARY_CALLS);
+}
+BENCHMARK(BM_FortranTimeDeltaToString);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -37,6 +37,34 @@ macro(fdate_setup_dependencies)
 
   endif()
 
+  # ############################################################################
+  # Google Benchmark
+  # ############################################################################
+  if(FDATE_ENABLE_BENCHMARKS)
+
+    # Prefer an installed copy and only download when none is found
+    find_package(benchmark QUIET)
+    if(NOT benchmark_FOUND)
+      mark_as_advanced_wildcard("CPM_")
+
+      cpmaddpackage(
+        NAME
+        benchmark
+        GITHUB_REPOSITORY
+        google/benchmark
+        VERSION
+        1.8.3
+        OPTIONS
+        "BENCHMARK_ENABLE_TESTING OFF"
+        "BENCHMARK_ENABLE_INSTALL OFF"
+        "BENCHMARK_ENABLE_GTEST_TESTS OFF"
+        EXCLUDE_FROM_ALL
+        SYSTEM)
+      mark_as_advanced_wildcard("BENCHMARK_")
+    endif()
+
+  endif()
+
   # Mark the FetchContent variables as advanced
   mark_as_advanced_wildcard("FETCHCONTENT_")
   mark_as_advanced("pugixml_DIR")
@@ -0,0 +1,252 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <queue>
+#include <utility>
+#include <vector>
+
+#include "CalendarMath.hpp"
+#include "DateTimeCore.hpp"
+#include "TimeDelta.hpp"
+
+/**
+ * @brief A set of recurring alarms ordered by the time they next fire
+ *
+ * A model with many output streams checks each of them every step. The
+ * AlarmSet class holds the streams as alarms and keeps their next fire times
+ * in a min-heap, so checking whether any alarm is due is a single comparison
+ * and taking the k alarms that fired is O(k log n).
+ *
+ * Two kinds of alarm are supported:
+ * - Interval alarms fire at a first time and then every fixed interval.
+ * - Monthly alarms fire at a first time and then on the same day of the month
+ *   and time of day every given number of months, such as at midnight on the
+ *   first of every month. Days past the end of a shorter month fire on the
+ *   last day of that month.
+ *
+ * An alarm whose fire times are passed by a single step fires once and is
+ * moved to its first fire time after the current time.
+ */
+class AlarmSet {
+ public:
+  /** @brief Kinds of alarm */
+  enum class e_AlarmKind : uint8_t { INTERVAL, MONTHLY };
+
+  /** @brief Identifier returned when an alarm could not be added */
+  static constexpr int INVALID_ALARM = -1;
+
+  /**
+   * @brief Adds an alarm that fires every fixed interval
+   *
+   * @param first The first time the alarm fires
+   * @param interval The interval between fires, which must be positive
+   * @return int The identifier of the alarm, or INVALID_ALARM if the interval
+   * is not positive
+   */
+  auto add_interval(const DateTime& first, const TimeDelta& interval) -> int {
+    if (interval.totalMilliseconds() <= 0) {
+      return INVALID_ALARM;
+    }
+    s_Alarm alarm{};
+    alarm.kind = e_AlarmKind::INTERVAL;
+    alarm.first = first.timestamp();
+    alarm.interval = interval.totalMilliseconds();
+    return add(alarm);
+  }
+
+  /**
+   * @brief Adds an alarm that fires every given number of months
+   *
+   * @param first The first time the alarm fires, which sets the day of the
+   * month and the time of day of the later fires
+   * @param months The number of months between fires, which must be positive
+   * @return int The identifier of the alarm, or INVALID_ALARM if the number of
+   * months is not positive
+   */
+  auto add_monthly(const DateTime& first, const int months = 1) -> int {
+    if (months <= 0) {
+      return INVALID_ALARM;
+    }
+    const auto fields = first.to_fields();
+    s_Alarm alarm{};
+    alarm.kind = e_AlarmKind::MONTHLY;
+    alarm.first = first.timestamp();
+    alarm.interval = months;
+    alarm.first_month = int64_t{fields.year} * 12 + fields.month - 1;
+    alarm.day = fields.day;
+    alarm.time_of_day = static_cast<int64_t>(fields.hour) * 3600000 +
+                        static_cast<int64_t>(fields.minute) * 60000 +
+                        static_cast<int64_t>(fields.second) * 1000 +
+                        static_cast<int64_t>(fields.millisecond);
+    return add(alarm);
+  }
+
+  /** @brief Gets the number of alarms */
+  [[nodiscard]] auto size() const noexcept -> size_t { return m_alarms.size(); }
+
+  /** @brief Checks if the set holds no alarms */
+  [[nodiscard]] auto empty() const noexcept -> bool { return m_alarms.empty(); }
+
+  /**
+   * @brief Gets the time an alarm fires next
+   *
+   * @param id The identifier of the alarm
+   * @return DateTime The next fire time, invalid if there is no such alarm
+   */
+  [[nodiscard]] auto next_time(const int id) const noexcept -> DateTime {
+    if (id < 0 || static_cast<size_t>(id) >= m_alarms.size()) {
+      return DateTime(DateTime::INVALID_TIMESTAMP);
+    }
+    return DateTime(m_alarms[static_cast<size_t>(id)].next);
+  }
+
+  /**
+   * @brief Gets the time the next alarm of the set fires
+   *
+   * @return DateTime The earliest next fire time, invalid if the set is empty
+   */
+  [[nodiscard]] auto next_time() const noexcept -> DateTime {
+    if (m_heap.empty()) {
+      return DateTime(DateTime::INVALID_TIMESTAMP);
+    }
+    return DateTime(m_heap.top().first);
+  }
+
+  /**
+   * @brief Checks if any alarm fires at or before a time
+   *
+   * @param now The current time
+   * @return bool True if pop() would return an alarm
+   */
+  [[nodiscard]] auto due(const DateTime& now) const noexcept -> bool {
+    return !m_heap.empty() && m_heap.top().first <= now.timestamp();
+  }
+
+  /**
+   * @brief Takes the next alarm that fires at or before a time
+   *
+   * The alarm is rescheduled to its first fire time after now. Alarms due at
+   * the same time are returned in the order they were added.
+   *
+   * @param now The current time
+   * @return int The identifier of the alarm, or INVALID_ALARM if no alarm is
+   * due
+   */
+  auto pop(const DateTime& now) -> int {
+    if (!due(now)) {
+      return INVALID_ALARM;
+    }
+    const auto id = m_heap.top().second;
+    m_heap.pop();
+
+    auto& alarm = m_alarms[static_cast<size_t>(id)];
+    reschedule(alarm, now.timestamp());
+    m_heap.emplace(alarm.next, id);
+    return id;
+  }
+
+  /**
+   * @brief Takes every alarm that fires at or before a time
+   *
+   * @param now The current time
+   * @param fired Receives the identifiers of the alarms in the order they
+   * fire, after any identifiers it already holds
+   * @return size_t The number of alarms that fired
+   */
+  auto poll(const DateTime& now, std::vector<int>& fired) -> size_t {
+    size_t count = 0;
+    for (auto id = pop(now); id != INVALID_ALARM; id = pop(now)) {
+      fired.push_back(id);
+      ++count;
+    }
+    return count;
+  }
+
+ private:
+  /** @brief Definition and schedule of one alarm */
+  struct s_Alarm {
+    e_AlarmKind kind;
+    int64_t first;        ///< First fire time in milliseconds since epoch
+    int64_t interval;     ///< Interval in milliseconds or months
+    int64_t first_month;  ///< Months since year 0 of the first fire (MONTHLY)
+    unsigned day;         ///< Day of the month of the fires (MONTHLY)
+    int64_t time_of_day;  ///< Milliseconds since midnight of the fires
+    int64_t count;        ///< Number of fire times passed
+    int64_t next;         ///< Next fire time in milliseconds since epoch
+  };
+
+  /** @brief Heap entry of a next fire time and an alarm identifier */
+  using t_entry = std::pair<int64_t, int>;
+
+  /**
+   * @brief Stores an alarm and schedules its first fire
+   */
+  auto add(s_Alarm alarm) -> int {
+    const auto id = static_cast<int>(m_alarms.size());
+    alarm.count = 0;
+    alarm.next = alarm.first;
+    m_alarms.push_back(alarm);
+    m_heap.emplace(alarm.next, id);
+    return id;
+  }
+
+  /**
+   * @brief Gets a fire time of a monthly alarm
+   *
+   * @param alarm The alarm
+   * @param count The number of fires before this one
+   * @return int64_t The fire time in milliseconds since epoch
+   */
+  static auto monthly_time(const s_Alarm& alarm, const int64_t count) noexcept
+      -> int64_t {
+    const auto month_index = alarm.first_month + count * alarm.interval;
+    const auto years =
+        month_index >= 0 ? month_index / 12 : (month_index - 11) / 12;
+    const auto year = static_cast<int>(years);
+    const auto month = static_cast<unsigned>(month_index - years * 12) + 1;
+    const auto day =
+        std::min(alarm.day, CalendarMath::days_in_month(year, month));
+    return int64_t{CalendarMath::days_from_civil(year, month, day)} *
+               CalendarMath::MILLISECONDS_PER_DAY +
+           alarm.time_of_day;
+  }
+
+  /**
+   * @brief Moves an alarm to its first fire time after a time
+   */
+  static void reschedule(s_Alarm& alarm, const int64_t now) noexcept {
+    if (alarm.kind == e_AlarmKind::INTERVAL) {
+      const auto passed = (now - alarm.next) / alarm.interval + 1;
+      alarm.count += passed;
+      alarm.next += passed * alarm.interval;
+      return;
+    }
+    do {
+      ++alarm.count;
+      alarm.next = monthly_time(alarm, alarm.count);
+    } while (alarm.next <= now);
+  }
+
+  std::vector<s_Alarm> m_alarms;
+  std::priority_queue<t_entry, std::vector<t_entry>, std::greater<>> m_heap;
+};
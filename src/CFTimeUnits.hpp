@@ -0,0 +1,528 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+#include "CalendarKernels.hpp"
+#include "CalendarMath.hpp"
+#include "DateTime.hpp"
+
+/**
+ * @brief A CF convention "units since reference date" time unit
+ *
+ * NetCDF files following the CF conventions store time as offsets from a
+ * reference date, described by a units attribute such as
+ * "hours since 1990-01-01 00:00:00". The CFTimeUnits class parses the units
+ * attribute once into a unit length and an epoch, and then converts whole
+ * arrays of offsets to and from millisecond timestamps.
+ *
+ * The units milliseconds, seconds, minutes, hours, days and weeks are accepted
+ * along with their common abbreviations (ms, s, sec, min, h, hr, d, ...).
+ * Months and years are rejected because their length is not fixed. The
+ * reference date is Y-M-D, optionally followed by a time H:M[:S[.fff]]
+ * separated by a space or 'T', and a time zone of Z, UTC, GMT or a numeric
+ * offset such as +05:30.
+ *
+ * Only the standard (proleptic Gregorian) calendar is supported.
+ */
+class CFTimeUnits {
+ public:
+  /**
+   * @brief Constructs an invalid unit, see valid()
+   */
+  constexpr CFTimeUnits() noexcept = default;
+
+  /**
+   * @brief Parses a CF units attribute
+   *
+   * @param units The units attribute, e.g. "days since 2000-01-01"
+   * @note Check valid() to find out if the attribute was understood
+   */
+  explicit CFTimeUnits(const std::string& units) noexcept
+      : CFTimeUnits(units.data(), units.size()) {}
+
+  /**
+   * @brief Parses a CF units attribute
+   *
+   * @param units The units attribute, need not be null terminated
+   * @param length The length of the attribute
+   * @note Check valid() to find out if the attribute was understood
+   */
+  CFTimeUnits(const char* units, const size_t length) noexcept {
+    s_Reader reader{units, length, 0};
+    int64_t unit_ms = 0;
+    int64_t epoch_ms = 0;
+    if (parse(reader, unit_ms, epoch_ms)) {
+      m_unit_ms = unit_ms;
+      m_epoch_ms = epoch_ms;
+    }
+  }
+
+  /**
+   * @brief Constructs a unit from its parts
+   *
+   * @param unit_milliseconds Length of one unit in milliseconds
+   * @param epoch The reference date
+   */
+  constexpr CFTimeUnits(const int64_t unit_milliseconds,
+                        const DateTime& epoch) noexcept
+      : m_unit_ms(unit_milliseconds), m_epoch_ms(epoch.timestamp()) {}
+
+  /**
+   * @brief Checks if the units were parsed successfully
+   * @return bool True if the unit can be used for conversions
+   */
+  [[nodiscard]] constexpr auto valid() const noexcept -> bool {
+    return m_unit_ms > 0;
+  }
+
+  /**
+   * @brief Gets the length of one unit
+   * @return int64_t Milliseconds per unit, 0 if invalid
+   */
+  [[nodiscard]] constexpr auto unit_milliseconds() const noexcept -> int64_t {
+    return m_unit_ms;
+  }
+
+  /**
+   * @brief Gets the reference date
+   * @return DateTime The epoch the offsets are counted from
+   */
+  [[nodiscard]] constexpr auto epoch() const noexcept -> DateTime {
+    return DateTime(m_epoch_ms);
+  }
+
+  /**
+   * @brief Converts offsets to timestamps
+   *
+   * Offsets are rounded to the nearest millisecond. Values that are not
+   * finite or whose timestamp would overflow, such as NetCDF fill values,
+   * give DateTime::INVALID_TIMESTAMP, as does every value if the units are
+   * invalid.
+   *
+   * @param values Array of count offsets in this unit
+   * @param count Number of offsets
+   * @param timestamps Output array of count timestamps in milliseconds since
+   * epoch
+   */
+  void to_timestamps(const double* values, const size_t count,
+                     int64_t* timestamps) const noexcept {
+    if (!valid()) {
+      std::fill_n(timestamps, count, DateTime::INVALID_TIMESTAMP);
+      return;
+    }
+    const auto unit = static_cast<double>(m_unit_ms);
+    const auto epoch = m_epoch_ms;
+    FDATE_SIMD_LOOP
+    for (size_t i = 0; i < count; ++i) {
+      const double offset = std::floor(values[i] * unit + 0.5);
+      const bool representable =
+          offset > -OFFSET_LIMIT_MS && offset < OFFSET_LIMIT_MS;
+      timestamps[i] = representable ? epoch + static_cast<int64_t>(offset)
+                                    : DateTime::INVALID_TIMESTAMP;
+    }
+  }
+
+  /**
+   * @brief Converts offsets to timestamps
+   *
+   * Offsets whose timestamp would overflow, such as NetCDF fill values, give
+   * DateTime::INVALID_TIMESTAMP, as does every value if the units are invalid.
+   *
+   * @param values Array of count offsets in this unit
+   * @param count Number of offsets
+   * @param timestamps Output array of count timestamps in milliseconds since
+   * epoch
+   */
+  void to_timestamps(const int32_t* values, const size_t count,
+                     int64_t* timestamps) const noexcept {
+    if (!valid()) {
+      std::fill_n(timestamps, count, DateTime::INVALID_TIMESTAMP);
+      return;
+    }
+    const auto unit = m_unit_ms;
+    const auto epoch = m_epoch_ms;
+    const auto limit = offset_limit();
+    FDATE_SIMD_LOOP
+    for (size_t i = 0; i < count; ++i) {
+      const int64_t value = int64_t{values[i]};
+      const bool representable = value >= -limit && value <= limit;
+      const int64_t timestamp = epoch + (representable ? value : 0) * unit;
+      timestamps[i] = representable ? timestamp : DateTime::INVALID_TIMESTAMP;
+    }
+  }
+
+  /**
+   * @brief Converts offsets to timestamps
+   *
+   * Offsets whose timestamp would overflow, such as NetCDF fill values, give
+   * DateTime::INVALID_TIMESTAMP, as does every value if the units are invalid.
+   *
+   * @param values Array of count offsets in this unit
+   * @param count Number of offsets
+   * @param timestamps Output array of count timestamps in milliseconds since
+   * epoch
+   */
+  void to_timestamps(const int64_t* values, const size_t count,
+                     int64_t* timestamps) const noexcept {
+    if (!valid()) {
+      std::fill_n(timestamps, count, DateTime::INVALID_TIMESTAMP);
+      return;
+    }
+    const auto unit = m_unit_ms;
+    const auto epoch = m_epoch_ms;
+    const auto limit = offset_limit();
+    FDATE_SIMD_LOOP
+    for (size_t i = 0; i < count; ++i) {
+      const int64_t value = values[i];
+      const bool representable = value >= -limit && value <= limit;
+      const int64_t timestamp = epoch + (representable ? value : 0) * unit;
+      timestamps[i] = representable ? timestamp : DateTime::INVALID_TIMESTAMP;
+    }
+  }
+
+  /**
+   * @brief Converts timestamps to offsets
+   *
+   * DateTime::INVALID_TIMESTAMP gives NaN, as does every timestamp if the
+   * units are invalid.
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param values Output array of count offsets in this unit
+   */
+  void from_timestamps(const int64_t* timestamps, const size_t count,
+                       double* values) const noexcept {
+    if (!valid()) {
+      std::fill_n(values, count, std::numeric_limits<double>::quiet_NaN());
+      return;
+    }
+    const auto unit = static_cast<double>(m_unit_ms);
+    const auto epoch = m_epoch_ms;
+    FDATE_SIMD_LOOP
+    for (size_t i = 0; i < count; ++i) {
+      const auto offset = (static_cast<double>(timestamps[i]) -
+                           static_cast<double>(epoch)) /
+                          unit;
+      values[i] = timestamps[i] == DateTime::INVALID_TIMESTAMP
+                      ? std::numeric_limits<double>::quiet_NaN()
+                      : offset;
+    }
+  }
+
+  /**
+   * @brief Converts timestamps to whole offsets
+   *
+   * Offsets are rounded down to a whole number of units.
+   * DateTime::INVALID_TIMESTAMP gives the lowest int64_t value, as does every
+   * timestamp if the units are invalid.
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param values Output array of count offsets in this unit
+   */
+  void from_timestamps(const int64_t* timestamps, const size_t count,
+                       int64_t* values) const noexcept {
+    if (!valid()) {
+      std::fill_n(values, count, std::numeric_limits<int64_t>::min());
+      return;
+    }
+    const auto unit = m_unit_ms;
+    const auto epoch = m_epoch_ms;
+    FDATE_SIMD_LOOP
+    for (size_t i = 0; i < count; ++i) {
+      const bool invalid = timestamps[i] == DateTime::INVALID_TIMESTAMP;
+      const int64_t difference = invalid ? 0 : timestamps[i] - epoch;
+      const int64_t q = difference / unit;
+      const int64_t floor_q = (difference % unit < 0) ? q - 1 : q;
+      values[i] = invalid ? std::numeric_limits<int64_t>::min() : floor_q;
+    }
+  }
+
+ private:
+  /**
+   * @brief Cursor over the units attribute
+   */
+  struct s_Reader {
+    const char* str;
+    size_t size;
+    size_t pos;
+
+    [[nodiscard]] constexpr auto done() const noexcept -> bool {
+      return pos >= size;
+    }
+
+    [[nodiscard]] constexpr auto peek() const noexcept -> char {
+      return pos < size ? str[pos] : '\0';
+    }
+
+    constexpr auto skip_spaces() noexcept -> size_t {
+      const size_t start = pos;
+      while (pos < size && (str[pos] == ' ' || str[pos] == '\t')) {
+        ++pos;
+      }
+      return pos - start;
+    }
+
+    constexpr auto accept(const char c) noexcept -> bool {
+      if (peek() == c) {
+        ++pos;
+        return true;
+      }
+      return false;
+    }
+
+    /**
+     * @brief Reads 1 to max_digits digits
+     */
+    constexpr auto number(const size_t max_digits, int& value) noexcept
+        -> bool {
+      size_t n = 0;
+      value = 0;
+      while (n < max_digits && pos < size && is_digit(str[pos])) {
+        value = value * 10 + (str[pos] - '0');
+        ++pos;
+        ++n;
+      }
+      return n > 0;
+    }
+
+    /**
+     * @brief Reads a word of letters, lower cased
+     */
+    auto word() -> std::string {
+      std::string result;
+      while (pos < size && is_alpha(str[pos])) {
+        result.push_back(to_lower(str[pos]));
+        ++pos;
+      }
+      return result;
+    }
+  };
+
+  /**
+   * @brief A unit name and its length
+   */
+  struct s_Unit {
+    const char* name;
+    int64_t milliseconds;
+  };
+
+  /**
+   * @brief Gets the largest whole offset whose timestamp fits in an int64_t
+   *
+   * @return int64_t The limit on the magnitude of an offset, 0 if the units
+   * are not valid
+   */
+  [[nodiscard]] constexpr auto offset_limit() const noexcept -> int64_t {
+    if (!valid()) {
+      return 0;
+    }
+    constexpr auto max = static_cast<uint64_t>(
+        std::numeric_limits<int64_t>::max());
+    const auto epoch = static_cast<uint64_t>(m_epoch_ms);
+    const uint64_t epoch_magnitude = m_epoch_ms < 0 ? 0 - epoch : epoch;
+    if (epoch_magnitude > max) {
+      return 0;
+    }
+    return static_cast<int64_t>((max - epoch_magnitude) /
+                                static_cast<uint64_t>(m_unit_ms));
+  }
+
+  /** @brief Offsets beyond this many milliseconds are not representable */
+  static constexpr double OFFSET_LIMIT_MS = 9.0e18;
+
+  /** @brief Names accepted for each unit */
+  static constexpr std::array<s_Unit, 26> UNITS = {{
+      {"milliseconds", 1},     {"millisecond", 1},     {"msecs", 1},
+      {"msec", 1},             {"ms", 1},              {"seconds", 1000},
+      {"second", 1000},        {"secs", 1000},         {"sec", 1000},
+      {"s", 1000},             {"minutes", 60000},     {"minute", 60000},
+      {"mins", 60000},         {"min", 60000},         {"hours", 3600000},
+      {"hour", 3600000},       {"hrs", 3600000},       {"hr", 3600000},
+      {"h", 3600000},          {"days", 86400000},     {"day", 86400000},
+      {"d", 86400000},         {"weeks", 604800000},   {"week", 604800000},
+      {"wks", 604800000},      {"wk", 604800000},
+  }};
+
+  static constexpr auto is_digit(const char c) noexcept -> bool {
+    return c >= '0' && c <= '9';
+  }
+
+  static constexpr auto is_alpha(const char c) noexcept -> bool {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+  }
+
+  static constexpr auto to_lower(const char c) noexcept -> char {
+    return (c >= 'A' && c <= 'Z') ? static_cast<char>(c - 'A' + 'a') : c;
+  }
+
+  /**
+   * @brief Parses "<unit> since <date>[ <time>][ <zone>]"
+   *
+   * @param reader Cursor over the attribute
+   * @param unit_ms Output length of the unit in milliseconds
+   * @param epoch_ms Output reference date in milliseconds since epoch
+   * @return bool True if the whole attribute was understood
+   */
+  static auto parse(s_Reader& reader, int64_t& unit_ms,
+                    int64_t& epoch_ms) noexcept -> bool {
+    try {
+      reader.skip_spaces();
+      const auto unit = reader.word();
+      unit_ms = 0;
+      for (const auto& candidate : UNITS) {
+        if (unit == candidate.name) {
+          unit_ms = candidate.milliseconds;
+          break;
+        }
+      }
+      if (unit_ms == 0 || reader.skip_spaces() == 0 ||
+          reader.word() != "since" || reader.skip_spaces() == 0) {
+        return false;
+      }
+    } catch (...) {
+      return false;
+    }
+
+    int year = 0;
+    int month = 0;
+    int day = 0;
+    if (!reader.number(4, year) || !reader.accept('-') ||
+        !reader.number(2, month) || !reader.accept('-') ||
+        !reader.number(2, day)) {
+      return false;
+    }
+
+    int hour = 0;
+    int minute = 0;
+    int second = 0;
+    int millisecond = 0;
+    const size_t before_time = reader.pos;
+    if (reader.accept('T') || reader.skip_spaces() > 0) {
+      if (reader.number(2, hour)) {
+        if (!reader.accept(':') || !reader.number(2, minute)) {
+          return false;
+        }
+        if (reader.accept(':')) {
+          if (!reader.number(2, second)) {
+            return false;
+          }
+          if (reader.accept('.')) {
+            int scale = 100;
+            while (is_digit(reader.peek())) {
+              millisecond += (reader.peek() - '0') * scale;
+              scale /= 10;
+              ++reader.pos;
+            }
+          }
+        }
+      } else {
+        reader.pos = before_time;
+      }
+    }
+
+    int offset_minutes = 0;
+    if (!parse_zone(reader, offset_minutes)) {
+      return false;
+    }
+    reader.skip_spaces();
+    if (!reader.done()) {
+      return false;
+    }
+
+    const date::year_month_day ymd{
+        date::year{year}, date::month{static_cast<unsigned>(month)},
+        date::day{static_cast<unsigned>(day)}};
+    if (!ymd.ok() || hour > DateTime::DATETIME_MAX_HOURS ||
+        minute > DateTime::DATETIME_MAX_MINUTES ||
+        second > DateTime::DATETIME_MAX_SECONDS) {
+      return false;
+    }
+
+    const auto days = CalendarMath::days_from_civil(
+        year, static_cast<unsigned>(month), static_cast<unsigned>(day));
+    epoch_ms = int64_t{days} * CalendarMath::MILLISECONDS_PER_DAY +
+               int64_t{hour} * 3600000 + int64_t{minute} * 60000 +
+               int64_t{second} * 1000 + millisecond -
+               int64_t{offset_minutes} * 60000;
+    return true;
+  }
+
+  /**
+   * @brief Parses an optional time zone
+   *
+   * @param reader Cursor positioned after the date or time
+   * @param offset_minutes Output offset from UTC in minutes
+   * @return bool False if a time zone is present but not understood
+   */
+  static auto parse_zone(s_Reader& reader, int& offset_minutes) noexcept
+      -> bool {
+    const size_t before_zone = reader.pos;
+    reader.skip_spaces();
+    offset_minutes = 0;
+
+    if (reader.accept('Z')) {
+      return true;
+    }
+
+    const char sign = reader.peek();
+    if (sign == '+' || sign == '-') {
+      ++reader.pos;
+      int hours = 0;
+      int minutes = 0;
+      const size_t start = reader.pos;
+      if (!reader.number(2, hours)) {
+        return false;
+      }
+      // Accepts +h, +hh, +hh:mm and +hhmm
+      if (reader.accept(':') || reader.pos - start == 2) {
+        if (is_digit(reader.peek()) && !reader.number(2, minutes)) {
+          return false;
+        }
+      }
+      if (hours > 23 || minutes > 59) {
+        return false;
+      }
+      offset_minutes = (sign == '-' ? -1 : 1) * (hours * 60 + minutes);
+      return true;
+    }
+
+    if (is_alpha(reader.peek())) {
+      try {
+        const auto zone = reader.word();
+        return zone == "utc" || zone == "gmt" || zone == "z";
+      } catch (...) {
+        return false;
+      }
+    }
+
+    reader.pos = before_zone;
+    return true;
+  }
+
+  int64_t m_unit_ms{0};
+  int64_t m_epoch_ms{0};
+};
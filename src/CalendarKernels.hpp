@@ -0,0 +1,532 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "CalendarMath.hpp"
+#include "DateTimeCore.hpp"
+
+// Loop annotation used by the bulk kernels. With FDATE_OPENMP_SIMD (set by the
+// build when -fopenmp-simd is available) or OpenMP the loops are explicitly
+// vectorized, otherwise the compiler is told the iterations are independent.
+// The instruction set (AVX2, AVX-512, NEON, ...) follows the compiler's target
+// architecture flags.
+#if defined(FDATE_OPENMP_SIMD) || defined(_OPENMP)
+#define FDATE_SIMD_LOOP _Pragma("omp simd")
+#elif defined(__clang__)
+#define FDATE_SIMD_LOOP _Pragma("clang loop vectorize(enable)")
+#elif defined(__GNUC__)
+#define FDATE_SIMD_LOOP _Pragma("GCC ivdep")
+#else
+#define FDATE_SIMD_LOOP
+#endif
+
+/**
+ * @brief Bulk conversions between timestamps and calendar fields
+ *
+ * The CalendarKernels class converts whole arrays of millisecond timestamps to
+ * and from separate year, month, day, hour, minute, second and millisecond
+ * arrays. The conversions use the branch-free 32-bit calendar arithmetic of
+ * CalendarMath so the compiler can vectorize them.
+ *
+ * The results are identical to the DateTime getters and to f_datetime_create
+ * for every input.
+ */
+class CalendarKernels {
+ public:
+  /** @brief Number of elements converted per block */
+  static constexpr size_t BLOCK_SIZE = 256;
+
+  /** @brief Direction in which round_to_interval() rounds */
+  enum class e_Rounding : uint8_t {
+    FLOOR,    ///< Down to the start of the interval
+    CEIL,     ///< Up to the end of the interval
+    NEAREST,  ///< To the nearest end, upwards from the middle
+  };
+
+  /**
+   * @brief Splits an array of timestamps into calendar and clock fields
+   *
+   * Any output may be null, in which case that field is not stored.
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param year Output array of count years
+   * @param month Output array of count months (1-12)
+   * @param day Output array of count days of month (1-31)
+   * @param hour Output array of count hours (0-23)
+   * @param minute Output array of count minutes (0-59)
+   * @param second Output array of count seconds (0-59)
+   * @param millisecond Output array of count milliseconds (0-999)
+   */
+  static void timestamps_to_fields(const int64_t* timestamps,
+                                   const size_t count, int* year, int* month,
+                                   int* day, int* hour, int* minute,
+                                   int* second, int* millisecond) noexcept {
+    std::array<int, BLOCK_SIZE> days{};
+    std::array<int, BLOCK_SIZE> time_of_day{};
+    std::array<uint8_t, BLOCK_SIZE> out_of_range{};
+    std::array<int, BLOCK_SIZE> discarded{};
+
+    // Fields that are not wanted are written to a scratch block so the loop
+    // below stays branch free
+    const auto output = [&discarded](int* field, const size_t start) {
+      return field != nullptr ? field + start : discarded.data();
+    };
+
+    for (size_t start = 0; start < count; start += BLOCK_SIZE) {
+      const size_t n = std::min(BLOCK_SIZE, count - start);
+      const int64_t* ts = timestamps + start;
+
+      // Days outside the range of the 32-bit calendar arithmetic are marked
+      // and redone below
+      split_days(ts, n, -DAY_LIMIT, DAY_LIMIT, days.data(), time_of_day.data(),
+                 out_of_range.data());
+
+      int* y_out = output(year, start);
+      int* mo_out = output(month, start);
+      int* d_out = output(day, start);
+      int* h_out = output(hour, start);
+      int* mi_out = output(minute, start);
+      int* s_out = output(second, start);
+      int* ms_out = output(millisecond, start);
+
+      FDATE_SIMD_LOOP
+      for (size_t i = 0; i < n; ++i) {
+        int y = 0;
+        unsigned m = 0;
+        unsigned d = 0;
+        CalendarMath::civil_from_days(days[i], y, m, d);
+        const auto tod = static_cast<unsigned>(time_of_day[i]);
+        y_out[i] = y;
+        mo_out[i] = static_cast<int>(m);
+        d_out[i] = static_cast<int>(d);
+        h_out[i] = static_cast<int>(tod / 3600000U);
+        mi_out[i] = static_cast<int>(tod / 60000U % 60U);
+        s_out[i] = static_cast<int>(tod / 1000U % 60U);
+        ms_out[i] = static_cast<int>(tod % 1000U);
+      }
+
+      // Far outside any practical range, fall back to the scalar getters
+      for (size_t i = 0; i < n; ++i) {
+        if (out_of_range[i] != 0) {
+          const auto fields = DateTime(ts[i]).to_fields();
+          y_out[i] = fields.year;
+          mo_out[i] = static_cast<int>(fields.month);
+          d_out[i] = static_cast<int>(fields.day);
+          h_out[i] = static_cast<int>(fields.hour);
+          mi_out[i] = static_cast<int>(fields.minute);
+          s_out[i] = static_cast<int>(fields.second);
+          ms_out[i] = static_cast<int>(fields.millisecond);
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Combines arrays of calendar and clock fields into timestamps
+   *
+   * Each element is validated in the same way as f_datetime_create. Elements
+   * with a field out of range are set to DateTime::INVALID_TIMESTAMP. Any of
+   * the clock fields may be null, in which case it is taken as zero.
+   *
+   * @param year Array of count years
+   * @param month Array of count months (1-12)
+   * @param day Array of count days of month (1-31)
+   * @param hour Array of count hours (0-23)
+   * @param minute Array of count minutes (0-59)
+   * @param second Array of count seconds (0-59)
+   * @param millisecond Array of count milliseconds (0-999)
+   * @param count Number of elements
+   * @param timestamps Output array of count timestamps in milliseconds since
+   * epoch
+   */
+  static void fields_to_timestamps(const int* year, const int* month,
+                                   const int* day, const int* hour,
+                                   const int* minute, const int* second,
+                                   const int* millisecond, const size_t count,
+                                   int64_t* timestamps) noexcept {
+    static constexpr std::array<int, BLOCK_SIZE> zeros{};
+
+    // Missing clock fields are read from a block of zeros so the loop below
+    // stays branch free
+    const auto input = [](const int* field, const size_t start) {
+      return field != nullptr ? field + start : zeros.data();
+    };
+
+    for (size_t start = 0; start < count; start += BLOCK_SIZE) {
+      const size_t n = std::min(BLOCK_SIZE, count - start);
+      const int* y_in = year + start;
+      const int* mo_in = month + start;
+      const int* d_in = day + start;
+      const int* h_in = input(hour, start);
+      const int* mi_in = input(minute, start);
+      const int* s_in = input(second, start);
+      const int* ms_in = input(millisecond, start);
+      int64_t* out = timestamps + start;
+
+      FDATE_SIMD_LOOP
+      for (size_t i = 0; i < n; ++i) {
+        const bool valid =
+            y_in[i] >= DateTime::DATETIME_MIN_YEAR &&
+            mo_in[i] >= DateTime::DATETIME_MIN_MONTH &&
+            mo_in[i] <= DateTime::DATETIME_MAX_MONTH &&
+            d_in[i] >= DateTime::DATETIME_MIN_DAYS &&
+            d_in[i] <= DateTime::DATETIME_MAX_DAYS &&
+            h_in[i] >= DateTime::DATETIME_MIN_HOURS &&
+            h_in[i] <= DateTime::DATETIME_MAX_HOURS &&
+            mi_in[i] >= DateTime::DATETIME_MIN_MINUTES &&
+            mi_in[i] <= DateTime::DATETIME_MAX_MINUTES &&
+            s_in[i] >= DateTime::DATETIME_MIN_SECONDS &&
+            s_in[i] <= DateTime::DATETIME_MAX_SECONDS &&
+            ms_in[i] >= DateTime::DATETIME_MIN_MILLISECONDS &&
+            ms_in[i] <= DateTime::DATETIME_MAX_MILLISECONDS;
+
+        const int days = CalendarMath::days_from_civil(
+            y_in[i], static_cast<unsigned>(mo_in[i]),
+            static_cast<unsigned>(d_in[i]));
+        const int64_t ms_of_day = int64_t{h_in[i]} * 3600000 +
+                                  int64_t{mi_in[i]} * 60000 +
+                                  int64_t{s_in[i]} * 1000 + ms_in[i];
+        const int64_t timestamp =
+            int64_t{days} * CalendarMath::MILLISECONDS_PER_DAY + ms_of_day;
+        out[i] = valid ? timestamp : DateTime::INVALID_TIMESTAMP;
+      }
+    }
+  }
+
+  /**
+   * @brief Computes the Julian Day of an array of timestamps
+   *
+   * The results are identical to DateTime::julianDay for every element.
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param julian_day Output array of count Julian Days
+   */
+  static void julian_days(const int64_t* timestamps, const size_t count,
+                          double* julian_day) noexcept {
+    std::array<int, BLOCK_SIZE> days{};
+    std::array<int, BLOCK_SIZE> time_of_day{};
+    std::array<uint8_t, BLOCK_SIZE> out_of_range{};
+
+    for (size_t start = 0; start < count; start += BLOCK_SIZE) {
+      const size_t n = std::min(BLOCK_SIZE, count - start);
+      const int64_t* ts = timestamps + start;
+      double* jd_out = julian_day + start;
+
+      // Outside this range DateTime computes the Julian Day Number from a
+      // wrapped date::year or with truncating division of a negative year,
+      // so those elements are redone below
+      split_days(ts, n, JULIAN_MIN_DAY, JULIAN_MAX_DAY, days.data(),
+                 time_of_day.data(), out_of_range.data());
+
+      // Same operations in the same order as CalendarMath::julian_day
+      FDATE_SIMD_LOOP
+      for (size_t i = 0; i < n; ++i) {
+        const auto tod = static_cast<unsigned>(time_of_day[i]);
+        const auto jdn = static_cast<double>(days[i] + UNIX_EPOCH_JDN);
+        const auto h = static_cast<double>(tod / 3600000U);
+        const auto min = static_cast<double>(tod / 60000U % 60U);
+        const auto s = static_cast<double>(tod / 1000U % 60U);
+        const auto ms = static_cast<double>(tod % 1000U);
+        const auto fractional_day =
+            (h - 12.0) / 24.0 + min / 1440.0 + s / 86400.0 + ms / 86400000.0;
+        jd_out[i] = jdn + fractional_day;
+      }
+
+      for (size_t i = 0; i < n; ++i) {
+        if (out_of_range[i] != 0) {
+          jd_out[i] = DateTime(ts[i]).julianDay();
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Computes the Julian Century of an array of timestamps
+   *
+   * The results are identical to DateTime::julianCentury for every element.
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param julian_century Output array of count Julian Centuries since J2000.0
+   */
+  static void julian_centuries(const int64_t* timestamps, const size_t count,
+                               double* julian_century) noexcept {
+    julian_days(timestamps, count, julian_century);
+
+    FDATE_SIMD_LOOP
+    for (size_t i = 0; i < count; ++i) {
+      julian_century[i] = CalendarMath::julian_century(julian_century[i]);
+    }
+  }
+
+  /**
+   * @brief Rounds an array of timestamps to whole numbers of an interval
+   *
+   * The results are identical to DateTime::floor, DateTime::ceil and
+   * DateTime::round for every element.
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param interval Length of the interval in milliseconds
+   * @param origin Time the intervals are counted from, in milliseconds since
+   * epoch
+   * @param rounding Direction of the rounding
+   * @param aligned Output array of count timestamps, INVALID_TIMESTAMP where
+   * the input is invalid or for all elements if interval is not positive
+   */
+  static void round_to_interval(const int64_t* timestamps, const size_t count,
+                                const int64_t interval, const int64_t origin,
+                                const e_Rounding rounding,
+                                int64_t* aligned) noexcept {
+    if (interval <= 0 || origin == DateTime::INVALID_TIMESTAMP) {
+      std::fill(aligned, aligned + count, DateTime::INVALID_TIMESTAMP);
+      return;
+    }
+
+    // Added to the offset before flooring: nothing, just under a whole
+    // interval, or the part of the interval below its upper half
+    int64_t shift = 0;
+    if (rounding == e_Rounding::CEIL) {
+      shift = interval - 1;
+    } else if (rounding == e_Rounding::NEAREST) {
+      shift = interval / 2;
+    }
+
+    FDATE_SIMD_LOOP
+    for (size_t i = 0; i < count; ++i) {
+      const bool valid = timestamps[i] != DateTime::INVALID_TIMESTAMP;
+      const int64_t offset = (valid ? timestamps[i] - origin : 0) + shift;
+      const int64_t q = offset / interval;
+      const int64_t r = offset % interval;
+      const int64_t result = origin + (r < 0 ? q - 1 : q) * interval;
+      aligned[i] = valid ? result : DateTime::INVALID_TIMESTAMP;
+    }
+  }
+
+  /**
+   * @brief Rounds an array of timestamps down to the start of calendar months
+   *
+   * The results are identical to DateTime::floor_to_month for every element.
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param months Number of months per bin, counted from January of year 0
+   * @param aligned Output array of count timestamps, INVALID_TIMESTAMP where
+   * the input is invalid or for all elements if months is 0
+   */
+  static void floor_to_months(const int64_t* timestamps, const size_t count,
+                              const unsigned months,
+                              int64_t* aligned) noexcept {
+    if (months == 0) {
+      std::fill(aligned, aligned + count, DateTime::INVALID_TIMESTAMP);
+      return;
+    }
+
+    std::array<int, BLOCK_SIZE> days{};
+    std::array<int, BLOCK_SIZE> time_of_day{};
+    std::array<uint8_t, BLOCK_SIZE> out_of_range{};
+    const auto step = static_cast<int>(months);
+
+    for (size_t start = 0; start < count; start += BLOCK_SIZE) {
+      const size_t n = std::min(BLOCK_SIZE, count - start);
+      const int64_t* ts = timestamps + start;
+      int64_t* out = aligned + start;
+
+      // The 32-bit month index is exact for the years of the fast path
+      split_days(ts, n, -YEAR_DAY_LIMIT, YEAR_DAY_LIMIT, days.data(),
+                 time_of_day.data(), out_of_range.data());
+
+      FDATE_SIMD_LOOP
+      for (size_t i = 0; i < n; ++i) {
+        int y = 0;
+        unsigned m = 0;
+        unsigned d = 0;
+        CalendarMath::civil_from_days(days[i], y, m, d);
+        const int index = y * 12 + static_cast<int>(m) - 1;
+        const int q = index / step;
+        const int bin = (index % step < 0 ? q - 1 : q) * step;
+        const int bin_year = (bin >= 0 ? bin : bin - 11) / 12;
+        const auto bin_month = static_cast<unsigned>(bin - bin_year * 12) + 1;
+        out[i] =
+            int64_t{CalendarMath::days_from_civil(bin_year, bin_month, 1)} *
+            CalendarMath::MILLISECONDS_PER_DAY;
+      }
+
+      for (size_t i = 0; i < n; ++i) {
+        if (out_of_range[i] != 0) {
+          out[i] = DateTime(ts[i]).floor_to_month(months).timestamp();
+        }
+      }
+    }
+  }
+
+  /**
+   * @brief Splits a sorted array of timestamps into bins of an interval
+   *
+   * A bin starts at every element whose rounded down time differs from that
+   * of the element before it, so a sorted array gives one bin per occupied
+   * interval and each bin is a contiguous run of elements.
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param interval Length of the interval in milliseconds
+   * @param origin Time the intervals are counted from, in milliseconds since
+   * epoch
+   * @param starts Output array of at least count indices of the first element
+   * of each bin
+   * @param bin_times Output array of at least count start times of each bin,
+   * as from round_to_interval with e_Rounding::FLOOR
+   * @return size_t Number of bins
+   *
+   * @tparam Index Integer type of the indices, wide enough for count
+   */
+  template <typename Index>
+  static auto bin_by_interval(const int64_t* timestamps, const size_t count,
+                              const int64_t interval, const int64_t origin,
+                              Index* starts, int64_t* bin_times) noexcept
+      -> size_t {
+    return bin(
+        timestamps, count,
+        [&](const int64_t* ts, const size_t n, int64_t* out) noexcept {
+          round_to_interval(ts, n, interval, origin, e_Rounding::FLOOR, out);
+        },
+        starts, bin_times);
+  }
+
+  /**
+   * @brief Splits a sorted array of timestamps into bins of calendar months
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param months Number of months per bin, counted from January of year 0
+   * @param starts Output array of at least count indices of the first element
+   * of each bin
+   * @param bin_times Output array of at least count start times of each bin,
+   * as from floor_to_months
+   * @return size_t Number of bins
+   *
+   * @see bin_by_interval
+   */
+  template <typename Index>
+  static auto bin_by_months(const int64_t* timestamps, const size_t count,
+                            const unsigned months, Index* starts,
+                            int64_t* bin_times) noexcept -> size_t {
+    return bin(
+        timestamps, count,
+        [&](const int64_t* ts, const size_t n, int64_t* out) noexcept {
+          floor_to_months(ts, n, months, out);
+        },
+        starts, bin_times);
+  }
+
+ private:
+  /**
+   * @brief Splits timestamps into days and milliseconds since midnight
+   *
+   * @param timestamps Array of n timestamps in milliseconds since epoch
+   * @param n Number of timestamps, at most BLOCK_SIZE
+   * @param min_day Smallest day count handled by the caller's fast path
+   * @param max_day Largest day count handled by the caller's fast path
+   * @param days Output days since 1970-01-01, 0 when out of range
+   * @param time_of_day Output milliseconds since midnight
+   * @param out_of_range Output flag set to 1 when the day is out of range
+   */
+  static void split_days(const int64_t* timestamps, const size_t n,
+                         const int64_t min_day, const int64_t max_day,
+                         int* days, int* time_of_day,
+                         uint8_t* out_of_range) noexcept {
+    FDATE_SIMD_LOOP
+    for (size_t i = 0; i < n; ++i) {
+      const int64_t q = timestamps[i] / CalendarMath::MILLISECONDS_PER_DAY;
+      const int64_t r = timestamps[i] % CalendarMath::MILLISECONDS_PER_DAY;
+      const int64_t floor_q = r < 0 ? q - 1 : q;
+      const int64_t floor_r =
+          r < 0 ? r + CalendarMath::MILLISECONDS_PER_DAY : r;
+      const bool in_range = floor_q >= min_day && floor_q <= max_day;
+      out_of_range[i] = in_range ? 0 : 1;
+      days[i] = in_range ? static_cast<int>(floor_q) : 0;
+      time_of_day[i] = static_cast<int>(floor_r);
+    }
+  }
+
+  /**
+   * @brief Rounds timestamps a block at a time and records where the result
+   * changes
+   *
+   * @param align Callable taking (const int64_t* timestamps, size_t n,
+   * int64_t* aligned) for at most BLOCK_SIZE elements
+   * @see bin_by_interval
+   */
+  template <typename Index, typename Align>
+  static auto bin(const int64_t* timestamps, const size_t count,
+                  const Align& align, Index* starts,
+                  int64_t* bin_times) noexcept -> size_t {
+    std::array<int64_t, BLOCK_SIZE> aligned{};
+    size_t n_bins = 0;
+
+    for (size_t start = 0; start < count; start += BLOCK_SIZE) {
+      const size_t n = std::min(BLOCK_SIZE, count - start);
+      align(timestamps + start, n, aligned.data());
+
+      for (size_t i = 0; i < n; ++i) {
+        if (n_bins == 0 || aligned[i] != bin_times[n_bins - 1]) {
+          starts[n_bins] = static_cast<Index>(start + i);
+          bin_times[n_bins] = aligned[i];
+          ++n_bins;
+        }
+      }
+    }
+    return n_bins;
+  }
+
+  /** @brief Julian Day Number of 1970-01-01 */
+  static constexpr int UNIX_EPOCH_JDN = 2440588;
+
+  /**
+   * @brief First day where the Julian Day Number is days + UNIX_EPOCH_JDN
+   * (-4799-01-01)
+   */
+  static constexpr int64_t JULIAN_MIN_DAY = -2472326;
+
+  /**
+   * @brief Last day where the Julian Day Number is days + UNIX_EPOCH_JDN
+   * (32767-12-31)
+   */
+  static constexpr int64_t JULIAN_MAX_DAY = 11248737;
+
+  /**
+   * @brief Largest day count handled by the 32-bit calendar arithmetic
+   *
+   * Well inside the range where days + 719468 fits in an int. The Hinnant
+   * algorithms give the same result in 32 and 64 bits within this range.
+   */
+  static constexpr int64_t DAY_LIMIT = int64_t{1} << 30;
+
+  /**
+   * @brief Largest day count whose month index fits the 32-bit arithmetic of
+   * floor_to_months (within years -32768 to 32767, as date::year)
+   */
+  static constexpr int64_t YEAR_DAY_LIMIT = 11000000;
+};
@@ -0,0 +1,265 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+
+/**
+ * @brief Marks the CalendarMath functions as callable from device code
+ *
+ * Under CUDA or HIP the functions are compiled for both the host and the
+ * device. Under OpenACC they are compiled as sequential routines, and under
+ * OpenMP the class is placed in a declare target region, so they can be
+ * called from inside offloaded loops without a return to the host.
+ */
+#if defined(__CUDACC__) || defined(__HIPCC__)
+#define FDATE_HOST_DEVICE __host__ __device__
+#elif defined(_OPENACC)
+#define FDATE_HOST_DEVICE _Pragma("acc routine seq")
+#else
+#define FDATE_HOST_DEVICE
+#endif
+
+#if defined(_OPENMP) && !defined(__CUDACC__) && !defined(__HIPCC__)
+#define FDATE_DECLARE_TARGET
+#endif
+
+#ifdef FDATE_DECLARE_TARGET
+#pragma omp declare target
+#endif
+
+/**
+ * @brief Self-contained proleptic Gregorian calendar arithmetic
+ *
+ * The CalendarMath class holds the conversions between day counts and civil
+ * dates used by DateTime and the bulk kernels. They are the civil-from-days
+ * and days-from-civil algorithms of the Howard Hinnant date library, written
+ * with 32-bit arithmetic and no branches, and they reproduce that library
+ * exactly, including its conversion of years to 16 bits and of months and
+ * days to 8 bits. Only <cstdint> is needed, so the header can be used where
+ * the date library cannot be compiled.
+ *
+ * Every function is constexpr, allocation free and marked FDATE_HOST_DEVICE,
+ * so GPU kernels can decompose timestamps and compute Julian dates in place.
+ * The Fortran equivalents are in the mod_datetime_device module.
+ */
+class CalendarMath {
+ public:
+  /** @brief Milliseconds in one day */
+  static constexpr int64_t MILLISECONDS_PER_DAY = 86400000;
+
+  /** @brief Julian Day of the J2000.0 epoch, 2000-01-01 12:00 */
+  static constexpr double J2000_JULIAN_DAY = 2451545.0;
+
+  /** @brief Days in a Julian century */
+  static constexpr double DAYS_PER_JULIAN_CENTURY = 36525.0;
+
+  /**
+   * @brief Calendar and clock fields of a date and time
+   */
+  struct s_Fields {
+    int year;              ///< Year (e.g., 2023)
+    unsigned month;        ///< Month (1-12)
+    unsigned day;          ///< Day of month (1-31)
+    unsigned hour;         ///< Hour (0-23)
+    unsigned minute;       ///< Minute (0-59)
+    unsigned second;       ///< Second (0-59)
+    unsigned millisecond;  ///< Millisecond (0-999)
+  };
+
+  /**
+   * @brief Converts a day count to a civil date
+   *
+   * Identical to date::year_month_day::from_days, including the conversion
+   * of the year to date::year.
+   *
+   * @param days Days since 1970-01-01
+   * @param year The year
+   * @param month The month (1-12)
+   * @param day The day of month (1-31)
+   */
+  FDATE_HOST_DEVICE static constexpr void civil_from_days(
+      const int days, int& year, unsigned& month, unsigned& day) noexcept {
+    const int z = days + 719468;
+    const int era = (z >= 0 ? z : z - 146096) / 146097;
+    const auto doe = static_cast<unsigned>(z - era * 146097);
+    const unsigned yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int y = static_cast<int>(yoe) + era * 400;
+    const unsigned doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const unsigned mp = (5 * doy + 2) / 153;
+    day = doy - (153 * mp + 2) / 5 + 1;
+    month = mp < 10 ? mp + 3 : mp - 9;
+    year = static_cast<int>(static_cast<int16_t>(y + (month <= 2 ? 1 : 0)));
+  }
+
+  /**
+   * @brief Converts a civil date to a day count
+   *
+   * Identical to date::year_month_day::to_days, including the conversion of
+   * the arguments to date::year, date::month and date::day.
+   *
+   * @param year The year
+   * @param month The month (1-12)
+   * @param day The day of month (1-31)
+   * @return int Days since 1970-01-01
+   */
+  FDATE_HOST_DEVICE static constexpr auto days_from_civil(
+      const int year, const unsigned month, const unsigned day) noexcept
+      -> int {
+    const auto m = static_cast<unsigned>(static_cast<uint8_t>(month));
+    const auto d = static_cast<unsigned>(static_cast<uint8_t>(day));
+    const int y =
+        static_cast<int>(static_cast<int16_t>(year)) - (m <= 2 ? 1 : 0);
+    const int era = (y >= 0 ? y : y - 399) / 400;
+    const auto yoe = static_cast<unsigned>(y - era * 400);
+    const unsigned doy = (153 * (m > 2 ? m - 3 : m + 9) + 2) / 5 + d - 1;
+    const unsigned doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int>(doe) - 719468;
+  }
+
+  /**
+   * @brief Gets the number of days in a month
+   *
+   * @param year The year
+   * @param month The month (1-12)
+   * @return unsigned The number of days in the month
+   */
+  FDATE_HOST_DEVICE static constexpr auto days_in_month(
+      const int year, const unsigned month) noexcept -> unsigned {
+    if (month == 2) {
+      const bool leap = year % 4 == 0 && (year % 100 != 0 || year % 400 == 0);
+      return leap ? 29 : 28;
+    }
+    return month == 4 || month == 6 || month == 9 || month == 11 ? 30 : 31;
+  }
+
+  /**
+   * @brief Splits milliseconds since midnight into clock fields
+   *
+   * @param milliseconds Milliseconds since midnight (0-86399999)
+   * @param fields Receives the hour, minute, second and millisecond
+   */
+  FDATE_HOST_DEVICE static constexpr void clock_fields(
+      const unsigned milliseconds, s_Fields& fields) noexcept {
+    fields.hour = milliseconds / 3600000U;
+    fields.minute = milliseconds / 60000U % 60U;
+    fields.second = milliseconds / 1000U % 60U;
+    fields.millisecond = milliseconds % 1000U;
+  }
+
+  /**
+   * @brief Computes the Julian Day Number for a calendar date
+   *
+   * @param fields The date components (only year, month and day are used)
+   * @return int64_t The Julian Day Number
+   */
+  FDATE_HOST_DEVICE static constexpr auto julian_day_number(
+      const s_Fields& fields) noexcept -> int64_t {
+    const auto y = static_cast<int64_t>(fields.year);
+    const auto m = static_cast<int64_t>(fields.month);
+    const auto d = static_cast<int64_t>(fields.day);
+
+    // Julian Day Number formula for Gregorian calendar
+    const auto a = (14 - m) / 12;
+    const auto y_adj = y + 4800 - a;
+    const auto m_adj = m + 12 * a - 3;
+
+    return d + (153 * m_adj + 2) / 5 + 365 * y_adj + y_adj / 4 - y_adj / 100 +
+           y_adj / 400 - 32045;
+  }
+
+  /**
+   * @brief Computes the Julian Day with fractional day for a date and time
+   *
+   * @param fields The calendar and clock fields
+   * @return double The Julian Day, which starts at noon
+   */
+  FDATE_HOST_DEVICE static constexpr auto julian_day(
+      const s_Fields& fields) noexcept -> double {
+    const auto jdn = static_cast<double>(julian_day_number(fields));
+    const auto h = static_cast<double>(fields.hour);
+    const auto min = static_cast<double>(fields.minute);
+    const auto s = static_cast<double>(fields.second);
+    const auto ms = static_cast<double>(fields.millisecond);
+
+    // Convert time to fractional day (Julian Day starts at noon, so subtract 12
+    // hours)
+    const auto fractional_day =
+        (h - 12.0) / 24.0 + min / 1440.0 + s / 86400.0 + ms / 86400000.0;
+
+    return jdn + fractional_day;
+  }
+
+  /**
+   * @brief Converts a Julian Day to Julian centuries since J2000.0
+   *
+   * @param julian_day The Julian Day
+   * @return double The Julian Century
+   */
+  FDATE_HOST_DEVICE static constexpr auto julian_century(
+      const double julian_day) noexcept -> double {
+    return (julian_day - J2000_JULIAN_DAY) / DAYS_PER_JULIAN_CENTURY;
+  }
+
+  /**
+   * @brief Splits milliseconds since the Unix epoch into calendar and clock
+   * fields
+   *
+   * Identical to DateTime::to_fields for every timestamp whose day count
+   * fits in an int.
+   *
+   * @param timestamp Milliseconds since 1970-01-01
+   * @param fields Receives the calendar and clock fields
+   */
+  FDATE_HOST_DEVICE static constexpr void timestamp_fields(
+      const int64_t timestamp, s_Fields& fields) noexcept {
+    const int64_t q = timestamp / MILLISECONDS_PER_DAY;
+    const int64_t r = timestamp % MILLISECONDS_PER_DAY;
+    const int64_t days = r < 0 ? q - 1 : q;
+    const int64_t milliseconds = r < 0 ? r + MILLISECONDS_PER_DAY : r;
+    civil_from_days(static_cast<int>(days), fields.year, fields.month,
+                    fields.day);
+    clock_fields(static_cast<unsigned>(milliseconds), fields);
+  }
+
+  /**
+   * @brief Combines calendar and clock fields into milliseconds since the
+   * Unix epoch
+   *
+   * Identical to the timestamp of the DateTime constructed from the same
+   * fields. No validation is performed.
+   *
+   * @param fields The calendar and clock fields
+   * @return int64_t Milliseconds since 1970-01-01
+   */
+  FDATE_HOST_DEVICE static constexpr auto fields_timestamp(
+      const s_Fields& fields) noexcept -> int64_t {
+    const int days = days_from_civil(fields.year, fields.month, fields.day);
+    return int64_t{days} * MILLISECONDS_PER_DAY +
+           int64_t{fields.hour} * 3600000 + int64_t{fields.minute} * 60000 +
+           int64_t{fields.second} * 1000 + int64_t{fields.millisecond};
+  }
+};
+
+#ifdef FDATE_DECLARE_TARGET
+#pragma omp end declare target
+#undef FDATE_DECLARE_TARGET
+#endif
+
+static_assert(CalendarMath::days_from_civil(-4799, 1, 1) == -2472326);
+static_assert(CalendarMath::days_from_civil(32767, 12, 31) == 11248737);
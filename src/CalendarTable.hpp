@@ -0,0 +1,201 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "CalendarMath.hpp"
+
+// Default window of the calendar table used by the DateTime getters when the
+// library is built with FDATE_ENABLE_CALENDAR_TABLE
+#ifndef FDATE_CALENDAR_TABLE_FIRST_YEAR
+#define FDATE_CALENDAR_TABLE_FIRST_YEAR 1900
+#endif
+#ifndef FDATE_CALENDAR_TABLE_LAST_YEAR
+#define FDATE_CALENDAR_TABLE_LAST_YEAR 2200
+#endif
+
+/**
+ * @brief Lookup tables from day counts to civil dates over a window of years
+ *
+ * The BasicCalendarTable class converts days since 1970-01-01 to a year,
+ * month and day with two table loads and a subtraction instead of the general
+ * civil-from-days arithmetic. Two tables are generated at compile time for the
+ * years FirstYear to LastYear:
+ * - MONTH_START holds the day count of the first day of every month of the
+ *   window, 12 entries per year (about 14 kB for three centuries).
+ * - DAY_MONTH holds, for every day of the window, the index of its month in
+ *   MONTH_START as a 16-bit integer (about 215 kB for three centuries).
+ *
+ * The year and month follow from the month index by a constant division, and
+ * the day of the month from the month start. Days outside the window are not
+ * in the tables and must be converted by the caller, see contains().
+ *
+ * The tables are only generated when the class is instantiated, and the
+ * compile time grows with the width of the window.
+ *
+ * @tparam FirstYear The first year of the window
+ * @tparam LastYear The last year of the window
+ */
+template <int FirstYear, int LastYear>
+class BasicCalendarTable {
+  static_assert(FirstYear <= LastYear, "The window must hold at least a year");
+  static_assert((LastYear - FirstYear + 1) * 12 <= 65536,
+                "Month indices must fit in 16 bits");
+  static_assert(FirstYear >= -32767 && LastYear < 32767,
+                "The window and the year after it must be inside the years "
+                "of DateTime");
+
+ public:
+  /** @brief Julian Day Number of 1970-01-01 */
+  static constexpr int64_t UNIX_EPOCH_JDN = 2440588;
+
+  /** @brief Number of months in the window */
+  static constexpr size_t MONTH_COUNT =
+      static_cast<size_t>(LastYear - FirstYear + 1) * 12;
+
+  /** @brief First day of the window in days since 1970-01-01 */
+  static constexpr int64_t FIRST_DAY =
+      CalendarMath::days_from_civil(FirstYear, 1, 1);
+
+  /** @brief Day after the end of the window in days since 1970-01-01 */
+  static constexpr int64_t END_DAY =
+      CalendarMath::days_from_civil(LastYear + 1, 1, 1);
+
+  /** @brief Number of days in the window */
+  static constexpr size_t DAY_COUNT = static_cast<size_t>(END_DAY - FIRST_DAY);
+
+  /** @brief First day of every month of the window, plus the end */
+  static constexpr std::array<int32_t, MONTH_COUNT + 1> MONTH_START =
+      BasicCalendarTable::make_month_start();
+
+  /** @brief Index in MONTH_START of the month of every day of the window */
+  static constexpr std::array<uint16_t, DAY_COUNT> DAY_MONTH =
+      BasicCalendarTable::make_day_month();
+
+  /**
+   * @brief Checks if a day is inside the window
+   *
+   * @param days Days since 1970-01-01
+   * @return bool True if the day can be converted with the tables
+   */
+  static constexpr auto contains(const int64_t days) noexcept -> bool {
+    return days >= FIRST_DAY && days < END_DAY;
+  }
+
+  /**
+   * @brief Gets the Julian Day Number of a day
+   *
+   * @param days Days since 1970-01-01
+   * @return int64_t The Julian Day Number
+   */
+  static constexpr auto julian_day_number(const int64_t days) noexcept
+      -> int64_t {
+    return days + UNIX_EPOCH_JDN;
+  }
+
+  /**
+   * @brief Converts a day inside the window to a civil date
+   *
+   * @param days Days since 1970-01-01, for which contains() is true
+   * @param year The year
+   * @param month The month (1-12)
+   * @param day The day of month (1-31)
+   */
+  static constexpr void to_civil(const int64_t days, int& year,
+                                 unsigned& month, unsigned& day) noexcept {
+    const unsigned index = month_index(days);
+    year = FirstYear + static_cast<int>(index / 12);
+    month = index % 12 + 1;
+    day = static_cast<unsigned>(days - MONTH_START[index]) + 1;
+  }
+
+  /**
+   * @brief Gets the year of a day inside the window
+   *
+   * @param days Days since 1970-01-01, for which contains() is true
+   * @return int The year
+   */
+  static constexpr auto year(const int64_t days) noexcept -> int {
+    return FirstYear + static_cast<int>(month_index(days) / 12);
+  }
+
+  /**
+   * @brief Gets the month of a day inside the window
+   *
+   * @param days Days since 1970-01-01, for which contains() is true
+   * @return unsigned The month (1-12)
+   */
+  static constexpr auto month(const int64_t days) noexcept -> unsigned {
+    return month_index(days) % 12 + 1;
+  }
+
+  /**
+   * @brief Gets the day of month of a day inside the window
+   *
+   * @param days Days since 1970-01-01, for which contains() is true
+   * @return unsigned The day of month (1-31)
+   */
+  static constexpr auto day(const int64_t days) noexcept -> unsigned {
+    return static_cast<unsigned>(days - MONTH_START[month_index(days)]) + 1;
+  }
+
+ private:
+  /**
+   * @brief Gets the index of the month of a day in MONTH_START
+   */
+  static constexpr auto month_index(const int64_t days) noexcept -> unsigned {
+    return DAY_MONTH[static_cast<size_t>(days - FIRST_DAY)];
+  }
+
+  /**
+   * @brief Generates the first day of every month of the window
+   */
+  static constexpr auto make_month_start() noexcept
+      -> std::array<int32_t, MONTH_COUNT + 1> {
+    std::array<int32_t, MONTH_COUNT + 1> starts{};
+    for (size_t i = 0; i <= MONTH_COUNT; ++i) {
+      starts[i] = CalendarMath::days_from_civil(
+          FirstYear + static_cast<int>(i / 12),
+          static_cast<unsigned>(i % 12) + 1, 1);
+    }
+    return starts;
+  }
+
+  /**
+   * @brief Generates the month index of every day of the window
+   */
+  static constexpr auto make_day_month() noexcept
+      -> std::array<uint16_t, DAY_COUNT> {
+    std::array<uint16_t, DAY_COUNT> day_month{};
+    for (size_t i = 0; i < MONTH_COUNT; ++i) {
+      const auto begin = static_cast<size_t>(MONTH_START[i] - FIRST_DAY);
+      const auto end = static_cast<size_t>(MONTH_START[i + 1] - FIRST_DAY);
+      for (size_t d = begin; d < end; ++d) {
+        day_month[d] = static_cast<uint16_t>(i);
+      }
+    }
+    return day_month;
+  }
+};
+
+/** @brief Calendar table over the window selected when building fdate */
+using CalendarTable = BasicCalendarTable<FDATE_CALENDAR_TABLE_FIRST_YEAR,
+                                         FDATE_CALENDAR_TABLE_LAST_YEAR>;
@@ -0,0 +1,1272 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <iosfwd>
+#include <ratio>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "CalendarMath.hpp"
+#ifdef FDATE_CALENDAR_TABLE
+#include "CalendarTable.hpp"
+#endif
+#include "TimeDelta.hpp"
+
+class DateTimeFormat;
+
+template <typename Spec, bool Milliseconds>
+class FixedDateTimeFormat;
+
+/**
+ * @brief A point in time with a precision and epoch chosen at compile time
+ *
+ * The DateTime class provides a comprehensive interface for date and time
+ * operations with millisecond precision. It supports parsing from multiple
+ * string formats, formatting to various output formats, and arithmetic
+ * operations with TimeDelta objects.
+ *
+ * The class uses std::chrono and CalendarMath internally for time
+ * calculations and the Howard Hinnant date library for parsing and formatting
+ * operations.
+ *
+ * This header holds the storage, arithmetic, comparisons and calendar getters,
+ * and needs neither <sstream> nor the date library. The parsing and formatting
+ * members are only declared here. They are defined in DateTimeIO.hpp, which
+ * DateTime.hpp includes, and compiled into the fdate library for DateTime,
+ * CompactDateTime and PreciseDateTime, so code that includes only this header
+ * and calls them must link against fdate.
+ *
+ * The time is stored as a single count of Duration since January 1 of
+ * EpochYear, so the precision and the size of the object are fixed at compile
+ * time and the calendar arithmetic is specialized for them. DateTime is the
+ * millisecond, Unix epoch instantiation used throughout fdate and by the C
+ * interface. CompactDateTime stores whole seconds since 2000 in 32 bits,
+ * covering 1932 to 2068 in half the memory, and PreciseDateTime stores
+ * microseconds since the Unix epoch.
+ *
+ * Whatever the storage, timestamp() and the constructor taking an int64_t
+ * use milliseconds since the Unix epoch, and parsing and formatting work to
+ * millisecond precision. count() and from_count() give the stored value.
+ *
+ * @tparam Duration The std::chrono::duration counted from the epoch. Its
+ * period must be one second or finer.
+ * @tparam EpochYear The year whose January 1 the count is measured from
+ *
+ * @see BasicTimeDelta for time duration operations
+ *
+ * @note Thread Safety: All DateTime operations are thread-safe for read-only
+ * operations. Parsing operations are thread-safe as they don't modify the
+ * global state. Errors in the C interface are recorded per thread with
+ * FDateError rather than written to stderr.
+ */
+template <typename Duration, int EpochYear = 1970>
+class BasicDateTime {
+  static_assert(
+      std::ratio_less_equal_v<typename Duration::period, std::ratio<1>>,
+      "BasicDateTime needs a precision of one second or finer");
+
+ public:
+  /** @brief The std::chrono::duration counted from the epoch */
+  using t_duration = Duration;
+
+  /** @brief The TimeDelta of the same precision */
+  using t_time_delta = BasicTimeDelta<Duration>;
+
+ private:
+  /** @brief Integer type of the stored count */
+  using t_rep = typename Duration::rep;
+
+  /** @brief Duration of the same precision wide enough for calendar math */
+  using t_wide_duration =
+      std::conditional_t<(sizeof(t_rep) >= sizeof(int64_t)), Duration,
+                         std::chrono::duration<int64_t,
+                                               typename Duration::period>>;
+
+  /** @brief Whole days, with the same 32-bit count as date::days */
+  using t_days = std::chrono::duration<int, std::ratio<86400>>;
+
+  /** @brief A day on the system clock, equivalent to date::sys_days */
+  using t_sys_days = std::chrono::time_point<std::chrono::system_clock, t_days>;
+
+  /** @brief Internal time point type used for calendar calculations */
+  using t_time_point =
+      std::chrono::time_point<std::chrono::system_clock, t_wide_duration>;
+
+  /** @brief True for the millisecond, Unix epoch layout of DateTime */
+  static constexpr bool IS_UNIX_MILLISECONDS =
+      std::is_same_v<Duration, std::chrono::milliseconds> && EpochYear == 1970;
+
+  /** @brief The time point the stored count is measured from */
+  static constexpr auto EPOCH = t_time_point(
+      t_sys_days(t_days(CalendarMath::days_from_civil(EpochYear, 1, 1))));
+
+  /** @brief Internal storage, Duration since EPOCH */
+  Duration m_since_epoch;
+
+  /**
+   * @brief Description of a fixed-width layout handled by the fast parser
+   *
+   * Each layout corresponds to exactly one strftime-style format string. The
+   * separators describe the characters expected between the fields, with '\0'
+   * meaning the fields are packed together (e.g., "%Y%m%d%H%M%S").
+   */
+  struct s_FixedWidthLayout {
+    const char* format;        ///< Format string this layout matches
+    char date_separator;       ///< Separator between year, month and day
+    char date_time_separator;  ///< Separator between the date and the time
+    char time_separator;       ///< Separator between hour, minute and second
+    bool has_time;             ///< True if hour and minute fields follow
+    bool has_seconds;          ///< True if a seconds field follows the minute
+    bool trailing_z;           ///< True if the string ends with a 'Z'
+  };
+
+  /**
+   * @brief Layouts that are parsed without going through a stream
+   *
+   * These are also the formats used by strptime() when the format is "auto",
+   * ordered from the most specific to the least specific. All of them use
+   * YYYY-MM-DD ordering to avoid ambiguity.
+   */
+  static constexpr std::array<s_FixedWidthLayout, 11> FIXED_WIDTH_LAYOUTS = {{
+      // 2023-12-01 14:30:25
+      {"%Y-%m-%d %H:%M:%S", '-', ' ', ':', true, true, false},
+      // 2023-12-01T14:30:25Z (ISO with timezone)
+      {"%Y-%m-%dT%H:%M:%SZ", '-', 'T', ':', true, true, true},
+      // 2023-12-01T14:30:25 (ISO)
+      {"%Y-%m-%dT%H:%M:%S", '-', 'T', ':', true, true, false},
+      // 2023/12/01 14:30:25
+      {"%Y/%m/%d %H:%M:%S", '/', ' ', ':', true, true, false},
+      // 2023.12.01 14:30:25
+      {"%Y.%m.%d %H:%M:%S", '.', ' ', ':', true, true, false},
+      // 20231201143025
+      {"%Y%m%d%H%M%S", '\0', '\0', '\0', true, true, false},
+      // 2023/12/01 14:30
+      {"%Y/%m/%d %H:%M", '/', ' ', ':', true, false, false},
+      // 2023-12-01
+      {"%Y-%m-%d", '-', '\0', '\0', false, false, false},
+      // 2023/12/01
+      {"%Y/%m/%d", '/', '\0', '\0', false, false, false},
+      // 2023.12.01
+      {"%Y.%m.%d", '.', '\0', '\0', false, false, false},
+      // 20231201
+      {"%Y%m%d", '\0', '\0', '\0', false, false, false},
+  }};
+
+  /**
+   * @brief Checks for an optional separator character in a string
+   *
+   * @param str The string to read from
+   * @param pos Current position, advanced past the separator on success
+   * @param separator The expected separator, or '\0' if there is none
+   * @return bool True if the separator was found (or none was expected)
+   */
+  static auto read_separator(const std::string_view str, size_t& pos,
+                             const char separator) noexcept -> bool;
+
+  /**
+   * @brief Stream-free parser for the common fixed-width timestamp layouts
+   *
+   * Handles strings that exactly match one of FIXED_WIDTH_LAYOUTS, including
+   * an optional ".mmm" millisecond suffix after a seconds field (not combined
+   * with a trailing 'Z'). No locale, stream or heap allocation is used.
+   *
+   * @param str The string to parse
+   * @param layout The layout the string is expected to match
+   * @param result The parsed DateTime, which is invalid if the
+   * fields are well formed but out of range
+   * @return bool True if the string matched the layout and result has been
+   * set. False if the string should be handed to the stream based parser.
+   */
+  static auto parse_fixed_width(const std::string_view str,
+                                const s_FixedWidthLayout& layout,
+                                BasicDateTime& result) noexcept -> bool;
+
+  /**
+   * @brief Selects the auto-detection format matching the shape of a string
+   *
+   * Looks at the length of the string and the characters at the separator
+   * positions to pick the single entry in FIXED_WIDTH_LAYOUTS that can match
+   * it. The digits themselves are checked later by parse_fixed_width().
+   *
+   * @param str The string to classify
+   * @return int Index into FIXED_WIDTH_LAYOUTS, or -1 if the string does not
+   * have the shape of any of the fixed-width layouts
+   */
+  static auto classify_auto_format(const std::string_view str) noexcept
+      -> int;
+
+  /**
+   * @brief Splits a time point into the fields used by DateTimeFormat
+   *
+   * @tparam TimePointDuration The precision of the time point
+   * @param time_point The time point to split
+   * @return CalendarMath::s_Fields The calendar and clock fields
+   */
+  template <typename TimePointDuration>
+  static constexpr auto to_format_fields(
+      const std::chrono::time_point<std::chrono::system_clock,
+                                    TimePointDuration>& time_point) noexcept
+      -> CalendarMath::s_Fields {
+    const auto day_point = std::chrono::floor<t_days>(time_point);
+    CalendarMath::s_Fields fields{};
+    civil_date(day_point, fields.year, fields.month, fields.day);
+    CalendarMath::clock_fields(
+        static_cast<unsigned>(
+            std::chrono::duration_cast<std::chrono::milliseconds>(time_point -
+                                                                  day_point)
+                .count()),
+        fields);
+    return fields;
+  }
+
+  /**
+   * @brief Splits a day into a civil date
+   *
+   * When fdate is built with FDATE_ENABLE_CALENDAR_TABLE, days inside the
+   * window of CalendarTable are looked up in its tables. Other days use the
+   * general conversion of CalendarMath.
+   *
+   * @param day_point The day
+   * @param year The year
+   * @param month The month (1-12)
+   * @param day The day of month (1-31)
+   */
+  static constexpr void civil_date(const t_sys_days& day_point, int& year,
+                                   unsigned& month, unsigned& day) noexcept {
+#ifdef FDATE_CALENDAR_TABLE
+    if (const int64_t days = day_point.time_since_epoch().count();
+        CalendarTable::contains(days)) {
+      CalendarTable::to_civil(days, year, month, day);
+      return;
+    }
+#endif
+    CalendarMath::civil_from_days(day_point.time_since_epoch().count(), year,
+                                  month, day);
+  }
+
+  /**
+   * @brief Gets the civil date of the stored time
+   *
+   * @return CalendarMath::s_Fields The year, month and day, with the clock
+   * fields set to zero
+   */
+  [[nodiscard]] constexpr auto civil_fields() const noexcept
+      -> CalendarMath::s_Fields {
+    CalendarMath::s_Fields fields{};
+    civil_date(std::chrono::floor<t_days>(sys_time()), fields.year,
+               fields.month, fields.day);
+    return fields;
+  }
+
+  /**
+   * @brief Gets the stored time as a time point on the system clock
+   *
+   * @return t_time_point The time point, in 64 bits whatever the storage
+   */
+  [[nodiscard]] constexpr auto sys_time() const noexcept -> t_time_point {
+    return EPOCH + t_wide_duration(m_since_epoch);
+  }
+
+  /**
+   * @brief Converts a time point on the system clock to the stored count
+   *
+   * @tparam OtherDuration The precision of the time point
+   * @param time_point The time point, rounded down to this precision
+   * @return Duration Duration since EPOCH, or INVALID_COUNT if it does not fit
+   * in the stored count
+   */
+  template <typename OtherDuration>
+  static constexpr auto since_epoch(
+      const std::chrono::time_point<std::chrono::system_clock, OtherDuration>&
+          time_point) noexcept -> Duration {
+    const auto count =
+        (std::chrono::floor<t_wide_duration>(time_point) - EPOCH).count();
+    if constexpr (sizeof(t_rep) < sizeof(int64_t)) {
+      if (count <= -std::numeric_limits<t_rep>::max() ||
+          count > std::numeric_limits<t_rep>::max()) {
+        return Duration(INVALID_COUNT);
+      }
+      return Duration(static_cast<t_rep>(count));
+    } else {
+      return Duration(count);
+    }
+  }
+
+  /**
+   * @brief Converts milliseconds since the Unix epoch to the stored count
+   *
+   * @param timestamp Milliseconds since the Unix epoch, or INVALID_TIMESTAMP
+   * @return Duration Duration since EPOCH, or INVALID_COUNT
+   */
+  static constexpr auto from_timestamp(const int64_t timestamp) noexcept
+      -> Duration {
+    if constexpr (IS_UNIX_MILLISECONDS) {
+      return Duration(timestamp);
+    } else {
+      if (timestamp == INVALID_TIMESTAMP) {
+        return Duration(INVALID_COUNT);
+      }
+      return since_epoch(
+          std::chrono::time_point<std::chrono::system_clock,
+                                  std::chrono::milliseconds>(
+              std::chrono::milliseconds(timestamp)));
+    }
+  }
+
+  /**
+   * @brief Gets the time elapsed since midnight
+   *
+   * @return unsigned Milliseconds since midnight (0-86399999)
+   */
+  [[nodiscard]] constexpr auto time_of_day() const noexcept -> unsigned {
+    const auto time_point = sys_time();
+    return static_cast<unsigned>(
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            time_point - std::chrono::floor<t_days>(time_point))
+            .count());
+  }
+
+  /**
+   * @brief Computes the Julian Day Number for a calendar date
+   *
+   * @param fields The date components (only year, month and day are used)
+   * @return int64_t The Julian Day Number
+   */
+  static constexpr auto julian_day_number(
+      const CalendarMath::s_Fields& fields) noexcept -> int64_t {
+    return CalendarMath::julian_day_number(fields);
+  }
+
+  /**
+   * @brief Splits the DateTime into the fields used for formatting
+   *
+   * @param milliseconds If false, the time is first truncated to seconds in
+   * the same way as strftime()
+   * @return CalendarMath::s_Fields The calendar and clock fields
+   */
+  [[nodiscard]] auto format_fields(const bool milliseconds) const noexcept
+      -> CalendarMath::s_Fields {
+    if (milliseconds) {
+      return to_format_fields(sys_time());
+    }
+    return to_format_fields(
+        std::chrono::time_point_cast<std::chrono::seconds>(sys_time()));
+  }
+
+  /**
+   * @brief Formats the DateTime using the Howard Hinnant date library
+   *
+   * @param fmt The strftime-style format string
+   * @param milliseconds If false, the time is truncated to seconds precision
+   * @return std::string The formatted date/time string
+   */
+  [[nodiscard]] auto stream_strftime(const std::string& fmt,
+                                     const bool milliseconds) const
+      -> std::string;
+
+  /**
+   * @brief Formats the DateTime as a string, avoiding the stream when possible
+   *
+   * @param fmt The strftime-style format string
+   * @param milliseconds If false, the time is truncated to seconds precision
+   * @return std::string The formatted date/time string
+   */
+  [[nodiscard]] auto format_string(const std::string& fmt,
+                                   const bool milliseconds) const
+      -> std::string;
+
+  /**
+   * @brief Formats the DateTime as an ISO 8601 string
+   *
+   * @tparam Milliseconds If true, the seconds are followed by ".mmm"
+   * @return std::string The formatted string, using the stream based
+   * formatter for years outside 0-9999
+   */
+  template <bool Milliseconds>
+  [[nodiscard]] auto iso_string() const -> std::string;
+
+  /**
+   * @brief Copies a string into a character buffer with truncation
+   *
+   * @param str The string to copy
+   * @param out The destination buffer (may be nullptr if capacity is 0)
+   * @param capacity The size of the destination buffer
+   * @return size_t The length of the string
+   */
+  static auto copy_to(const std::string& str, char* out,
+                      const size_t capacity) noexcept -> size_t;
+
+  /**
+   * @brief Parses a DateTime from a string using a specific format
+   *
+   * Strings matching one of the fixed-width layouts in FIXED_WIDTH_LAYOUTS are
+   * handled by parse_fixed_width(). Everything else uses the Howard Hinnant
+   * date library for parsing. Automatically detects and handles millisecond
+   * precision based on the presence of a decimal point in the appropriate
+   * position within the input string.
+   *
+   * @param str The string to parse
+   * @param format The strftime-style format string (default: "%Y-%m-%d
+   * %H:%M:%S")
+   * @return DateTime containing the parsed DateTime, or an invalid DateTime
+   * if parsing failed (check with .valid())
+   *
+   * @note If the string has a '.' at position (length-4), millisecond parsing
+   * is attempted
+   * @see parse() for automatic format detection
+   */
+  static auto parse_string(const std::string_view str,
+                           const std::string_view format = "%Y-%m-%d %H:%M:%S")
+      -> BasicDateTime;
+
+  /**
+   * @brief Parses a DateTime from a string with the stream based parser
+   *
+   * @param str The string to parse
+   * @param format The null terminated strftime-style format string
+   * @return DateTime containing the parsed DateTime, or an invalid DateTime
+   * if parsing failed (check with .valid())
+   * @see parse_string()
+   */
+  static auto parse_stream(const std::string_view str, const char* format)
+      -> BasicDateTime;
+
+  /**
+   * @brief Parses a DateTime from a string by trying each automatic format
+   *
+   * @param str The string to parse
+   * @return DateTime containing the parsed DateTime, or an invalid DateTime
+   * if no format matched
+   * @see strptime() for the order in which the formats are tried
+   */
+  static auto parse_auto(const std::string_view str) -> BasicDateTime;
+
+  /**
+   * @brief Gets the number of characters format_to() left in a buffer
+   *
+   * @param size The full length of the formatted string
+   * @param capacity The size of the buffer
+   * @return size_t The number of characters written before the terminator
+   */
+  static constexpr auto written_length(const size_t size,
+                                       const size_t capacity) noexcept
+      -> size_t {
+    return capacity == 0 ? 0 : std::min(size, capacity - 1);
+  }
+
+  /**
+   * @brief Rounds a count down to a multiple of a step
+   *
+   * @param value The count
+   * @param step The step, greater than zero
+   * @return The largest multiple of step not greater than value
+   */
+  template <typename Integer>
+  static constexpr auto floor_multiple(const Integer value,
+                                       const Integer step) noexcept
+      -> Integer {
+    const Integer quotient = value / step;
+    return (value % step < 0 ? quotient - 1 : quotient) * step;
+  }
+
+  /**
+   * @brief Creates the DateTime at midnight on the first day of a month
+   *
+   * @param month_index Months since January of year 0
+   * @return DateTime The start of the month
+   */
+  static constexpr auto month_start(const int64_t month_index) noexcept
+      -> BasicDateTime {
+    const auto year = floor_multiple(month_index, int64_t{12}) / 12;
+    const auto month = static_cast<unsigned>(month_index - year * 12) + 1;
+    return BasicDateTime(t_sys_days(t_days(
+        CalendarMath::days_from_civil(static_cast<int>(year), month, 1))));
+  }
+
+  /**
+   * @brief Gets the month of the stored time counted from year 0
+   *
+   * @return int64_t Months since January of year 0
+   */
+  [[nodiscard]] constexpr auto month_index() const noexcept -> int64_t {
+    const auto fields = civil_fields();
+    return int64_t{fields.year} * 12 + fields.month - 1;
+  }
+
+ public:
+  /** @brief Constant representing an invalid timestamp value */
+  static constexpr auto INVALID_TIMESTAMP =
+      -std::numeric_limits<int64_t>::max();
+
+  /** @brief Stored count of an invalid DateTime */
+  static constexpr auto INVALID_COUNT = -std::numeric_limits<t_rep>::max();
+
+  /** @brief Constant representing an invalid DateTime object */
+  static constexpr auto INVALID_TIME_POINT =
+      EPOCH + t_wide_duration(INVALID_COUNT);
+
+  static constexpr int DATETIME_MIN_YEAR = 0;
+  static constexpr int DATETIME_MIN_MONTH = 1;
+  static constexpr int DATETIME_MAX_MONTH = 12;
+  static constexpr int DATETIME_MAX_DAYS = 31;
+  static constexpr int DATETIME_MIN_DAYS = 1;
+  static constexpr int DATETIME_MAX_HOURS = 23;
+  static constexpr int DATETIME_MIN_HOURS = 0;
+  static constexpr int DATETIME_MAX_MINUTES = 59;
+  static constexpr int DATETIME_MIN_MINUTES = 0;
+  static constexpr int DATETIME_MAX_SECONDS = 59;
+  static constexpr int DATETIME_MIN_SECONDS = 0;
+  static constexpr int DATETIME_MAX_MILLISECONDS = 999;
+  static constexpr int DATETIME_MIN_MILLISECONDS = 0;
+
+  /** @brief Size of the stack buffer used when formatting to a string */
+  static constexpr size_t DATETIME_FORMAT_BUFFER_SIZE = 64;
+
+  // Constructors
+
+  /**
+   * @brief Default constructor creating a DateTime at the epoch, which for
+   * DateTime is the Unix epoch (1970-01-01 00:00:00.000)
+   */
+  constexpr BasicDateTime() noexcept : m_since_epoch(Duration(0)) {};
+
+  /**
+   * @brief Default destructor
+   */
+  ~BasicDateTime() = default;
+
+  /**
+   * @brief Constructs a DateTime from individual date and time components
+   *
+   * @param year The year (e.g., 2023)
+   * @param month The month (1-12)
+   * @param day The day of month (1-31)
+   * @param hour The hour (0-23, default: 0)
+   * @param minute The minute (0-59, default: 0)
+   * @param second The second (0-59, default: 0)
+   * @param millisecond The millisecond (0-999, default: 0)
+   *
+   * @note No validation is performed on input values. Invalid dates may produce
+   * unexpected results.
+   */
+  constexpr BasicDateTime(int year, unsigned month, unsigned day,
+                          unsigned hour = 0, unsigned minute = 0,
+                          unsigned second = 0,
+                          unsigned millisecond = 0) noexcept
+      : m_since_epoch(since_epoch(
+            t_sys_days(
+                t_days(CalendarMath::days_from_civil(year, month, day))) +
+            std::chrono::hours{hour} + std::chrono::minutes{minute} +
+            std::chrono::seconds{second} +
+            std::chrono::milliseconds{millisecond})) {
+#ifndef NDEBUG
+    assert(month >= DATETIME_MIN_MONTH && month <= DATETIME_MAX_MONTH);
+    assert(day >= DATETIME_MIN_DAYS && day <= DATETIME_MAX_DAYS);
+    assert(hour <= DATETIME_MAX_HOURS);
+    assert(minute <= DATETIME_MAX_MINUTES);
+    assert(second <= DATETIME_MAX_SECONDS);
+    assert(millisecond <= DATETIME_MAX_MILLISECONDS);
+#endif
+  }
+
+  /**
+   * @brief Constructs a DateTime from a timestamp
+   *
+   * @param timestamp Milliseconds since Unix epoch (1970-01-01 00:00:00.000
+   * UTC), rounded down to the precision of the DateTime
+   */
+  explicit constexpr BasicDateTime(int64_t timestamp) noexcept
+      : m_since_epoch(from_timestamp(timestamp)) {}
+
+  /**
+   * @brief Constructs a DateTime from a time_point
+   *
+   * @tparam OtherDuration The precision of the time point
+   * @param time_point A std::chrono::time_point on the system clock, rounded
+   * down to the precision of the DateTime. The DateTime is invalid if the
+   * time does not fit in its storage.
+   */
+  template <typename OtherDuration>
+  constexpr explicit BasicDateTime(
+      const std::chrono::time_point<std::chrono::system_clock, OtherDuration>&
+          time_point) noexcept
+      : m_since_epoch(since_epoch(time_point)) {}
+
+  /**
+   * @brief Converts a DateTime of another precision or epoch
+   *
+   * @param other The DateTime to convert, rounded down to this precision.
+   * Invalid DateTimes and times that do not fit in this storage convert to an
+   * invalid DateTime.
+   */
+  template <typename OtherDuration, int OtherEpochYear>
+  constexpr explicit BasicDateTime(
+      const BasicDateTime<OtherDuration, OtherEpochYear>& other) noexcept
+      : m_since_epoch(other.valid() ? since_epoch(other.get_time_point())
+                                    : Duration(INVALID_COUNT)) {}
+
+  /**
+   * @brief Creates a DateTime from its stored count
+   *
+   * @param count Number of Duration periods since the epoch
+   * @return DateTime The DateTime, invalid if count is INVALID_COUNT
+   */
+  [[nodiscard]] static constexpr auto from_count(const t_rep count) noexcept
+      -> BasicDateTime {
+    BasicDateTime result;
+    result.m_since_epoch = Duration(count);
+    return result;
+  }
+
+  /**
+   * @brief Parses a DateTime from a string using automatic or specified format
+   * detection
+   *
+   * When format is "auto", the function attempts to parse the string using a
+   * predefined list of common date/time formats. All auto-detected formats use
+   * YYYY-MM-DD date component ordering to avoid ambiguity.
+   *
+   * Supported auto-detection formats:
+   * - "%Y-%m-%d %H:%M:%S" (2023-12-01 14:30:25)
+   * - "%Y-%m-%dT%H:%M:%SZ" (2023-12-01T14:30:25Z - ISO with timezone)
+   * - "%Y-%m-%dT%H:%M:%S" (2023-12-01T14:30:25 - ISO format)
+   * - "%Y/%m/%d %H:%M:%S" (2023/12/01 14:30:25)
+   * - "%Y.%m.%d %H:%M:%S" (2023.12.01 14:30:25)
+   * - "%Y%m%d%H%M%S" (20231201143025 - compact format)
+   * - "%Y/%m/%d %H:%M" (2023/12/01 14:30)
+   * - "%Y-%m-%d" (2023-12-01)
+   * - "%Y/%m/%d" (2023/12/01)
+   * - "%Y.%m.%d" (2023.12.01)
+   * - "%Y%m%d" (20231201 - compact date only)
+   *
+   * The string is read in place, so it need not be null terminated. Only
+   * strings that fall back to the stream based parser are copied.
+   *
+   * @param str The string to parse
+   * @param format The format string to use, or "auto" for automatic detection
+   * (default: "auto")
+   * @return DateTime containing the parsed DateTime, or an invalid DateTime
+   * if parsing failed (check with .valid())
+   *
+   * @note Strings in the canonical fixed-width shape of one of these formats
+   * are classified by their length and separators and parsed directly. Other
+   * strings are tried against each format in order from most specific to
+   * least specific, so the precedence is the same either way.
+   * @see parse_string() for single format parsing
+   */
+  static auto strptime(const std::string_view str,
+                       const std::string_view format = "auto")
+      -> BasicDateTime;
+
+  /**
+   * @brief Parses a DateTime from a string using a compiled format
+   *
+   * Strings that match the compiled format exactly, with every field at its
+   * full width, are read without a stream. Anything else is handed to the
+   * string based strptime() with the original format, so the result is the
+   * same as calling strptime(str, format.pattern()).
+   *
+   * @param str The string to parse
+   * @param format The compiled format
+   * @return DateTime containing the parsed DateTime, or an invalid DateTime
+   * if parsing failed (check with .valid())
+   */
+  static auto strptime(const std::string_view str,
+                       const DateTimeFormat& format) -> BasicDateTime;
+
+  /**
+   * @brief Gets one of the formats tried by strptime() with "auto"
+   *
+   * @param index Position of the format in the order of precedence, from 0
+   * @return const char* The format, or nullptr if index is out of range
+   */
+  [[nodiscard]] static constexpr auto auto_format(const size_t index) noexcept
+      -> const char* {
+    return index < FIXED_WIDTH_LAYOUTS.size()
+               ? FIXED_WIDTH_LAYOUTS[index].format
+               : nullptr;
+  }
+
+  /**
+   * @brief Gets the timestamp as milliseconds since Unix epoch
+   *
+   * @return int64_t The number of milliseconds since 1970-01-01 00:00:00.000
+   * UTC
+   */
+  [[nodiscard]] constexpr auto timestamp() const noexcept -> int64_t {
+    if constexpr (IS_UNIX_MILLISECONDS) {
+      return m_since_epoch.count();
+    } else {
+      if (!valid()) {
+        return INVALID_TIMESTAMP;
+      }
+      return std::chrono::floor<std::chrono::milliseconds>(sys_time())
+          .time_since_epoch()
+          .count();
+    }
+  }
+
+  /**
+   * @brief Gets the stored count
+   *
+   * @return The number of Duration periods since the epoch, INVALID_COUNT for
+   * an invalid DateTime
+   */
+  [[nodiscard]] constexpr auto count() const noexcept -> t_rep {
+    return m_since_epoch.count();
+  }
+
+  /**
+   * @brief Formats the DateTime as a string without milliseconds
+   *
+   * @param fmt The strftime-style format string (default: "%Y-%m-%d %H:%M:%S")
+   * @return std::string The formatted date/time string
+   *
+   * @note This method truncates to seconds precision
+   * @see format_w_milliseconds() for millisecond precision formatting
+   */
+  [[nodiscard]] auto strftime(
+      const std::string& fmt = "%Y-%m-%d %H:%M:%S") const -> std::string;
+
+  /**
+   * @brief Formats the DateTime as a string with millisecond precision
+   *
+   * @param fmt The strftime-style format string (default: "%Y-%m-%d %H:%M:%S")
+   * @return std::string The formatted date/time string including milliseconds
+   *
+   * @see format() for seconds precision formatting
+   */
+  [[nodiscard]] auto strftime_w_milliseconds(
+      const std::string& fmt = "%Y-%m-%d %H:%M:%S") const -> std::string;
+
+  /**
+   * @brief Formats the DateTime as a string without milliseconds using a
+   * compiled format
+   *
+   * @param fmt The compiled format
+   * @return std::string The formatted date/time string
+   *
+   * @note This method truncates to seconds precision
+   * @see strftime(const std::string&) for the string based equivalent
+   */
+  [[nodiscard]] auto strftime(const DateTimeFormat& fmt) const -> std::string;
+
+  /**
+   * @brief Formats the DateTime as a string with millisecond precision using a
+   * compiled format
+   *
+   * @param fmt The compiled format
+   * @return std::string The formatted date/time string including milliseconds
+   *
+   * @see strftime_w_milliseconds(const std::string&) for the string based
+   * equivalent
+   */
+  [[nodiscard]] auto strftime_w_milliseconds(const DateTimeFormat& fmt) const
+      -> std::string;
+
+  /**
+   * @brief Formats the DateTime directly into a character buffer
+   *
+   * Writes at most (capacity - 1) characters followed by a null terminator,
+   * in the same way as snprintf. Formats using only %Y, %m, %d, %H, %M, %S, %F,
+   * %T, %R and %% with a year in the range 0-9999 are written without any heap
+   * allocation. Anything else is formatted with the stream based formatter and
+   * copied into the buffer.
+   *
+   * @param out The destination buffer (may be nullptr if capacity is 0)
+   * @param capacity The size of the destination buffer
+   * @param fmt The strftime-style format string (need not be null terminated)
+   * @param fmt_length The length of the format string
+   * @param milliseconds If true, %S includes milliseconds as in
+   * strftime_w_milliseconds()
+   * @return size_t The full length of the formatted string. The output was
+   * truncated if this is larger than or equal to capacity.
+   */
+  auto format_to(char* out, const size_t capacity, const char* fmt,
+                 const size_t fmt_length, const bool milliseconds = false) const
+      -> size_t;
+
+  /**
+   * @brief Formats the DateTime directly into a character buffer using a
+   * compiled format
+   *
+   * @param out The destination buffer (may be nullptr if capacity is 0)
+   * @param capacity The size of the destination buffer
+   * @param fmt The compiled format
+   * @param milliseconds If true, %S includes milliseconds as in
+   * strftime_w_milliseconds()
+   * @return size_t The full length of the formatted string. The output was
+   * truncated if this is larger than or equal to capacity.
+   * @see format_to(char*, size_t, const char*, size_t, bool)
+   */
+  auto format_to(char* out, const size_t capacity, const DateTimeFormat& fmt,
+                 const bool milliseconds = false) const -> size_t;
+
+  /**
+   * @brief Formats an array of timestamps into a block of fixed-width strings
+   *
+   * Element i is written to out + i * width and padded with blanks to width
+   * characters, matching the layout of a Fortran character(len=width) array.
+   * No null terminators are written and longer results are truncated. When
+   * the compiled format fits in width, each element is a fixed set of digit
+   * writes with no stream or heap use.
+   *
+   * @param timestamps Array of count timestamps in milliseconds since epoch
+   * @param count Number of timestamps
+   * @param fmt The compiled format
+   * @param out Destination block of count * width characters
+   * @param width Width of each string in the destination block
+   * @param milliseconds If true, %S includes milliseconds as in
+   * strftime_w_milliseconds()
+   */
+  static void format_array_to(const int64_t* timestamps, const size_t count,
+                              const DateTimeFormat& fmt, char* out,
+                              const size_t width,
+                              const bool milliseconds = false);
+
+  /**
+   * @brief Formats the DateTime with a format fixed at compile time
+   *
+   * The output length and field offsets are constants of the format, so this
+   * only fills digits into the buffer.
+   *
+   * @tparam Spec Type holding the format string as Spec::PATTERN, e.g.
+   * FixedIso
+   * @tparam Milliseconds If true, %S includes milliseconds as in
+   * strftime_w_milliseconds()
+   * @param out Receives the formatted string, with no null terminator
+   * @return bool True if the DateTime was written. False if its year is
+   * outside 0-9999, which the fixed width cannot hold.
+   * @see FixedDateTimeFormat
+   */
+  template <typename Spec, bool Milliseconds = false>
+  auto format(typename FixedDateTimeFormat<Spec, Milliseconds>::t_buffer& out)
+      const noexcept -> bool;
+
+  /**
+   * @brief Converts to ISO 8601 format string without milliseconds
+   *
+   * @return std::string The DateTime in format "YYYY-MM-DDTHH:MM:SS"
+   *
+   * @see toISOStringMsec() for ISO format with milliseconds
+   */
+  [[nodiscard]] auto to_iso_string() const -> std::string;
+
+  /**
+   * @brief Converts to ISO 8601 format string with milliseconds
+   *
+   * @return std::string The DateTime in format "YYYY-MM-DDTHH:MM:SS.mmm"
+   *
+   * @see toISOString() for ISO format without milliseconds
+   */
+  [[nodiscard]] auto to_iso_string_msec() const -> std::string;
+
+  // Getters
+
+  /**
+   * @brief Gets the year component
+   *
+   * @return int64_t The year (e.g., 2023)
+   */
+  [[nodiscard]] constexpr auto year() const noexcept -> int64_t {
+    return civil_fields().year;
+  }
+
+  /**
+   * @brief Gets the month component
+   *
+   * @return unsigned The month (1-12, where 1 = January)
+   */
+  [[nodiscard]] constexpr auto month() const noexcept -> unsigned {
+    return civil_fields().month;
+  }
+
+  /**
+   * @brief Gets the day of month component
+   *
+   * @return unsigned The day (1-31)
+   */
+  [[nodiscard]] constexpr auto day() const noexcept -> unsigned {
+    return civil_fields().day;
+  }
+
+  /**
+   * @brief Gets the hour component
+   *
+   * @return unsigned The hour (0-23)
+   */
+  [[nodiscard]] constexpr auto hour() const noexcept -> unsigned {
+    return time_of_day() / 3600000U;
+  }
+
+  /**
+   * @brief Gets the minute component
+   *
+   * @return unsigned The minute (0-59)
+   */
+  [[nodiscard]] constexpr auto minute() const noexcept -> unsigned {
+    return time_of_day() / 60000U % 60U;
+  }
+
+  /**
+   * @brief Gets the second component
+   *
+   * @return unsigned The second (0-59)
+   */
+  [[nodiscard]] constexpr auto second() const noexcept -> unsigned {
+    return time_of_day() / 1000U % 60U;
+  }
+
+  /**
+   * @brief Gets the millisecond component
+   *
+   * @return unsigned The millisecond (0-999)
+   */
+  [[nodiscard]] constexpr auto millisecond() const noexcept -> unsigned {
+    return time_of_day() % 1000U;
+  }
+
+  /**
+   * @brief Gets the fraction of the second in microseconds
+   *
+   * @return unsigned The microseconds since the start of the second
+   * (0-999999), which includes the milliseconds
+   */
+  [[nodiscard]] constexpr auto microsecond() const noexcept -> unsigned {
+    const auto time_point = sys_time();
+    return static_cast<unsigned>(
+        std::chrono::duration_cast<std::chrono::microseconds>(
+            time_point - std::chrono::floor<std::chrono::seconds>(time_point))
+            .count());
+  }
+
+  /**
+   * @brief Gets all date and time components at once
+   *
+   * The calendar date and the time of day are each computed once, which is
+   * cheaper than calling the individual getters when several components are
+   * needed.
+   *
+   * @return CalendarMath::s_Fields The year, month, day, hour, minute,
+   * second and millisecond components
+   */
+  [[nodiscard]] constexpr auto to_fields() const noexcept
+      -> CalendarMath::s_Fields {
+    return to_format_fields(sys_time());
+  }
+
+  /**
+   * @brief Gets the Julian Day Number (JDN) for this date.
+   *
+   * The Julian Day Number is the integer number of days that have elapsed
+   * since the beginning of the Julian Period on January 1, 4713 BCE
+   * (proleptic Julian calendar) which corresponds to November 24, 4714 BCE
+   * in the proleptic Gregorian calendar.
+   *
+   * @return int64_t The Julian Day Number (integer days since JD epoch)
+   */
+  [[nodiscard]] constexpr auto julianDayNumber() const noexcept -> int64_t {
+#ifdef FDATE_CALENDAR_TABLE
+    if (const int64_t days =
+            std::chrono::floor<t_days>(sys_time()).time_since_epoch().count();
+        CalendarTable::contains(days)) {
+      return CalendarTable::julian_day_number(days);
+    }
+#endif
+    return julian_day_number(civil_fields());
+  }
+
+  /**
+   * @brief Gets the Julian Day (JD) with fractional day for this date and time
+   *
+   * The Julian Day is the continuous count of days since the beginning of
+   * the Julian Period, including the fractional part representing the time
+   * of day. Julian Day 0.0 begins at noon (12:00 UTC) on January 1, 4713 BCE.
+   *
+   * @return double The Julian Day with fractional part (days.fraction since JD
+   * epoch)
+   */
+  [[nodiscard]] constexpr auto julianDay() const noexcept -> double {
+    return CalendarMath::julian_day(to_fields());
+  }
+
+  /**
+   *  @brief Computes the Julian century (JC) for this DateTime
+   *
+   *  The Julian century is a time unit used in astronomy, defined as
+   *  100 Julian years, where one Julian year is exactly 365.25 days.
+   *  It is used to measure time intervals in astronomical calculations.
+   */
+  [[nodiscard]] constexpr auto julianCentury() const noexcept -> double {
+    return CalendarMath::julian_century(julianDay());
+  }
+
+  /**
+   * @brief Gets the internal time_point representation
+   *
+   * @return time_point A std::chrono::time_point on the system clock with the
+   * precision of the DateTime
+   */
+  [[nodiscard]] constexpr auto get_time_point() const noexcept -> t_time_point {
+    return sys_time();
+  }
+
+  // TimeDelta operations
+
+  /**
+   * @brief Adds a TimeDelta to this DateTime
+   *
+   * @param span The TimeDelta to add
+   * @return DateTime A new DateTime representing this time plus the span
+   *
+   * @see operator-(const TimeDelta&) for subtraction
+   */
+  constexpr auto operator+(const t_time_delta& span) const noexcept
+      -> BasicDateTime {
+    return BasicDateTime(sys_time() + span.duration());
+  }
+
+  /**
+   * @brief Subtracts a TimeDelta from this DateTime
+   *
+   * @param span The TimeDelta to subtract
+   * @return DateTime A new DateTime representing this time minus the span
+   *
+   * @see operator+(const TimeDelta&) for addition
+   */
+  constexpr auto operator-(const t_time_delta& span) const noexcept
+      -> BasicDateTime {
+    return BasicDateTime(sys_time() - span.duration());
+  }
+
+  /**
+   * @brief Calculates the time difference between two DateTimes
+   *
+   * @param other The DateTime to subtract from this one
+   * @return TimeDelta The time difference (this - other)
+   *
+   * @note If other is later than this DateTime, the result will be negative
+   */
+  constexpr auto operator-(const BasicDateTime& other) const noexcept
+      -> t_time_delta {
+    return t_time_delta::fromDuration(sys_time() - other.sys_time());
+  }
+
+  // Rounding
+
+  /**
+   * @brief Rounds down to a whole number of intervals
+   *
+   * @param interval The interval, e.g. TimeDelta(0, 1) for hourly bins
+   * @param origin The time the intervals are counted from (default: the
+   * epoch, 1970-01-01 for DateTime)
+   * @return DateTime The latest multiple of interval after origin that is
+   * not later than this DateTime. Invalid if this DateTime or origin is
+   * invalid or interval is not positive.
+   *
+   * @see floor_to_month() for calendar months and years
+   */
+  [[nodiscard]] constexpr auto floor(
+      const t_time_delta& interval,
+      const BasicDateTime& origin = BasicDateTime()) const noexcept
+      -> BasicDateTime {
+    const auto step = t_wide_duration(interval.duration()).count();
+    if (!valid() || !origin.valid() || step <= 0) {
+      return from_count(INVALID_COUNT);
+    }
+    const auto offset = (sys_time() - origin.sys_time()).count();
+    return BasicDateTime(origin.sys_time() +
+                         t_wide_duration(floor_multiple(offset, step)));
+  }
+
+  /**
+   * @brief Rounds up to a whole number of intervals
+   *
+   * @param interval The interval
+   * @param origin The time the intervals are counted from (default: the
+   * epoch)
+   * @return DateTime The earliest multiple of interval after origin that is
+   * not earlier than this DateTime, or an invalid DateTime as for floor()
+   */
+  [[nodiscard]] constexpr auto ceil(
+      const t_time_delta& interval,
+      const BasicDateTime& origin = BasicDateTime()) const noexcept
+      -> BasicDateTime {
+    const auto lower = floor(interval, origin);
+    return lower.valid() && lower < *this ? lower + interval : lower;
+  }
+
+  /**
+   * @brief Rounds to the nearest whole number of intervals
+   *
+   * @param interval The interval
+   * @param origin The time the intervals are counted from (default: the
+   * epoch)
+   * @return DateTime The nearest multiple of interval after origin, the later
+   * one when this DateTime is halfway between two, or an invalid DateTime as
+   * for floor()
+   */
+  [[nodiscard]] constexpr auto round(
+      const t_time_delta& interval,
+      const BasicDateTime& origin = BasicDateTime()) const noexcept
+      -> BasicDateTime {
+    const auto lower = floor(interval, origin);
+    if (!lower.valid()) {
+      return lower;
+    }
+    const auto step = t_wide_duration(interval.duration()).count();
+    const auto remainder = (sys_time() - lower.sys_time()).count();
+    return remainder >= step - step / 2 ? lower + interval : lower;
+  }
+
+  /**
+   * @brief Rounds down to the start of a calendar month
+   *
+   * Months are counted from January of year 0, so 3 gives the start of the
+   * quarter and 12 the start of the year.
+   *
+   * @param months Number of months per bin (default: 1)
+   * @return DateTime Midnight on the first day of the bin, or an invalid
+   * DateTime if this DateTime is invalid or months is 0
+   */
+  [[nodiscard]] constexpr auto floor_to_month(
+      const unsigned months = 1) const noexcept -> BasicDateTime {
+    if (!valid() || months == 0) {
+      return from_count(INVALID_COUNT);
+    }
+    return month_start(floor_multiple(month_index(), int64_t{months}));
+  }
+
+  /**
+   * @brief Rounds up to the start of a calendar month
+   *
+   * @param months Number of months per bin (default: 1)
+   * @return DateTime The start of the next bin, or this DateTime if it is
+   * already the start of a bin. Invalid as for floor_to_month().
+   */
+  [[nodiscard]] constexpr auto ceil_to_month(
+      const unsigned months = 1) const noexcept -> BasicDateTime {
+    const auto lower = floor_to_month(months);
+    if (!lower.valid() || !(lower < *this)) {
+      return lower;
+    }
+    return month_start(lower.month_index() + months);
+  }
+
+  // Comparison operators
+
+  /**
+   * @brief Equality comparison operator
+   *
+   * @param other The DateTime to compare with
+   * @return bool True if both DateTimes represent the exact same point in time
+   */
+  constexpr auto operator==(const BasicDateTime& other) const noexcept -> bool {
+    return m_since_epoch == other.m_since_epoch;
+  }
+
+  /**
+   * @brief Less than comparison operator
+   *
+   * @param other The DateTime to compare with
+   * @return bool True if this DateTime is earlier than other
+   */
+  constexpr auto operator<(const BasicDateTime& other) const noexcept -> bool {
+    return m_since_epoch < other.m_since_epoch;
+  }
+
+  /**
+   * @brief Greater than comparison operator
+   *
+   * @param other The DateTime to compare with
+   * @return bool True if this DateTime is later than other
+   */
+  constexpr auto operator>(const BasicDateTime& other) const noexcept -> bool {
+    return m_since_epoch > other.m_since_epoch;
+  }
+
+  /**
+   * @brief Less than or equal comparison operator
+   *
+   * @param other The DateTime to compare with
+   * @return bool True if this DateTime is earlier than or equal to other
+   */
+  constexpr auto operator<=(const BasicDateTime& other) const noexcept -> bool {
+    return m_since_epoch <= other.m_since_epoch;
+  }
+
+  /**
+   * @brief Greater than or equal comparison operator
+   *
+   * @param other The DateTime to compare with
+   * @return bool True if this DateTime is later than or equal to other
+   */
+  constexpr auto operator>=(const BasicDateTime& other) const noexcept -> bool {
+    return m_since_epoch >= other.m_since_epoch;
+  }
+
+  /**
+   * @brief Stream insertion operator for easy printing
+   *
+   * @param output_stream The output stream to write to
+   * @param date_time The DateTime to output
+   * @return std::ostream& Reference to the output stream for chaining
+   */
+  friend auto operator<<(std::ostream& output_stream,
+                         const BasicDateTime& date_time) -> std::ostream& {
+    return output_stream << date_time.strftime();
+  }
+
+  /**
+   * @brief Creates a DateTime representing the current system time
+   *
+   * @return DateTime A new DateTime object set to the current system time with
+   * millisecond precision
+   *
+   * @note Uses std::chrono::system_clock::now() internally
+   */
+  [[nodiscard]] static auto now() -> BasicDateTime {
+    return BasicDateTime(std::chrono::system_clock::now());
+  }
+
+  /**
+   * @brief Checks if the DateTime is valid (its count is not INVALID_COUNT)
+   *
+   * @return bool True if the DateTime is valid, false otherwise
+   */
+  [[nodiscard]] constexpr auto valid() const noexcept -> bool {
+    return m_since_epoch.count() != INVALID_COUNT;
+  }
+};
+
+/** @brief Millisecond DateTime on the Unix epoch, used by the C interface */
+using DateTime = BasicDateTime<std::chrono::milliseconds>;
+
+/** @brief DateTime of whole seconds since 2000 in 32 bits (1932 to 2068) */
+using CompactDateTime = BasicDateTime<std::chrono::duration<int32_t>, 2000>;
+
+/** @brief Microsecond DateTime on the Unix epoch */
+using PreciseDateTime = BasicDateTime<std::chrono::microseconds>;
@@ -0,0 +1,919 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "CalendarMath.hpp"
+
+/**
+ * @brief A strftime-style format string compiled into a list of instructions
+ *
+ * The DateTimeFormat class reads a format string once and stores it as a small
+ * list of field and literal instructions. Parsing and formatting with a
+ * compiled format then only walks that list, which avoids re-reading the
+ * format string and setting up a stream for every call.
+ *
+ * The specifiers handled directly are %Y, %m, %d, %H, %M, %S, %F (%Y-%m-%d),
+ * %T (%H:%M:%S), %R (%H:%M) and %%. Formats using any other specifier are
+ * still accepted, but DateTime falls back to the stream based implementation
+ * for them, so the results are always the same as using the format string.
+ *
+ * @note The special format "auto" selects automatic format detection when
+ * used for parsing
+ * @see DateTime::strptime(const std::string&, const DateTimeFormat&)
+ * @see DateTime::strftime(const DateTimeFormat&)
+ */
+class DateTimeFormat {
+  template <typename Spec, bool Milliseconds>
+  friend class FixedDateTimeFormat;
+
+ public:
+  /** @brief Calendar and clock fields of a date and time */
+  using s_Fields = CalendarMath::s_Fields;
+
+ private:
+  /** @brief Kinds of instruction a format is compiled into */
+  enum class e_Instruction : uint8_t {
+    LITERAL,
+    YEAR,
+    MONTH,
+    DAY,
+    HOUR,
+    MINUTE,
+    SECOND
+  };
+
+  /** @brief A single compiled instruction */
+  struct s_Instruction {
+    e_Instruction type;  ///< The field or literal to read or write
+    uint32_t offset;     ///< Offset of a literal in m_literals
+    uint32_t length;     ///< Length of a literal in m_literals
+  };
+
+  /** @brief The original format string */
+  std::string m_pattern;
+
+  /** @brief Storage for all literal characters of the format */
+  std::string m_literals;
+
+  /** @brief The compiled instruction list */
+  std::vector<s_Instruction> m_instructions;
+
+  /** @brief True if all specifiers in the format are handled directly */
+  bool m_compiled;
+
+  /** @brief True if the compiled format can be used for parsing */
+  bool m_parseable;
+
+  /** @brief True if this is the "auto" detection format */
+  bool m_auto;
+
+  /**
+   * @brief Bounded writer into a caller provided character buffer
+   *
+   * Characters beyond the capacity of the buffer are counted but not stored,
+   * so the size is always the full length of the output, as with snprintf.
+   */
+  struct s_Writer {
+    char* out;        ///< Destination buffer (may be nullptr if capacity is 0)
+    size_t capacity;  ///< Size of the destination buffer
+    size_t size;      ///< Number of characters produced so far
+
+    /**
+     * @brief Writes a single character
+     * @param character The character to write
+     */
+    void put(const char character) noexcept {
+      if (size + 1 < capacity) {
+        out[size] = character;
+      }
+      ++size;
+    }
+
+    /**
+     * @brief Writes a sequence of characters
+     * @param characters The characters to write
+     * @param length The number of characters to write
+     */
+    void put(const char* characters, const size_t length) noexcept {
+      for (size_t i = 0; i < length; ++i) {
+        put(characters[i]);
+      }
+    }
+
+    /**
+     * @brief Writes a zero padded decimal value
+     * @param value The value to write
+     * @param width The minimum number of digits to write
+     */
+    void put_number(const unsigned value, const size_t width) noexcept {
+      std::array<char, 16> digits{};
+      const auto result =
+          std::to_chars(digits.data(), digits.data() + digits.size(), value);
+      const auto length = static_cast<size_t>(result.ptr - digits.data());
+      for (size_t i = length; i < width; ++i) {
+        put('0');
+      }
+      put(digits.data(), length);
+    }
+
+    /**
+     * @brief Null terminates the buffer after the last stored character
+     */
+    void finish() const noexcept {
+      if (capacity > 0) {
+        out[std::min(size, capacity - 1)] = '\0';
+      }
+    }
+  };
+
+  /**
+   * @brief Walks a format string, reporting literals and fields
+   *
+   * @param pattern The format string
+   * @param length The length of the format string
+   * @param on_literal Called with each literal character
+   * @param on_field Called with each field instruction
+   * @return bool True if every specifier in the format is handled directly
+   */
+  template <typename LiteralFunction, typename FieldFunction>
+  static constexpr auto visit_pattern(const char* pattern,
+                                      const size_t length,
+                                      LiteralFunction&& on_literal,
+                                      FieldFunction&& on_field) -> bool {
+    for (size_t i = 0; i < length; ++i) {
+      if (pattern[i] != '%') {
+        on_literal(pattern[i]);
+        continue;
+      }
+
+      if (++i == length) {
+        return false;
+      }
+
+      switch (pattern[i]) {
+        case 'Y':
+          on_field(e_Instruction::YEAR);
+          break;
+        case 'm':
+          on_field(e_Instruction::MONTH);
+          break;
+        case 'd':
+          on_field(e_Instruction::DAY);
+          break;
+        case 'H':
+          on_field(e_Instruction::HOUR);
+          break;
+        case 'M':
+          on_field(e_Instruction::MINUTE);
+          break;
+        case 'S':
+          on_field(e_Instruction::SECOND);
+          break;
+        case 'F':
+          on_field(e_Instruction::YEAR);
+          on_literal('-');
+          on_field(e_Instruction::MONTH);
+          on_literal('-');
+          on_field(e_Instruction::DAY);
+          break;
+        case 'T':
+          on_field(e_Instruction::HOUR);
+          on_literal(':');
+          on_field(e_Instruction::MINUTE);
+          on_literal(':');
+          on_field(e_Instruction::SECOND);
+          break;
+        case 'R':
+          on_field(e_Instruction::HOUR);
+          on_literal(':');
+          on_field(e_Instruction::MINUTE);
+          break;
+        case '%':
+          on_literal('%');
+          break;
+        default:
+          return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Appends a literal character to the instruction list
+   *
+   * Consecutive literal characters are merged into a single instruction.
+   *
+   * @param character The literal character
+   */
+  void add_literal(const char character) {
+    if (m_instructions.empty() ||
+        m_instructions.back().type != e_Instruction::LITERAL) {
+      m_instructions.push_back({e_Instruction::LITERAL,
+                                static_cast<uint32_t>(m_literals.size()), 0});
+    }
+    m_literals.push_back(character);
+    m_instructions.back().length++;
+  }
+
+  /**
+   * @brief Appends a field to the instruction list
+   *
+   * @param type The field type
+   */
+  void add_field(const e_Instruction type) {
+    m_instructions.push_back({type, 0, 0});
+  }
+
+  /**
+   * @brief Compiles the format string into the instruction list
+   */
+  void compile() {
+    m_compiled = visit_pattern(
+        m_pattern.data(), m_pattern.size(),
+        [this](const char character) { add_literal(character); },
+        [this](const e_Instruction type) { add_field(type); });
+    if (!m_compiled) {
+      return;
+    }
+
+    // Parsing directly requires a complete date with no repeated fields
+    std::array<int, 7> field_count{};
+    for (const auto& instruction : m_instructions) {
+      field_count[static_cast<size_t>(instruction.type)]++;
+    }
+    m_parseable = true;
+    for (size_t i = 1; i < field_count.size(); ++i) {
+      const auto type = static_cast<e_Instruction>(i);
+      const bool required = type == e_Instruction::YEAR ||
+                            type == e_Instruction::MONTH ||
+                            type == e_Instruction::DAY;
+      if (field_count[i] > 1 || (required && field_count[i] == 0)) {
+        m_parseable = false;
+      }
+    }
+  }
+
+  /**
+   * @brief Writes a single field
+   *
+   * @param writer The destination
+   * @param type The field to write
+   * @param fields The field values
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   */
+  static void write_field(s_Writer& writer, const e_Instruction type,
+                          const s_Fields& fields,
+                          const bool milliseconds) noexcept {
+    switch (type) {
+      case e_Instruction::LITERAL:
+        break;
+      case e_Instruction::YEAR:
+        writer.put_number(static_cast<unsigned>(fields.year), 4);
+        break;
+      case e_Instruction::MONTH:
+        writer.put_number(fields.month, 2);
+        break;
+      case e_Instruction::DAY:
+        writer.put_number(fields.day, 2);
+        break;
+      case e_Instruction::HOUR:
+        writer.put_number(fields.hour, 2);
+        break;
+      case e_Instruction::MINUTE:
+        writer.put_number(fields.minute, 2);
+        break;
+      case e_Instruction::SECOND:
+        writer.put_number(fields.second, 2);
+        if (milliseconds) {
+          writer.put('.');
+          writer.put_number(fields.millisecond, 3);
+        }
+        break;
+    }
+  }
+
+  /**
+   * @brief Writes a fixed number of decimal digits without bounds checks
+   *
+   * @param out The destination, which must have room for n_digits characters
+   * @param value The value to write
+   * @param n_digits The number of digits to write
+   */
+  static constexpr void fill_digits(char* out, unsigned value,
+                                    const size_t n_digits) noexcept {
+    for (size_t i = n_digits; i > 0; --i) {
+      out[i - 1] = static_cast<char>('0' + value % 10U);
+      value /= 10U;
+    }
+  }
+
+  /** @brief Output length and field count of a format fixed at compile time */
+  struct s_FixedShape {
+    size_t length;  ///< Number of characters written
+    size_t fields;  ///< Number of fields written
+    bool handled;   ///< True if every specifier is handled directly
+  };
+
+  /** @brief A field of a fixed format and the offset of its first digit */
+  struct s_FixedField {
+    e_Instruction type;  ///< The field to write
+    size_t offset;       ///< Offset of the field in the output
+  };
+
+  /**
+   * @brief Gets the number of characters written for a field
+   *
+   * @param type The field
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   * @return size_t The width of the field
+   */
+  static constexpr auto field_width(const e_Instruction type,
+                                    const bool milliseconds) noexcept
+      -> size_t {
+    if (type == e_Instruction::YEAR) {
+      return 4;
+    }
+    if (type == e_Instruction::SECOND && milliseconds) {
+      return 6;
+    }
+    return 2;
+  }
+
+  /**
+   * @brief Measures the output of a format string at compile time
+   *
+   * @param pattern The format string
+   * @param length The length of the format string
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   * @return s_FixedShape The length and number of fields of the output
+   */
+  static constexpr auto fixed_shape(const char* pattern, const size_t length,
+                                    const bool milliseconds) noexcept
+      -> s_FixedShape {
+    s_FixedShape shape{0, 0, false};
+    shape.handled = visit_pattern(
+        pattern, length, [&shape](const char) { ++shape.length; },
+        [&shape, milliseconds](const e_Instruction type) {
+          shape.length += field_width(type, milliseconds);
+          ++shape.fields;
+        });
+    return shape;
+  }
+
+  /**
+   * @brief Lays out the literal characters of a fixed format
+   *
+   * @tparam Length The length of the output
+   * @param pattern The format string
+   * @param length The length of the format string
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   * @return std::array<char, Length> The literals at their offsets, with
+   * zeros for the digits of the fields
+   */
+  template <size_t Length>
+  static constexpr auto fixed_literals(const char* pattern,
+                                       const size_t length,
+                                       const bool milliseconds) noexcept
+      -> std::array<char, Length> {
+    std::array<char, Length> out{};
+    size_t offset = 0;
+    visit_pattern(
+        pattern, length,
+        [&out, &offset](const char character) { out[offset++] = character; },
+        [&out, &offset, milliseconds](const e_Instruction type) {
+          const auto width = field_width(type, milliseconds);
+          for (size_t i = 0; i < width; ++i) {
+            out[offset + i] = '0';
+          }
+          if (type == e_Instruction::SECOND && milliseconds) {
+            out[offset + 2] = '.';
+          }
+          offset += width;
+        });
+    return out;
+  }
+
+  /**
+   * @brief Lists the fields of a fixed format with their offsets
+   *
+   * @tparam Count The number of fields
+   * @param pattern The format string
+   * @param length The length of the format string
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   * @return std::array<s_FixedField, Count> The fields in order
+   */
+  template <size_t Count>
+  static constexpr auto fixed_fields(const char* pattern, const size_t length,
+                                     const bool milliseconds) noexcept
+      -> std::array<s_FixedField, Count> {
+    std::array<s_FixedField, Count> fields{};
+    size_t offset = 0;
+    size_t index = 0;
+    visit_pattern(
+        pattern, length, [&offset](const char) { ++offset; },
+        [&fields, &offset, &index, milliseconds](const e_Instruction type) {
+          fields[index++] = {type, offset};
+          offset += field_width(type, milliseconds);
+        });
+    return fields;
+  }
+
+  /**
+   * @brief Gets the value of a clock or calendar field
+   *
+   * @param fields The field values
+   * @param type The field, which must not be LITERAL
+   * @return unsigned The value of the field
+   */
+  static constexpr auto field_value(const s_Fields& fields,
+                                    const e_Instruction type) noexcept
+      -> unsigned {
+    switch (type) {
+      case e_Instruction::YEAR:
+        return static_cast<unsigned>(fields.year);
+      case e_Instruction::MONTH:
+        return fields.month;
+      case e_Instruction::DAY:
+        return fields.day;
+      case e_Instruction::HOUR:
+        return fields.hour;
+      case e_Instruction::MINUTE:
+        return fields.minute;
+      default:
+        return fields.second;
+    }
+  }
+
+ public:
+  /**
+   * @brief Compiles a strftime-style format string
+   *
+   * @param pattern The format string (e.g., "%Y-%m-%d %H:%M:%S"), or "auto"
+   * for automatic format detection when parsing
+   */
+  explicit DateTimeFormat(std::string pattern)
+      : m_pattern(std::move(pattern)),
+        m_compiled(true),
+        m_parseable(false),
+        m_auto(m_pattern == "auto") {
+    if (!m_auto) {
+      compile();
+    }
+  }
+
+  /**
+   * @brief Gets the original format string
+   *
+   * @return const std::string& The format string this object was compiled
+   * from
+   */
+  [[nodiscard]] auto pattern() const noexcept -> const std::string& {
+    return m_pattern;
+  }
+
+  /**
+   * @brief Checks if this is the "auto" detection format
+   *
+   * @return bool True if parsing should use automatic format detection
+   */
+  [[nodiscard]] auto is_auto() const noexcept -> bool { return m_auto; }
+
+  /**
+   * @brief Checks if every specifier in the format is handled directly
+   *
+   * @return bool True if the format does not need the stream based fallback
+   * for formatting
+   */
+  [[nodiscard]] auto is_compiled() const noexcept -> bool {
+    return m_compiled && !m_auto;
+  }
+
+  /**
+   * @brief Reads a fixed number of decimal digits from a string
+   *
+   * Shared by the compiled format parser and the fixed-width layouts of
+   * DateTime::strptime().
+   *
+   * @param str The string to read from
+   * @param pos Position of the first digit, advanced past the digits on
+   * success
+   * @param n_digits Number of digits to read
+   * @param value The value of the digits
+   * @return bool True if all characters were decimal digits
+   */
+  static auto read_digits(const std::string_view str, size_t& pos,
+                          const size_t n_digits, unsigned& value) noexcept
+      -> bool {
+    if (pos + n_digits > str.size()) {
+      return false;
+    }
+    unsigned result = 0;
+    for (size_t i = 0; i < n_digits; ++i) {
+      const auto digit =
+          static_cast<unsigned>(static_cast<unsigned char>(str[pos + i])) -
+          static_cast<unsigned>('0');
+      if (digit > 9U) {
+        return false;
+      }
+      result = result * 10U + digit;
+    }
+    value = result;
+    pos += n_digits;
+    return true;
+  }
+
+  /**
+   * @brief Reads the fields of a fixed-width string using the compiled format
+   *
+   * Every field must be present with its full width (4 digits for the year, 2
+   * for the others) and every literal must match exactly. If the string has a
+   * '.' at position (length-4), a ".mmm" millisecond suffix is expected
+   * directly after the seconds field, matching DateTime::strptime().
+   *
+   * @param str The string to parse
+   * @param fields The fields read from the string. Fields that are not part
+   * of the format are set to zero. No range checking is performed.
+   * @return bool True if the string matched the format. False if the string
+   * should be handed to the stream based parser instead.
+   */
+  auto parse(const std::string_view str, s_Fields& fields) const noexcept
+      -> bool {
+    if (!m_compiled || !m_parseable || m_auto) {
+      return false;
+    }
+
+    const bool has_milliseconds =
+        str.size() >= 4 && str[str.size() - 4] == '.';
+
+    unsigned year = 0;
+    fields = s_Fields{0, 0, 0, 0, 0, 0, 0};
+
+    size_t pos = 0;
+    for (const auto& instruction : m_instructions) {
+      bool ok = true;
+      switch (instruction.type) {
+        case e_Instruction::LITERAL:
+          ok = str.compare(pos, instruction.length, m_literals,
+                           instruction.offset, instruction.length) == 0;
+          pos += instruction.length;
+          break;
+        case e_Instruction::YEAR:
+          ok = read_digits(str, pos, 4, year);
+          break;
+        case e_Instruction::MONTH:
+          ok = read_digits(str, pos, 2, fields.month);
+          break;
+        case e_Instruction::DAY:
+          ok = read_digits(str, pos, 2, fields.day);
+          break;
+        case e_Instruction::HOUR:
+          ok = read_digits(str, pos, 2, fields.hour);
+          break;
+        case e_Instruction::MINUTE:
+          ok = read_digits(str, pos, 2, fields.minute);
+          break;
+        case e_Instruction::SECOND:
+          ok = read_digits(str, pos, 2, fields.second);
+          if (ok && has_milliseconds) {
+            ok = pos < str.size() && str[pos] == '.';
+            ++pos;
+            ok = ok && read_digits(str, pos, 3, fields.millisecond);
+          }
+          break;
+      }
+      if (!ok || pos > str.size()) {
+        return false;
+      }
+    }
+
+    fields.year = static_cast<int>(year);
+    return pos == str.size();
+  }
+
+  /**
+   * @brief Gets the length of the output of the compiled format
+   *
+   * Every field written by the compiled format has a fixed width, so the
+   * output always has the same length for years in the range 0-9999.
+   *
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   * @return size_t The number of characters written by fill_fixed(), or 0 if
+   * the format is not compiled
+   */
+  [[nodiscard]] auto fixed_length(const bool milliseconds) const noexcept
+      -> size_t {
+    if (!is_compiled()) {
+      return 0;
+    }
+    size_t length = 0;
+    for (const auto& instruction : m_instructions) {
+      switch (instruction.type) {
+        case e_Instruction::LITERAL:
+          length += instruction.length;
+          break;
+        case e_Instruction::YEAR:
+          length += 4;
+          break;
+        case e_Instruction::SECOND:
+          length += milliseconds ? 6 : 2;
+          break;
+        default:
+          length += 2;
+          break;
+      }
+    }
+    return length;
+  }
+
+  /**
+   * @brief Writes fields using the compiled format without bounds checks
+   *
+   * Exactly fixed_length(milliseconds) characters are written and no null
+   * terminator is added. The digits are filled unconditionally, so the cost
+   * of each call only depends on the format.
+   *
+   * @param fields The fields to write. The year must be in the range 0-9999.
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   * @param out The destination, which must have room for
+   * fixed_length(milliseconds) characters
+   * @pre is_compiled() is true
+   */
+  void fill_fixed(const s_Fields& fields, const bool milliseconds,
+                  char* out) const noexcept {
+    for (const auto& instruction : m_instructions) {
+      switch (instruction.type) {
+        case e_Instruction::LITERAL:
+          std::copy_n(m_literals.data() + instruction.offset,
+                      instruction.length, out);
+          out += instruction.length;
+          break;
+        case e_Instruction::YEAR:
+          fill_digits(out, static_cast<unsigned>(fields.year), 4);
+          out += 4;
+          break;
+        case e_Instruction::MONTH:
+          fill_digits(out, fields.month, 2);
+          out += 2;
+          break;
+        case e_Instruction::DAY:
+          fill_digits(out, fields.day, 2);
+          out += 2;
+          break;
+        case e_Instruction::HOUR:
+          fill_digits(out, fields.hour, 2);
+          out += 2;
+          break;
+        case e_Instruction::MINUTE:
+          fill_digits(out, fields.minute, 2);
+          out += 2;
+          break;
+        case e_Instruction::SECOND:
+          fill_digits(out, fields.second, 2);
+          out += 2;
+          if (milliseconds) {
+            out[0] = '.';
+            fill_digits(out + 1, fields.millisecond, 3);
+            out += 4;
+          }
+          break;
+      }
+    }
+  }
+
+  /**
+   * @brief Checks if a year can be written by the direct formatter
+   *
+   * @param year The year
+   * @return bool True if the year is in the range 0-9999
+   */
+  static constexpr auto year_in_range(const int year) noexcept -> bool {
+    return year >= 0 && year <= 9999;
+  }
+
+  /**
+   * @brief Writes fields into a character buffer using the compiled format
+   *
+   * At most (capacity - 1) characters are stored, followed by a null
+   * terminator. No heap allocation is performed.
+   *
+   * @param fields The fields to write
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   * @param out The destination buffer (may be nullptr if capacity is 0)
+   * @param capacity The size of the destination buffer
+   * @param size The full length of the formatted result, which is larger than
+   * or equal to capacity if the output was truncated
+   * @return bool True if the fields were written. False if the format or the
+   * year (outside 0-9999) needs the stream based formatter instead.
+   */
+  auto format_to(const s_Fields& fields, const bool milliseconds, char* out,
+                 const size_t capacity, size_t& size) const noexcept -> bool {
+    if (!m_compiled || m_auto || !year_in_range(fields.year)) {
+      return false;
+    }
+
+    s_Writer writer{out, capacity, 0};
+    for (const auto& instruction : m_instructions) {
+      if (instruction.type == e_Instruction::LITERAL) {
+        writer.put(m_literals.data() + instruction.offset, instruction.length);
+      } else {
+        write_field(writer, instruction.type, fields, milliseconds);
+      }
+    }
+    writer.finish();
+    size = writer.size;
+    return true;
+  }
+
+  /**
+   * @brief Writes fields to a string using the compiled format
+   *
+   * @param fields The fields to write
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   * @param out The string the formatted result is appended to
+   * @return bool True if the fields were written. False if the format or the
+   * year (outside 0-9999) needs the stream based formatter instead.
+   */
+  auto format(const s_Fields& fields, const bool milliseconds,
+              std::string& out) const -> bool {
+    std::array<char, 64> buffer{};
+    size_t size = 0;
+    if (!format_to(fields, milliseconds, buffer.data(), buffer.size(), size)) {
+      return false;
+    }
+
+    if (size < buffer.size()) {
+      out.append(buffer.data(), size);
+    } else {
+      const auto start = out.size();
+      out.resize(start + size + 1);
+      format_to(fields, milliseconds, &out[start], size + 1, size);
+      out.resize(start + size);
+    }
+    return true;
+  }
+
+  /**
+   * @brief Writes fields into a character buffer using a format string
+   *
+   * The format string is interpreted directly, without compiling it, so no
+   * heap allocation is performed. At most (capacity - 1) characters are
+   * stored, followed by a null terminator.
+   *
+   * @param pattern The format string
+   * @param length The length of the format string
+   * @param fields The fields to write
+   * @param milliseconds If true, the seconds field is followed by ".mmm"
+   * @param out The destination buffer (may be nullptr if capacity is 0)
+   * @param capacity The size of the destination buffer
+   * @param size The full length of the formatted result, which is larger than
+   * or equal to capacity if the output was truncated
+   * @return bool True if the fields were written. False if the format or the
+   * year (outside 0-9999) needs the stream based formatter instead, in which
+   * case the contents of the buffer are unspecified.
+   */
+  static auto format_pattern_to(const char* pattern, const size_t length,
+                                const s_Fields& fields, const bool milliseconds,
+                                char* out, const size_t capacity,
+                                size_t& size) noexcept -> bool {
+    if (!year_in_range(fields.year) || (pattern == nullptr && length > 0)) {
+      return false;
+    }
+
+    s_Writer writer{out, capacity, 0};
+    const bool handled = visit_pattern(
+        pattern, length,
+        [&writer](const char character) { writer.put(character); },
+        [&](const e_Instruction type) {
+          write_field(writer, type, fields, milliseconds);
+        });
+    if (!handled) {
+      return false;
+    }
+    writer.finish();
+    size = writer.size;
+    return true;
+  }
+};
+
+/**
+ * @brief A format string fixed at compile time, written without any parsing
+ *
+ * FixedDateTimeFormat reads the format string of Spec while compiling, so
+ * the length of the output, the literal characters and the offset of every
+ * field are constants. Formatting copies the literals and fills the digits of
+ * each field at its offset in a std::array, with no heap allocation and no
+ * walk over the format. Spec is any type with a static constexpr character
+ * array PATTERN, such as FixedIso:
+ *
+ * @code
+ *   struct Stamp {
+ *     static constexpr char PATTERN[] = "%Y%m%d_%H%M";
+ *   };
+ *   FixedDateTimeFormat<Stamp>::t_buffer out{};
+ *   date.format<Stamp>(out);  // "20240315_1430"
+ * @endcode
+ *
+ * The format may only use the specifiers handled directly by DateTimeFormat,
+ * which is checked when it is compiled.
+ *
+ * @tparam Spec Type holding the format string as Spec::PATTERN
+ * @tparam Milliseconds If true, the seconds field is followed by ".mmm"
+ * @see DateTime::format()
+ */
+template <typename Spec, bool Milliseconds = false>
+class FixedDateTimeFormat {
+  /** @brief Length of Spec::PATTERN without its null terminator */
+  static constexpr size_t PATTERN_LENGTH = sizeof(Spec::PATTERN) - 1;
+
+  /** @brief Length and field count of the output */
+  static constexpr DateTimeFormat::s_FixedShape SHAPE =
+      DateTimeFormat::fixed_shape(Spec::PATTERN, PATTERN_LENGTH, Milliseconds);
+
+  static_assert(SHAPE.handled,
+                "FixedDateTimeFormat only handles %Y, %m, %d, %H, %M, %S, %F, "
+                "%T, %R and %%");
+
+ public:
+  /** @brief Number of characters written by format() */
+  static constexpr size_t LENGTH = SHAPE.length;
+
+  /** @brief Buffer holding exactly one formatted string, not terminated */
+  using t_buffer = std::array<char, LENGTH>;
+
+  /**
+   * @brief Gets the format string
+   * @return const char* Spec::PATTERN
+   */
+  static constexpr auto pattern() noexcept -> const char* {
+    return Spec::PATTERN;
+  }
+
+  /**
+   * @brief Writes fields using the fixed format
+   *
+   * @param fields The fields to write
+   * @param out Receives exactly LENGTH characters, with no null terminator
+   * @return bool True if the fields were written. False if the year is
+   * outside 0-9999 and does not fit the fixed width, in which case out is
+   * unchanged.
+   */
+  static constexpr auto format(const DateTimeFormat::s_Fields& fields,
+                               t_buffer& out) noexcept -> bool {
+    if (!DateTimeFormat::year_in_range(fields.year)) {
+      return false;
+    }
+    out = LITERALS;
+    for (const auto& field : FIELDS) {
+      const auto type = field.type;
+      DateTimeFormat::fill_digits(
+          out.data() + field.offset, DateTimeFormat::field_value(fields, type),
+          type == DateTimeFormat::e_Instruction::YEAR ? size_t{4} : size_t{2});
+      if (Milliseconds && type == DateTimeFormat::e_Instruction::SECOND) {
+        DateTimeFormat::fill_digits(out.data() + field.offset + 3,
+                                    fields.millisecond, 3);
+      }
+    }
+    return true;
+  }
+
+ private:
+  /** @brief The literal characters at their offsets */
+  static constexpr t_buffer LITERALS =
+      DateTimeFormat::fixed_literals<LENGTH>(Spec::PATTERN, PATTERN_LENGTH,
+                                             Milliseconds);
+
+  /** @brief The fields of the output in order */
+  static constexpr std::array<DateTimeFormat::s_FixedField, SHAPE.fields>
+      FIELDS = DateTimeFormat::fixed_fields<SHAPE.fields>(
+          Spec::PATTERN, PATTERN_LENGTH, Milliseconds);
+};
+
+/** @brief Spec of the ISO 8601 format used by DateTime::to_iso_string() */
+struct FixedIso {
+  static constexpr char PATTERN[] = "%Y-%m-%dT%H:%M:%S";
+};
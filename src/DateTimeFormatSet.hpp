@@ -0,0 +1,195 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "DateTimeFormat.hpp"
+
+/**
+ * @brief A registered set of compiled formats tried in an adaptive order
+ *
+ * Files of mixed provenance are parsed by trying a handful of formats on each
+ * string. The DateTimeFormatSet class compiles the candidate formats once and
+ * reorders them as strings are parsed, so a file written with a single format
+ * is parsed on the first try after its first string while a mixed file still
+ * parses every string. Three orders are supported:
+ * - FIXED tries the formats in the order they were added.
+ * - MOVE_TO_FRONT tries the last format that matched first.
+ * - HIT_COUNT tries the formats in order of how often they have matched. Of
+ *   formats with the same count, the one that reached it first is tried first.
+ *
+ * Formats are identified by the order they were added, from 0, whatever the
+ * current try order is. A set is not safe to parse from on several threads at
+ * once because every successful parse updates the order.
+ */
+class DateTimeFormatSet {
+ public:
+  /** @brief Orders in which the formats are tried */
+  enum class e_FormatOrder : uint8_t { FIXED, MOVE_TO_FRONT, HIT_COUNT };
+
+  /** @brief Index reported when no format matched */
+  static constexpr int NO_MATCH = -1;
+
+  /**
+   * @brief Creates an empty format set
+   *
+   * @param order The order in which the formats are tried
+   */
+  explicit DateTimeFormatSet(
+      const e_FormatOrder order = e_FormatOrder::MOVE_TO_FRONT) noexcept
+      : m_order(order) {}
+
+  /**
+   * @brief Compiles a format and adds it to the end of the try order
+   *
+   * @param pattern The strftime-style format string, or "auto"
+   * @return int The index of the format
+   */
+  auto add(std::string pattern) -> int {
+    const auto index = static_cast<int>(m_formats.size());
+    m_formats.emplace_back(std::move(pattern));
+    m_hits.push_back(0);
+    m_try_order.push_back(static_cast<size_t>(index));
+    return index;
+  }
+
+  /** @brief Gets the number of formats */
+  [[nodiscard]] auto size() const noexcept -> size_t {
+    return m_formats.size();
+  }
+
+  /** @brief Checks if the set holds no formats */
+  [[nodiscard]] auto empty() const noexcept -> bool {
+    return m_formats.empty();
+  }
+
+  /** @brief Gets the order in which the formats are tried */
+  [[nodiscard]] auto order() const noexcept -> e_FormatOrder { return m_order; }
+
+  /**
+   * @brief Gets one of the compiled formats
+   *
+   * @param index The index of the format, which must be less than size()
+   * @return const DateTimeFormat& The compiled format
+   */
+  [[nodiscard]] auto format(const size_t index) const noexcept
+      -> const DateTimeFormat& {
+    return m_formats[index];
+  }
+
+  /**
+   * @brief Gets the number of strings a format has parsed
+   *
+   * @param index The index of the format
+   * @return int64_t The number of successful parses, 0 if there is no such
+   * format
+   */
+  [[nodiscard]] auto hits(const size_t index) const noexcept -> int64_t {
+    return index < m_hits.size() ? m_hits[index] : 0;
+  }
+
+  /**
+   * @brief Gets the format that parsed the last string
+   *
+   * @return int The index of the format, or NO_MATCH if the last string was
+   * not parsed or nothing has been parsed yet
+   */
+  [[nodiscard]] auto last_match() const noexcept -> int {
+    return m_last_match;
+  }
+
+  /**
+   * @brief Parses a string with the first format in the try order that
+   * matches it
+   *
+   * @param str The string to parse, read in place
+   * @return DateTime The parsed DateTime, invalid if no format matched
+   */
+  auto parse(const std::string_view str) -> DateTime {
+    m_last_match = NO_MATCH;
+    for (size_t position = 0; position < m_try_order.size(); ++position) {
+      const auto index = m_try_order[position];
+      const auto date_time = DateTime::strptime(str, m_formats[index]);
+      if (date_time.valid()) {
+        m_last_match = static_cast<int>(index);
+        ++m_hits[index];
+        promote(position);
+        return date_time;
+      }
+    }
+    return DateTime(DateTime::INVALID_TIMESTAMP);
+  }
+
+  /**
+   * @brief Parses a string and reports which format matched
+   *
+   * @param str The string to parse, read in place
+   * @param matched The index of the format that parsed the string, or
+   * NO_MATCH
+   * @return DateTime The parsed DateTime, invalid if no format matched
+   */
+  auto parse(const std::string_view str, int& matched) -> DateTime {
+    const auto date_time = parse(str);
+    matched = m_last_match;
+    return date_time;
+  }
+
+ private:
+  /**
+   * @brief Moves the format that just matched forward in the try order
+   *
+   * @param position The position of the format in the try order
+   */
+  void promote(const size_t position) noexcept {
+    const auto first = m_try_order.begin();
+    switch (m_order) {
+      case e_FormatOrder::FIXED:
+        break;
+      case e_FormatOrder::MOVE_TO_FRONT: {
+        const auto it = first + static_cast<std::ptrdiff_t>(position);
+        std::rotate(first, it, it + 1);
+        break;
+      }
+      case e_FormatOrder::HIT_COUNT: {
+        // Only the format that matched has changed, so a single pass of
+        // insertion keeps the order sorted by hits
+        auto current = position;
+        const auto hits = m_hits[m_try_order[current]];
+        while (current > 0 && m_hits[m_try_order[current - 1]] < hits) {
+          std::swap(m_try_order[current - 1], m_try_order[current]);
+          --current;
+        }
+        break;
+      }
+    }
+  }
+
+  e_FormatOrder m_order;
+  std::vector<DateTimeFormat> m_formats;
+  std::vector<int64_t> m_hits;
+  std::vector<size_t> m_try_order;
+  int m_last_match{NO_MATCH};
+};
@@ -0,0 +1,472 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "DateTimeCore.hpp"
+#include "DateTimeFormat.hpp"
+#include "FDateStats.hpp"
+#include "date_hh.h"
+
+// Parsing and formatting members of BasicDateTime. They are declared in
+// DateTimeCore.hpp and defined here, away from the arithmetic, because they
+// need <sstream> and the Howard Hinnant date library. DateTime.hpp includes
+// both headers.
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::read_separator(
+    const std::string_view str, size_t& pos,
+    const char separator) noexcept -> bool {
+  if (separator == '\0') {
+    return true;
+  }
+  if (pos >= str.size() || str[pos] != separator) {
+    return false;
+  }
+  ++pos;
+  return true;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::parse_fixed_width(
+    const std::string_view str, const s_FixedWidthLayout& layout,
+    BasicDateTime& result) noexcept -> bool {
+  const bool has_milliseconds = layout.has_seconds && !layout.trailing_z &&
+                                str.size() >= 4 &&
+                                str[str.size() - 4] == '.';
+
+  unsigned year = 0;
+  unsigned month = 0;
+  unsigned day = 0;
+  unsigned hour = 0;
+  unsigned minute = 0;
+  unsigned second = 0;
+  unsigned millisecond = 0;
+
+  size_t pos = 0;
+  if (!DateTimeFormat::read_digits(str, pos, 4, year) ||
+      !read_separator(str, pos, layout.date_separator) ||
+      !DateTimeFormat::read_digits(str, pos, 2, month) ||
+      !read_separator(str, pos, layout.date_separator) ||
+      !DateTimeFormat::read_digits(str, pos, 2, day)) {
+    return false;
+  }
+
+  if (layout.has_time &&
+      (!read_separator(str, pos, layout.date_time_separator) ||
+       !DateTimeFormat::read_digits(str, pos, 2, hour) ||
+       !read_separator(str, pos, layout.time_separator) ||
+       !DateTimeFormat::read_digits(str, pos, 2, minute))) {
+    return false;
+  }
+
+  if (layout.has_seconds &&
+      (!read_separator(str, pos, layout.time_separator) ||
+       !DateTimeFormat::read_digits(str, pos, 2, second))) {
+    return false;
+  }
+
+  if (has_milliseconds &&
+      (!read_separator(str, pos, '.') ||
+       !DateTimeFormat::read_digits(str, pos, 3, millisecond))) {
+    return false;
+  }
+
+  if (layout.trailing_z && !read_separator(str, pos, 'Z')) {
+    return false;
+  }
+
+  if (pos != str.size()) {
+    return false;
+  }
+
+  const auto ymd = date::year{static_cast<int>(year)} / date::month{month} /
+                   date::day{day};
+  if (!ymd.ok() || hour > static_cast<unsigned>(DATETIME_MAX_HOURS) ||
+      minute > static_cast<unsigned>(DATETIME_MAX_MINUTES) ||
+      second > static_cast<unsigned>(DATETIME_MAX_SECONDS)) {
+    result = from_count(INVALID_COUNT);
+    return true;
+  }
+
+  result = BasicDateTime(date::sys_days{ymd} + std::chrono::hours{hour} +
+                         std::chrono::minutes{minute} +
+                         std::chrono::seconds{second} +
+                         std::chrono::milliseconds{millisecond});
+  return true;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::classify_auto_format(
+    const std::string_view str) noexcept -> int {
+  // A ".mmm" suffix is only accepted after a seconds field
+  const bool has_milliseconds =
+      str.size() >= 4 && str[str.size() - 4] == '.';
+  const auto length = has_milliseconds ? str.size() - 4 : str.size();
+
+  switch (length) {
+    case 8:  // 20231201
+      return has_milliseconds ? -1 : 10;
+    case 10:  // 2023-12-01, 2023/12/01, 2023.12.01
+      if (has_milliseconds || str[7] != str[4]) {
+        return -1;
+      }
+      switch (str[4]) {
+        case '-':
+          return 7;
+        case '/':
+          return 8;
+        case '.':
+          return 9;
+        default:
+          return -1;
+      }
+    case 14:  // 20231201143025
+      return 5;
+    case 16:  // 2023/12/01 14:30
+      return !has_milliseconds && str[4] == '/' ? 6 : -1;
+    case 19:  // 2023-12-01 14:30:25, 2023-12-01T14:30:25, ...
+      if (str[4] == '-') {
+        if (str[10] == ' ') {
+          return 0;
+        }
+        return str[10] == 'T' ? 2 : -1;
+      }
+      if (str[4] == '/') {
+        return 3;
+      }
+      return str[4] == '.' ? 4 : -1;
+    case 20:  // 2023-12-01T14:30:25Z
+      return !has_milliseconds && str[19] == 'Z' ? 1 : -1;
+    default:
+      return -1;
+  }
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::stream_strftime(
+    const std::string& fmt, const bool milliseconds) const -> std::string {
+  std::ostringstream oss;
+  if (milliseconds) {
+    auto tp_ms = date::floor<std::chrono::milliseconds>(sys_time());
+    date::to_stream(oss, fmt.c_str(), tp_ms);
+  } else {
+    auto tp_sec =
+        std::chrono::time_point_cast<std::chrono::seconds>(sys_time());
+    date::to_stream(oss, fmt.c_str(), tp_sec);
+  }
+  return oss.str();
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::format_string(
+    const std::string& fmt, const bool milliseconds) const -> std::string {
+  std::array<char, DATETIME_FORMAT_BUFFER_SIZE> buffer{};
+  if (size_t size = 0; DateTimeFormat::format_pattern_to(
+          fmt.data(), fmt.size(), format_fields(milliseconds), milliseconds,
+          buffer.data(), buffer.size(), size) &&
+      size < buffer.size()) {
+    return {buffer.data(), size};
+  }
+  return stream_strftime(fmt, milliseconds);
+}
+
+template <typename Duration, int EpochYear>
+template <bool Milliseconds>
+auto BasicDateTime<Duration, EpochYear>::iso_string() const -> std::string {
+  auto stats = FDateStats::Scope::format();
+  typename FixedDateTimeFormat<FixedIso, Milliseconds>::t_buffer buffer;
+  auto out = format<FixedIso, Milliseconds>(buffer)
+                 ? std::string(buffer.data(), buffer.size())
+                 : stream_strftime(FixedIso::PATTERN, Milliseconds);
+  stats.formatted(1, out.size());
+  return out;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::copy_to(
+    const std::string& str, char* out,
+    const size_t capacity) noexcept -> size_t {
+  if (capacity > 0) {
+    const auto length = std::min(str.size(), capacity - 1);
+    std::copy_n(str.data(), length, out);
+    out[length] = '\0';
+  }
+  return str.size();
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::parse_string(
+    const std::string_view str,
+    const std::string_view format) -> BasicDateTime {
+  for (const auto& layout : FIXED_WIDTH_LAYOUTS) {
+    if (format == layout.format) {
+      if (BasicDateTime result; parse_fixed_width(str, layout, result)) {
+        return result;
+      }
+      // The layout holds a null terminated copy of the format, so the
+      // stream can use it without copying the caller's format
+      return parse_stream(str, layout.format);
+    }
+  }
+  return parse_stream(str, std::string(format).c_str());
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::parse_stream(
+    const std::string_view str, const char* format) -> BasicDateTime {
+  std::istringstream input_stream{std::string(str)};
+  date::sys_time<std::chrono::milliseconds> this_time_point;
+
+  // If the user has provided a string that has milliseconds (i.e., position 4
+  // from the end has a period)
+  if (str.size() >= 4 && str[str.size() - 4] == '.') {
+    // Parse using milliseconds
+    date::from_stream(input_stream, format, this_time_point);
+  } else {
+    // Parse without milliseconds
+    auto tp_temp = date::sys_time<std::chrono::seconds>{};
+    date::from_stream(input_stream, format, tp_temp);
+    this_time_point =
+        std::chrono::time_point_cast<std::chrono::milliseconds>(tp_temp);
+  }
+
+  // Check if parsing was successful
+  if (input_stream.fail() || input_stream.bad()) {
+    return from_count(INVALID_COUNT);  // Parsing failed
+  }
+
+  // Additional validation: ensure the entire string was consumed
+  // This prevents partial matches where invalid time components are ignored
+  if (char remaining_char; input_stream >> remaining_char) {
+    // There are unconsumed non-whitespace characters, which suggests
+    // the format didn't match the full input string
+    return from_count(INVALID_COUNT);
+  }
+
+  return BasicDateTime(this_time_point);
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::parse_auto(
+    const std::string_view str) -> BasicDateTime {
+  static_assert(FIXED_WIDTH_LAYOUTS.size() == FDateStats::AUTO_FORMATS,
+                "Every automatically detected format needs a stats slot");
+
+  // Strings in one of the canonical fixed-width shapes can only be matched
+  // by a single format, so they are sent straight to it
+  if (const auto index = classify_auto_format(str); index >= 0) {
+    const auto slot = static_cast<size_t>(index);
+    BasicDateTime result;
+    const bool parsed =
+        parse_fixed_width(str, FIXED_WIDTH_LAYOUTS[slot], result);
+    FDateStats::parse_attempt(slot, parsed);
+    if (parsed) {
+      return result;
+    }
+  }
+
+  // Anything else is tried against each format in order of precedence
+  for (size_t slot = 0; slot < FIXED_WIDTH_LAYOUTS.size(); ++slot) {
+    const auto result = parse_string(str, FIXED_WIDTH_LAYOUTS[slot].format);
+    FDateStats::parse_attempt(slot, result.valid());
+    if (result.valid()) {
+      return result;
+    }
+  }
+  return from_count(INVALID_COUNT);
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::strptime(
+    const std::string_view str,
+    const std::string_view format) -> BasicDateTime {
+  auto stats = FDateStats::Scope::parse();
+  if (format == "auto") {
+    const auto result = parse_auto(str);
+    stats.parsed(result.valid());
+    return result;
+  }
+  const auto result = parse_string(str, format);
+  FDateStats::parse_attempt(FDateStats::EXPLICIT_FORMAT, result.valid());
+  stats.parsed(result.valid());
+  return result;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::strptime(
+    const std::string_view str, const DateTimeFormat& format) -> BasicDateTime {
+  auto stats = FDateStats::Scope::parse();
+  if (DateTimeFormat::s_Fields fields{}; format.parse(str, fields)) {
+    const auto ymd = date::year{fields.year} / date::month{fields.month} /
+                     date::day{fields.day};
+    const bool in_range =
+        ymd.ok() &&
+        fields.hour <= static_cast<unsigned>(DATETIME_MAX_HOURS) &&
+        fields.minute <= static_cast<unsigned>(DATETIME_MAX_MINUTES) &&
+        fields.second <= static_cast<unsigned>(DATETIME_MAX_SECONDS);
+    FDateStats::parse_attempt(FDateStats::EXPLICIT_FORMAT, in_range);
+    stats.parsed(in_range);
+    if (!in_range) {
+      return from_count(INVALID_COUNT);
+    }
+    return BasicDateTime(date::sys_days{ymd} +
+                         std::chrono::hours{fields.hour} +
+                         std::chrono::minutes{fields.minute} +
+                         std::chrono::seconds{fields.second} +
+                         std::chrono::milliseconds{fields.millisecond});
+  }
+  const auto result = strptime(str, format.pattern());
+  stats.parsed(result.valid());
+  return result;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::strftime(
+    const std::string& fmt) const -> std::string {
+  auto stats = FDateStats::Scope::format();
+  auto out = format_string(fmt, false);
+  stats.formatted(1, out.size());
+  return out;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::strftime_w_milliseconds(
+    const std::string& fmt) const -> std::string {
+  auto stats = FDateStats::Scope::format();
+  auto out = format_string(fmt, true);
+  stats.formatted(1, out.size());
+  return out;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::strftime(
+    const DateTimeFormat& fmt) const -> std::string {
+  auto stats = FDateStats::Scope::format();
+  std::string out;
+  if (!fmt.format(format_fields(false), false, out)) {
+    out = stream_strftime(fmt.pattern(), false);
+  }
+  stats.formatted(1, out.size());
+  return out;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::strftime_w_milliseconds(
+    const DateTimeFormat& fmt) const -> std::string {
+  auto stats = FDateStats::Scope::format();
+  std::string out;
+  if (!fmt.format(format_fields(true), true, out)) {
+    out = stream_strftime(fmt.pattern(), true);
+  }
+  stats.formatted(1, out.size());
+  return out;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::format_to(
+    char* out, const size_t capacity, const char* fmt, const size_t fmt_length,
+    const bool milliseconds) const -> size_t {
+  auto stats = FDateStats::Scope::format();
+  size_t size = 0;
+  if (!DateTimeFormat::format_pattern_to(fmt, fmt_length,
+                                         format_fields(milliseconds),
+                                         milliseconds, out, capacity, size)) {
+    size = copy_to(
+        stream_strftime(std::string(fmt, fmt_length), milliseconds), out,
+        capacity);
+  }
+  stats.formatted(1, written_length(size, capacity));
+  return size;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::format_to(
+    char* out, const size_t capacity, const DateTimeFormat& fmt,
+    const bool milliseconds) const -> size_t {
+  auto stats = FDateStats::Scope::format();
+  size_t size = 0;
+  if (!fmt.format_to(format_fields(milliseconds), milliseconds, out,
+                     capacity, size)) {
+    size = copy_to(stream_strftime(fmt.pattern(), milliseconds), out,
+                   capacity);
+  }
+  stats.formatted(1, written_length(size, capacity));
+  return size;
+}
+
+template <typename Duration, int EpochYear>
+void BasicDateTime<Duration, EpochYear>::format_array_to(
+    const int64_t* timestamps, const size_t count, const DateTimeFormat& fmt,
+    char* out, const size_t width, const bool milliseconds) {
+  auto stats = FDateStats::Scope::format();
+  const auto length = fmt.fixed_length(milliseconds);
+  const bool fixed = fmt.is_compiled() && length <= width;
+
+  // Only used by elements that cannot take the fixed-width path
+  std::string scratch;
+
+  for (size_t i = 0; i < count; ++i) {
+    char* element = out + i * width;
+    const BasicDateTime date(timestamps[i]);
+    const auto fields = date.format_fields(milliseconds);
+
+    size_t size = length;
+    if (fixed && DateTimeFormat::year_in_range(fields.year)) {
+      fmt.fill_fixed(fields, milliseconds, element);
+    } else {
+      scratch.resize(width + 1);
+      size = std::min(
+          date.format_to(&scratch[0], scratch.size(), fmt, milliseconds),
+          width);
+      std::copy_n(scratch.data(), size, element);
+    }
+    std::fill(element + size, element + width, ' ');
+  }
+  stats.formatted(count, count * width);
+}
+
+template <typename Duration, int EpochYear>
+template <typename Spec, bool Milliseconds>
+auto BasicDateTime<Duration, EpochYear>::format(
+    typename FixedDateTimeFormat<Spec, Milliseconds>::t_buffer& out)
+    const noexcept -> bool {
+  auto stats = FDateStats::Scope::format();
+  const bool written = FixedDateTimeFormat<Spec, Milliseconds>::format(
+      format_fields(Milliseconds), out);
+  stats.formatted(written ? 1 : 0, written ? out.size() : 0);
+  return written;
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::to_iso_string() const -> std::string {
+  return iso_string<false>();
+}
+
+template <typename Duration, int EpochYear>
+auto BasicDateTime<Duration, EpochYear>::to_iso_string_msec(
+    ) const -> std::string {
+  return iso_string<true>();
+}
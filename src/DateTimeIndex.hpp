@@ -0,0 +1,235 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "DateTimeCore.hpp"
+
+/**
+ * @brief A sorted time axis that finds the snapshots bracketing a DateTime
+ *
+ * The DateTimeIndex class is built once over a strictly increasing array of
+ * timestamps, such as the times of the snapshots in a forcing file. bracket()
+ * returns the index of the snapshot at or before a time together with the
+ * linear interpolation weight towards the next snapshot.
+ *
+ * The index remembers the interval of the last lookup. Looking up a time in
+ * that interval or the next one, as a model does when stepping forward, is
+ * constant time. Other lookups use an interpolation search that falls back to
+ * bisection, so uniform axes are found in a probe or two and irregular axes in
+ * logarithmic time.
+ *
+ * @note bracket(int64_t) updates the remembered interval and must not be
+ * called concurrently on one index. bracket(int64_t, size_t&) keeps the hint
+ * with the caller instead and can be.
+ */
+class DateTimeIndex {
+ public:
+  /**
+   * @brief Result of a bracketing search
+   */
+  struct s_Bracket {
+    size_t index;   ///< Index of the snapshot at or before the time
+    double weight;  ///< Weight of snapshot index + 1 (0 at index, 1 at next)
+    bool in_range;  ///< False if the time was clamped to the ends of the axis
+  };
+
+  /**
+   * @brief Constructs an index over a time axis
+   *
+   * @param timestamps Strictly increasing timestamps in milliseconds since
+   * epoch. Use is_strictly_increasing() to check untrusted input.
+   */
+  explicit DateTimeIndex(std::vector<int64_t> timestamps) noexcept
+      : m_timestamps(std::move(timestamps)) {}
+
+  /**
+   * @brief Constructs an index over a time axis
+   *
+   * @param timestamps Array of count strictly increasing timestamps in
+   * milliseconds since epoch
+   * @param count Number of timestamps
+   */
+  DateTimeIndex(const int64_t* timestamps, const size_t count)
+      : m_timestamps(timestamps, timestamps + count) {}
+
+  /**
+   * @brief Checks that timestamps can be used to build an index
+   *
+   * @param timestamps Array of count timestamps
+   * @param count Number of timestamps
+   * @return bool True if there is at least one timestamp and each one is
+   * greater than the one before
+   */
+  [[nodiscard]] static auto is_strictly_increasing(const int64_t* timestamps,
+                                                   const size_t count) noexcept
+      -> bool {
+    if (count == 0) {
+      return false;
+    }
+    for (size_t i = 1; i < count; ++i) {
+      if (timestamps[i] <= timestamps[i - 1]) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Gets the number of timestamps in the index
+   * @return size_t The number of timestamps
+   */
+  [[nodiscard]] auto size() const noexcept -> size_t {
+    return m_timestamps.size();
+  }
+
+  /**
+   * @brief Gets a timestamp of the index
+   *
+   * @param index The index of the timestamp, from 0
+   * @return int64_t The timestamp in milliseconds since epoch
+   */
+  [[nodiscard]] auto operator[](const size_t index) const noexcept
+      -> int64_t {
+    return m_timestamps[index];
+  }
+
+  /**
+   * @brief Finds the snapshots bracketing a time
+   *
+   * Times before the first snapshot give index 0 and weight 0, and times
+   * after the last snapshot give the last interval with weight 1, both with
+   * in_range set to false. An index with one timestamp always gives index 0
+   * and weight 0.
+   *
+   * @param timestamp The time in milliseconds since epoch
+   * @return s_Bracket The lower snapshot and interpolation weight
+   */
+  [[nodiscard]] auto bracket(const int64_t timestamp) noexcept -> s_Bracket {
+    return bracket(timestamp, m_hint);
+  }
+
+  /**
+   * @brief Finds the snapshots bracketing a DateTime
+   *
+   * @param date The DateTime
+   * @return s_Bracket The lower snapshot and interpolation weight
+   * @see bracket(int64_t)
+   */
+  [[nodiscard]] auto bracket(const DateTime& date) noexcept -> s_Bracket {
+    return bracket(date.timestamp(), m_hint);
+  }
+
+  /**
+   * @brief Finds the snapshots bracketing a time using a caller held hint
+   *
+   * @param timestamp The time in milliseconds since epoch
+   * @param hint Interval of the previous lookup, updated with the result
+   * @return s_Bracket The lower snapshot and interpolation weight
+   * @see bracket(int64_t)
+   */
+  [[nodiscard]] auto bracket(const int64_t timestamp,
+                             size_t& hint) const noexcept -> s_Bracket {
+    const size_t n = m_timestamps.size();
+    if (n < 2) {
+      return {0, 0.0, n == 1 && timestamp == m_timestamps.front()};
+    }
+
+    if (timestamp < m_timestamps.front()) {
+      hint = 0;
+      return {0, 0.0, false};
+    }
+    if (timestamp >= m_timestamps.back()) {
+      hint = n - 2;
+      return {n - 2, 1.0, timestamp == m_timestamps.back()};
+    }
+
+    hint = find_interval(timestamp, hint < n - 1 ? hint : 0);
+    const auto lower = m_timestamps[hint];
+    const auto upper = m_timestamps[hint + 1];
+    const auto weight = static_cast<double>(timestamp - lower) /
+                        static_cast<double>(upper - lower);
+    return {hint, weight, true};
+  }
+
+ private:
+  /** @brief Interpolation probes before switching to bisection */
+  static constexpr int MAX_INTERPOLATION_PROBES = 4;
+
+  /**
+   * @brief Finds the interval i with timestamps[i] <= t < timestamps[i + 1]
+   *
+   * @param timestamp The time, inside the axis
+   * @param hint Interval to try first
+   * @return size_t The interval
+   */
+  [[nodiscard]] auto find_interval(const int64_t timestamp,
+                                   const size_t hint) const noexcept -> size_t {
+    const auto& ts = m_timestamps;
+
+    // Same interval or the next one as the last lookup
+    if (ts[hint] <= timestamp) {
+      if (timestamp < ts[hint + 1]) {
+        return hint;
+      }
+      if (hint + 2 < ts.size() && timestamp < ts[hint + 2]) {
+        return hint + 1;
+      }
+    }
+
+    // Search with ts[lo] <= timestamp < ts[hi]
+    size_t lo = 0;
+    size_t hi = ts.size() - 1;
+    if (ts[hint] <= timestamp) {
+      lo = hint + 1;
+    } else {
+      hi = hint;
+    }
+
+    int probes = 0;
+    while (hi - lo > 1) {
+      size_t pos = lo + (hi - lo) / 2;
+      if (probes < MAX_INTERPOLATION_PROBES) {
+        const auto fraction = static_cast<double>(timestamp - ts[lo]) /
+                              static_cast<double>(ts[hi] - ts[lo]);
+        const auto offset =
+            static_cast<size_t>(fraction * static_cast<double>(hi - lo));
+        pos = std::min(std::max(lo + offset, lo + 1), hi - 1);
+        ++probes;
+      }
+
+      if (ts[pos] <= timestamp) {
+        lo = pos;
+        if (timestamp < ts[pos + 1]) {
+          hi = pos + 1;
+        }
+      } else {
+        hi = pos;
+      }
+    }
+    return lo;
+  }
+
+  std::vector<int64_t> m_timestamps;
+  size_t m_hint{0};
+};
@@ -0,0 +1,313 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <limits>
+
+#include "DateTimeCore.hpp"
+#include "TimeDelta.hpp"
+
+/**
+ * @brief A lazily evaluated sequence of evenly spaced DateTimes
+ *
+ * The DateTimeRange class describes the DateTimes start, start + step,
+ * start + 2 * step, ... up to and including stop. Elements are computed as
+ * start + i * step when they are accessed, so no array is built and any
+ * element can be reached in constant time.
+ *
+ * The step may be negative for a descending range. A range with a zero step,
+ * or whose step points away from stop, is empty.
+ *
+ * @code
+ *   const DateTimeRange schedule(DateTime(2024, 1, 1), DateTime(2024, 1, 2),
+ *                                TimeDelta::fromHours(1));
+ *   for (const auto& dt : schedule) {
+ *     // 2024-01-01 00:00:00, 01:00:00, ..., 2024-01-02 00:00:00
+ *   }
+ * @endcode
+ */
+class DateTimeRange {
+ public:
+  /**
+   * @brief Random access iterator over the elements of a DateTimeRange
+   */
+  class iterator {
+   public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = DateTime;
+    using difference_type = int64_t;
+    using pointer = void;
+    using reference = DateTime;
+
+    constexpr iterator() noexcept = default;
+
+    /**
+     * @brief Constructs an iterator at an index of a range
+     *
+     * @param start_ms The first element in milliseconds since epoch
+     * @param step_ms The step in milliseconds
+     * @param index The index of the current element
+     */
+    constexpr iterator(const int64_t start_ms, const int64_t step_ms,
+                       const int64_t index) noexcept
+        : m_start(start_ms), m_step(step_ms), m_index(index) {}
+
+    constexpr auto operator*() const noexcept -> DateTime {
+      return DateTime(m_start + m_index * m_step);
+    }
+
+    constexpr auto operator[](const difference_type n) const noexcept
+        -> DateTime {
+      return DateTime(m_start + (m_index + n) * m_step);
+    }
+
+    constexpr auto operator++() noexcept -> iterator& {
+      ++m_index;
+      return *this;
+    }
+
+    constexpr auto operator++(int) noexcept -> iterator {
+      const iterator previous = *this;
+      ++m_index;
+      return previous;
+    }
+
+    constexpr auto operator--() noexcept -> iterator& {
+      --m_index;
+      return *this;
+    }
+
+    constexpr auto operator--(int) noexcept -> iterator {
+      const iterator previous = *this;
+      --m_index;
+      return previous;
+    }
+
+    constexpr auto operator+=(const difference_type n) noexcept -> iterator& {
+      m_index += n;
+      return *this;
+    }
+
+    constexpr auto operator-=(const difference_type n) noexcept -> iterator& {
+      m_index -= n;
+      return *this;
+    }
+
+    constexpr auto operator+(const difference_type n) const noexcept
+        -> iterator {
+      return {m_start, m_step, m_index + n};
+    }
+
+    friend constexpr auto operator+(const difference_type n,
+                                    const iterator& it) noexcept -> iterator {
+      return it + n;
+    }
+
+    constexpr auto operator-(const difference_type n) const noexcept
+        -> iterator {
+      return {m_start, m_step, m_index - n};
+    }
+
+    constexpr auto operator-(const iterator& other) const noexcept
+        -> difference_type {
+      return m_index - other.m_index;
+    }
+
+    constexpr auto operator==(const iterator& other) const noexcept -> bool {
+      return m_index == other.m_index;
+    }
+
+    constexpr auto operator!=(const iterator& other) const noexcept -> bool {
+      return m_index != other.m_index;
+    }
+
+    constexpr auto operator<(const iterator& other) const noexcept -> bool {
+      return m_index < other.m_index;
+    }
+
+    constexpr auto operator>(const iterator& other) const noexcept -> bool {
+      return m_index > other.m_index;
+    }
+
+    constexpr auto operator<=(const iterator& other) const noexcept -> bool {
+      return m_index <= other.m_index;
+    }
+
+    constexpr auto operator>=(const iterator& other) const noexcept -> bool {
+      return m_index >= other.m_index;
+    }
+
+   private:
+    int64_t m_start{0};
+    int64_t m_step{0};
+    int64_t m_index{0};
+  };
+
+  using const_iterator = iterator;
+
+  /**
+   * @brief Constructs the range start, start + step, ... up to stop
+   *
+   * @param start The first DateTime in the range
+   * @param stop The last DateTime that may be in the range. It is included
+   * when stop - start is a whole number of steps.
+   * @param step The spacing between elements
+   */
+  constexpr DateTimeRange(const DateTime& start, const DateTime& stop,
+                          const TimeDelta& step) noexcept
+      : m_start(start.timestamp()),
+        m_step(step.totalMilliseconds()),
+        m_size(count(start.timestamp(), stop.timestamp(),
+                     step.totalMilliseconds())) {}
+
+  /**
+   * @brief Constructs the range of n elements start, start + step, ...
+   *
+   * @param start The first DateTime in the range
+   * @param step The spacing between elements
+   * @param n The number of elements
+   * @return DateTimeRange The range
+   */
+  [[nodiscard]] static constexpr auto from_count(const DateTime& start,
+                                                 const TimeDelta& step,
+                                                 const size_t n) noexcept
+      -> DateTimeRange {
+    return DateTimeRange(start.timestamp(), step.totalMilliseconds(),
+                         static_cast<int64_t>(n));
+  }
+
+  /**
+   * @brief Gets the number of elements in the range
+   * @return size_t The number of elements
+   */
+  [[nodiscard]] constexpr auto size() const noexcept -> size_t {
+    return static_cast<size_t>(m_size);
+  }
+
+  /**
+   * @brief Checks if the range has no elements
+   * @return bool True if the range is empty
+   */
+  [[nodiscard]] constexpr auto empty() const noexcept -> bool {
+    return m_size == 0;
+  }
+
+  /**
+   * @brief Gets the first DateTime of the range
+   * @return DateTime The start of the range
+   */
+  [[nodiscard]] constexpr auto start() const noexcept -> DateTime {
+    return DateTime(m_start);
+  }
+
+  /**
+   * @brief Gets the spacing between elements
+   * @return TimeDelta The step
+   */
+  [[nodiscard]] constexpr auto step() const noexcept -> TimeDelta {
+    return TimeDelta::fromMilliseconds(m_step);
+  }
+
+  /**
+   * @brief Gets an element of the range without bounds checking
+   *
+   * @param index The index of the element, from 0
+   * @return DateTime start + index * step
+   */
+  [[nodiscard]] constexpr auto operator[](const size_t index) const noexcept
+      -> DateTime {
+    return DateTime(timestamp(index));
+  }
+
+  /**
+   * @brief Gets the timestamp of an element without bounds checking
+   *
+   * @param index The index of the element, from 0
+   * @return int64_t start + index * step in milliseconds since epoch
+   */
+  [[nodiscard]] constexpr auto timestamp(const size_t index) const noexcept
+      -> int64_t {
+    return m_start + static_cast<int64_t>(index) * m_step;
+  }
+
+  /**
+   * @brief Writes the timestamps of the range into an array
+   *
+   * @param out Output array of at least size() timestamps in milliseconds
+   * since epoch
+   */
+  constexpr void fill(int64_t* out) const noexcept {
+    for (int64_t i = 0; i < m_size; ++i) {
+      out[i] = m_start + i * m_step;
+    }
+  }
+
+  [[nodiscard]] constexpr auto begin() const noexcept -> iterator {
+    return {m_start, m_step, 0};
+  }
+
+  [[nodiscard]] constexpr auto end() const noexcept -> iterator {
+    return {m_start, m_step, m_size};
+  }
+
+  /**
+   * @brief Counts the elements of start, start + step, ... up to stop
+   *
+   * @param start_ms The first element in milliseconds since epoch
+   * @param stop_ms The last element that may be included
+   * @param step_ms The step in milliseconds
+   * @return int64_t The number of elements, 0 for a zero step, a step
+   * pointing away from stop or an invalid start or stop
+   */
+  [[nodiscard]] static constexpr auto count(const int64_t start_ms,
+                                            const int64_t stop_ms,
+                                            const int64_t step_ms) noexcept
+      -> int64_t {
+    if (step_ms == 0 || (step_ms > 0 && stop_ms < start_ms) ||
+        (step_ms < 0 && stop_ms > start_ms) ||
+        start_ms == DateTime::INVALID_TIMESTAMP ||
+        stop_ms == DateTime::INVALID_TIMESTAMP) {
+      return 0;
+    }
+
+    // The span and the step are taken as unsigned magnitudes so that no
+    // subtraction can overflow
+    const auto start = static_cast<uint64_t>(start_ms);
+    const auto stop = static_cast<uint64_t>(stop_ms);
+    const auto step = static_cast<uint64_t>(step_ms);
+    const uint64_t span = step_ms > 0 ? stop - start : start - stop;
+    const uint64_t step_magnitude = step_ms > 0 ? step : 0 - step;
+    const uint64_t steps = span / step_magnitude;
+    constexpr auto max = static_cast<uint64_t>(
+        std::numeric_limits<int64_t>::max());
+    return steps >= max ? std::numeric_limits<int64_t>::max()
+                        : static_cast<int64_t>(steps) + 1;
+  }
+
+ private:
+  constexpr DateTimeRange(const int64_t start_ms, const int64_t step_ms,
+                          const int64_t size) noexcept
+      : m_start(start_ms), m_step(step_ms), m_size(size) {}
+
+  int64_t m_start;
+  int64_t m_step;
+  int64_t m_size;
+};
@@ -0,0 +1,526 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define FDATE_HAS_MMAP
+#endif
+
+#include "DateTime.hpp"
+#include "DateTimeFormat.hpp"
+#include "ParallelBlocks.hpp"
+
+/**
+ * @brief Extracts a timestamp column from a delimited text file
+ *
+ * The DelimitedTimeReader class reads gauge and station files where each line
+ * is a record and one column holds the time of the record. The file is memory
+ * mapped where the platform supports it, and otherwise read in fixed size
+ * chunks. Either way the timestamp field of each line is located and parsed
+ * in place with a compiled format, so no memory is allocated per line.
+ *
+ * The mapped file, or each chunk read from it, is split at line boundaries
+ * into blocks that are parsed on OpenMP threads. The records of each block
+ * are counted first, so every block writes its timestamps straight into its
+ * part of the output array.
+ *
+ * @code
+ *   DelimitedTimeReader reader("station.csv");
+ *   DelimitedTimeReader::s_Options options;
+ *   options.column = 1;
+ *   options.header_lines = 1;
+ *   std::vector<int64_t> times;
+ *   if (reader.read(DateTimeFormat("%Y-%m-%d %H:%M:%S"), options, times)) {
+ *     // times[i] is the time of the i-th record, or INVALID_TIMESTAMP
+ *   }
+ * @endcode
+ *
+ * @note Fields are not unquoted beyond stripping one pair of surrounding
+ * double quotes, so a delimiter inside a quoted field is treated as a
+ * delimiter.
+ */
+class DelimitedTimeReader {
+ public:
+  /** @brief Default number of bytes parsed by one thread at a time */
+  static constexpr size_t DEFAULT_BLOCK_BYTES = size_t{1} << 20U;
+
+  /** @brief Default number of bytes read at a time when not memory mapped */
+  static constexpr size_t DEFAULT_READ_BYTES = size_t{16} << 20U;
+
+  /** @brief Delimiter that splits fields on runs of blanks and tabs */
+  static constexpr char WHITESPACE = ' ';
+
+  /** @brief Layout of the records in the file */
+  struct s_Options {
+    char delimiter = ',';     ///< Field delimiter, or WHITESPACE
+    size_t column = 0;        ///< Index of the timestamp field, from 0
+    size_t span = 1;          ///< Number of fields forming the timestamp
+    size_t header_lines = 0;  ///< Lines skipped at the start of the file
+    char comment = '#';       ///< Lines starting with this are skipped, or '\0'
+  };
+
+  /**
+   * @brief Opens a file for reading
+   *
+   * @param filename Path of the file
+   * @param memory_map If false, the file is read in chunks even where memory
+   * mapping is supported
+   * @param read_bytes Number of bytes read at a time when the file is not
+   * memory mapped, 0 for DEFAULT_READ_BYTES
+   */
+  explicit DelimitedTimeReader(const std::string& filename,
+                               const bool memory_map = true,
+                               const size_t read_bytes = DEFAULT_READ_BYTES)
+      : m_read_bytes(read_bytes == 0 ? DEFAULT_READ_BYTES : read_bytes) {
+#ifdef FDATE_HAS_MMAP
+    if (memory_map && map(filename)) {
+      return;
+    }
+#else
+    static_cast<void>(memory_map);
+#endif
+    m_file = std::fopen(filename.c_str(), "rb");
+    if (m_file == nullptr) {
+      m_error = "Could not open " + filename;
+    }
+  }
+
+  ~DelimitedTimeReader() noexcept {
+#ifdef FDATE_HAS_MMAP
+    if (m_mapped) {
+      munmap(const_cast<char*>(m_data), m_size);
+    }
+#endif
+    if (m_file != nullptr) {
+      std::fclose(m_file);
+    }
+  }
+
+  DelimitedTimeReader(const DelimitedTimeReader&) = delete;
+  auto operator=(const DelimitedTimeReader&) -> DelimitedTimeReader& = delete;
+  DelimitedTimeReader(DelimitedTimeReader&&) = delete;
+  auto operator=(DelimitedTimeReader&&) -> DelimitedTimeReader& = delete;
+
+  /**
+   * @brief Checks if the file was opened
+   * @return bool True if the file can be read
+   */
+  [[nodiscard]] auto valid() const noexcept -> bool {
+    return m_mapped || m_file != nullptr;
+  }
+
+  /**
+   * @brief Checks if the file is memory mapped
+   * @return bool True if the file is mapped, false if it is read in chunks
+   */
+  [[nodiscard]] auto mapped() const noexcept -> bool { return m_mapped; }
+
+  /**
+   * @brief Gets a description of the last failure
+   * @return const std::string& The message, empty if nothing has failed
+   */
+  [[nodiscard]] auto error() const noexcept -> const std::string& {
+    return m_error;
+  }
+
+  /**
+   * @brief Reads the timestamp of every record of the file
+   *
+   * Blank lines, comment lines and the header lines are skipped. Every other
+   * line is a record and gives one timestamp, which is INVALID_TIMESTAMP if
+   * the line has too few fields or its field could not be parsed.
+   *
+   * @param format The compiled format of the timestamp field, which may be
+   * "auto"
+   * @param options The layout of the records
+   * @param timestamps Receives the timestamps, replacing its contents
+   * @param block_bytes Number of bytes parsed by one thread at a time, 0 for
+   * DEFAULT_BLOCK_BYTES
+   * @return bool True if the whole file was read
+   */
+  auto read(const DateTimeFormat& format, const s_Options& options,
+            std::vector<int64_t>& timestamps,
+            const size_t block_bytes = DEFAULT_BLOCK_BYTES) -> bool {
+    timestamps.clear();
+    if (!valid()) {
+      return false;
+    }
+    if (options.span == 0) {
+      m_error = "The timestamp must span at least one field";
+      return false;
+    }
+    const auto block = block_bytes == 0 ? DEFAULT_BLOCK_BYTES : block_bytes;
+
+    if (m_mapped) {
+      auto header = options.header_lines;
+      const auto start = skip_lines(m_data, m_size, header);
+      return check(parse(m_data + start, m_size - start, format, options,
+                         block, timestamps));
+    }
+    return read_chunks(format, options, block, timestamps);
+  }
+
+  /**
+   * @brief Finds the timestamp field of a line
+   *
+   * @param line The line, without its line terminator
+   * @param options The layout of the records
+   * @return std::string_view The field, and the delimiters between its fields
+   * if it spans more than one, without surrounding blanks or double quotes.
+   * Empty if the line has too few fields.
+   */
+  [[nodiscard]] static auto find_field(const std::string_view line,
+                                       const s_Options& options) noexcept
+      -> std::string_view {
+    size_t pos = 0;
+    size_t first = 0;
+    for (size_t field = 0; field < options.column + options.span; ++field) {
+      if (options.delimiter == WHITESPACE) {
+        while (pos < line.size() && is_blank(line[pos])) {
+          ++pos;
+        }
+        if (pos == line.size()) {
+          return {};
+        }
+      } else if (field > 0) {
+        if (pos == line.size()) {
+          return {};
+        }
+        ++pos;  // Past the delimiter that ended the previous field
+      }
+      if (field == options.column) {
+        first = pos;
+      }
+      while (pos < line.size() && !ends_field(line[pos], options.delimiter)) {
+        ++pos;
+      }
+    }
+    return trim(line.substr(first, pos - first));
+  }
+
+ private:
+  /** @brief Byte range of one block and the position of its first record */
+  struct s_Block {
+    size_t begin;
+    size_t end;
+    size_t first_record;
+  };
+
+#ifdef FDATE_HAS_MMAP
+  /**
+   * @brief Maps a file into memory
+   *
+   * @param filename Path of the file
+   * @return bool True if the file was mapped. An empty file is mapped as an
+   * empty range.
+   */
+  auto map(const std::string& filename) noexcept -> bool {
+    const int fd = open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+      return false;
+    }
+    struct stat info {};
+    bool success = fstat(fd, &info) == 0 && S_ISREG(info.st_mode);
+    if (success && info.st_size > 0) {
+      const auto size = static_cast<size_t>(info.st_size);
+      void* data = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      success = data != MAP_FAILED;
+      if (success) {
+        madvise(data, size, MADV_SEQUENTIAL);
+        m_data = static_cast<const char*>(data);
+        m_size = size;
+      }
+    }
+    close(fd);
+    m_mapped = success;
+    return success;
+  }
+#endif
+
+  /**
+   * @brief Reads the file in chunks that end at a line boundary
+   *
+   * @see read()
+   */
+  auto read_chunks(const DateTimeFormat& format, const s_Options& options,
+                   const size_t block, std::vector<int64_t>& timestamps)
+      -> bool {
+    std::rewind(m_file);
+    std::vector<char> buffer(m_read_bytes);
+    auto header = options.header_lines;
+    size_t carried = 0;
+
+    for (;;) {
+      // A line longer than the buffer grows it until the line fits
+      if (carried == buffer.size()) {
+        buffer.resize(buffer.size() * 2);
+      }
+      const auto requested = buffer.size() - carried;
+      const auto received =
+          std::fread(buffer.data() + carried, 1, requested, m_file);
+      if (std::ferror(m_file) != 0) {
+        m_error = "Could not read the file";
+        timestamps.clear();
+        return false;
+      }
+      const bool at_end = received < requested;
+      const auto filled = carried + received;
+
+      auto usable = filled;
+      if (!at_end) {
+        const auto* last = last_newline(buffer.data(), filled);
+        if (last == nullptr) {
+          carried = filled;
+          continue;
+        }
+        usable = static_cast<size_t>(last - buffer.data()) + 1;
+      }
+
+      const auto start = skip_lines(buffer.data(), usable, header);
+      if (!check(parse(buffer.data() + start, usable - start, format, options,
+                       block, timestamps))) {
+        return false;
+      }
+      if (at_end) {
+        return true;
+      }
+      carried = filled - usable;
+      std::memmove(buffer.data(), buffer.data() + usable, carried);
+    }
+  }
+
+  /**
+   * @brief Records a failed parse
+   *
+   * @param success True if the parse succeeded
+   * @return bool The value of success
+   */
+  auto check(const bool success) -> bool {
+    if (!success) {
+      m_error = "Unexpected failure while parsing the file";
+    }
+    return success;
+  }
+
+  /**
+   * @brief Parses the records of a buffer of whole lines
+   *
+   * @param data Start of the buffer
+   * @param size Size of the buffer
+   * @param format The compiled format of the timestamp field
+   * @param options The layout of the records
+   * @param block Number of bytes parsed by one thread at a time
+   * @param timestamps Receives the timestamps after those it already holds
+   * @return bool True unless a block failed unexpectedly
+   */
+  static auto parse(const char* data, const size_t size,
+                    const DateTimeFormat& format, const s_Options& options,
+                    const size_t block, std::vector<int64_t>& timestamps)
+      -> bool {
+    auto blocks = split_blocks(data, size, block);
+
+    // The records of each block are counted first so that every block knows
+    // where its timestamps go
+    const bool counted = ParallelBlocks::for_each_block(
+        blocks.size(), 1, [&](const size_t begin, const size_t end) noexcept {
+          for (size_t b = begin; b < end; ++b) {
+            size_t records = 0;
+            for_each_line(data, blocks[b], [&](const std::string_view line) {
+              if (is_record(line, options)) {
+                ++records;
+              }
+            });
+            blocks[b].first_record = records;
+          }
+          return true;
+        });
+    if (!counted) {
+      return false;
+    }
+
+    auto next = timestamps.size();
+    for (auto& b : blocks) {
+      const auto records = b.first_record;
+      b.first_record = next;
+      next += records;
+    }
+    timestamps.resize(next, DateTime::INVALID_TIMESTAMP);
+
+    return ParallelBlocks::for_each_block(
+        blocks.size(), 1, [&](const size_t begin, const size_t end) noexcept {
+          try {
+            for (size_t b = begin; b < end; ++b) {
+              auto* out = timestamps.data() + blocks[b].first_record;
+              for_each_line(data, blocks[b], [&](const std::string_view line) {
+                if (!is_record(line, options)) {
+                  return;
+                }
+                const auto field = find_field(line, options);
+                if (!field.empty()) {
+                  *out = DateTime::strptime(field, format).timestamp();
+                }
+                ++out;
+              });
+            }
+            return true;
+          } catch (...) {
+            return false;
+          }
+        });
+  }
+
+  /**
+   * @brief Splits a buffer into blocks of about block bytes ending at a line
+   * boundary
+   */
+  static auto split_blocks(const char* data, const size_t size,
+                           const size_t block) -> std::vector<s_Block> {
+    std::vector<s_Block> blocks;
+    size_t begin = 0;
+    while (begin < size) {
+      auto end = size;
+      if (size - begin > block) {
+        const auto* newline =
+            memchr_char(data + begin + block, '\n', size - begin - block);
+        if (newline != nullptr) {
+          end = static_cast<size_t>(newline - data) + 1;
+        }
+      }
+      blocks.push_back({begin, end, 0});
+      begin = end;
+    }
+    return blocks;
+  }
+
+  /**
+   * @brief Calls function(line) for each line of a block, without the line
+   * terminator
+   */
+  template <typename Function>
+  static void for_each_line(const char* data, const s_Block& block,
+                            const Function& function) {
+    auto pos = block.begin;
+    while (pos < block.end) {
+      const auto* newline = memchr_char(data + pos, '\n', block.end - pos);
+      const auto line_end =
+          newline == nullptr ? block.end : static_cast<size_t>(newline - data);
+      auto length = line_end - pos;
+      if (length > 0 && data[pos + length - 1] == '\r') {
+        --length;
+      }
+      function(std::string_view(data + pos, length));
+      pos = line_end + 1;
+    }
+  }
+
+  /**
+   * @brief Skips lines at the start of a buffer
+   *
+   * @param data Start of the buffer
+   * @param size Size of the buffer
+   * @param count Number of lines to skip, reduced by the lines skipped
+   * @return size_t Offset of the first line that was not skipped
+   */
+  static auto skip_lines(const char* data, const size_t size,
+                         size_t& count) noexcept -> size_t {
+    size_t pos = 0;
+    while (count > 0 && pos < size) {
+      const auto* newline = memchr_char(data + pos, '\n', size - pos);
+      if (newline == nullptr) {
+        return size;
+      }
+      pos = static_cast<size_t>(newline - data) + 1;
+      --count;
+    }
+    return pos;
+  }
+
+  /** @brief Checks if a line holds a record */
+  static auto is_record(const std::string_view line,
+                        const s_Options& options) noexcept -> bool {
+    size_t pos = 0;
+    while (pos < line.size() && is_blank(line[pos])) {
+      ++pos;
+    }
+    return pos < line.size() &&
+           (options.comment == '\0' || line[pos] != options.comment);
+  }
+
+  /** @brief Checks if a character ends a field */
+  static constexpr auto ends_field(const char c, const char delimiter) noexcept
+      -> bool {
+    return delimiter == WHITESPACE ? is_blank(c) : c == delimiter;
+  }
+
+  /** @brief Checks if a character is a blank or a tab */
+  static constexpr auto is_blank(const char c) noexcept -> bool {
+    return c == ' ' || c == '\t';
+  }
+
+  /** @brief Removes surrounding blanks and one pair of double quotes */
+  static auto trim(std::string_view field) noexcept -> std::string_view {
+    while (!field.empty() && is_blank(field.front())) {
+      field.remove_prefix(1);
+    }
+    while (!field.empty() && is_blank(field.back())) {
+      field.remove_suffix(1);
+    }
+    if (field.size() >= 2 && field.front() == '"' && field.back() == '"') {
+      field = field.substr(1, field.size() - 2);
+    }
+    return field;
+  }
+
+  /** @brief Finds a character in a range with memchr */
+  static auto memchr_char(const char* data, const char c,
+                          const size_t size) noexcept -> const char* {
+    return static_cast<const char*>(std::memchr(data, c, size));
+  }
+
+  /** @brief Finds the last line feed of a range */
+  static auto last_newline(const char* data, size_t size) noexcept
+      -> const char* {
+    while (size > 0) {
+      --size;
+      if (data[size] == '\n') {
+        return data + size;
+      }
+    }
+    return nullptr;
+  }
+
+  const char* m_data{nullptr};
+  size_t m_size{0};
+  bool m_mapped{false};
+  std::FILE* m_file{nullptr};
+  size_t m_read_bytes;
+  std::string m_error;
+};
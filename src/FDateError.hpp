@@ -0,0 +1,115 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+/**
+ * @brief Error codes reported by the C interface
+ */
+enum class e_FDateError : int {
+  NONE = 0,              ///< No error has been recorded
+  INVALID_ARGUMENT = 1,  ///< A null pointer or non-positive length was passed
+  PARSE = 2,             ///< A string could not be parsed
+  INVALID_INPUT = 3,     ///< The input was well formed but cannot be used
+  IO = 4,                ///< A file could not be opened or read
+  INTERNAL = 5,          ///< An unexpected failure such as out of memory
+};
+
+/**
+ * @brief Thread local record of the last error of the C interface
+ *
+ * Functions of the C interface that fail record an error code and a short
+ * message here instead of writing to stderr. The record belongs to the calling
+ * thread, so threads never contend for it or see each other's errors, and
+ * recording an error never allocates. Like errno, a successful call does not
+ * clear the record; call clear() before a sequence of calls to check them all.
+ */
+class FDateError {
+ public:
+  /** @brief Capacity of the message, including the null terminator */
+  static constexpr size_t MESSAGE_SIZE = 256;
+
+  /**
+   * @brief Records an error for the calling thread
+   *
+   * @param code The error code
+   * @param message Null terminated description, truncated to fit
+   */
+  static void set(const e_FDateError code, const char* message) noexcept {
+    set(code, message, message == nullptr ? 0 : std::strlen(message));
+  }
+
+  /**
+   * @brief Records an error for the calling thread
+   *
+   * @param code The error code
+   * @param message Description of length characters, truncated to fit
+   * @param length Length of the description
+   */
+  static void set(const e_FDateError code, const char* message,
+                  const size_t length) noexcept {
+    auto& state = current();
+    state.code = code;
+    const size_t n = std::min(length, MESSAGE_SIZE - 1);
+    if (n > 0) {
+      std::memcpy(state.message.data(), message, n);
+    }
+    state.message[n] = '\0';
+  }
+
+  /**
+   * @brief Clears the error of the calling thread
+   */
+  static void clear() noexcept {
+    auto& state = current();
+    state.code = e_FDateError::NONE;
+    state.message[0] = '\0';
+  }
+
+  /**
+   * @brief Gets the last error of the calling thread
+   * @return e_FDateError The error code, NONE if no error has been recorded
+   */
+  [[nodiscard]] static auto code() noexcept -> e_FDateError {
+    return current().code;
+  }
+
+  /**
+   * @brief Gets the message of the last error of the calling thread
+   * @return const char* Null terminated message, empty if no error has been
+   * recorded. Valid until the next error is recorded on this thread.
+   */
+  [[nodiscard]] static auto message() noexcept -> const char* {
+    return current().message.data();
+  }
+
+ private:
+  struct s_State {
+    e_FDateError code{e_FDateError::NONE};
+    std::array<char, MESSAGE_SIZE> message{};
+  };
+
+  [[nodiscard]] static auto current() noexcept -> s_State& {
+    thread_local s_State state;
+    return state;
+  }
+};
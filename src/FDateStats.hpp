@@ -0,0 +1,285 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+/**
+ * @brief Scalar counters kept by FDateStats
+ *
+ * The values are the positions of the counters at the start of the array
+ * filled by FDateStats::get(). The per format parse counters follow them.
+ */
+enum class e_FDateStat : int {
+  PARSE_CALLS = 0,         ///< Calls to DateTime::strptime
+  PARSE_FAILURES = 1,      ///< Calls that returned an invalid DateTime
+  PARSE_NANOSECONDS = 2,   ///< Wall time spent in DateTime::strptime
+  FORMAT_CALLS = 3,        ///< Strings formatted by strftime and format_to
+  FORMAT_BYTES = 4,        ///< Characters produced by the formatted strings
+  FORMAT_NANOSECONDS = 5,  ///< Wall time spent formatting
+};
+
+/**
+ * @brief Optional counters for the parsing and formatting hot paths
+ *
+ * When fdate is built with FDATE_ENABLE_STATS, DateTime records how many
+ * strings it parses and formats, which of the automatically detected formats
+ * they were tried against and matched, and the wall time spent doing so.
+ * Without the option every member compiles to nothing and enabled() is false.
+ *
+ * Counters are kept in a fixed set of cache line sized shards. Each thread is
+ * assigned a shard the first time it records a value and updates it with
+ * relaxed atomic adds, so threads parsing in parallel rarely share a cache
+ * line. get() sums the shards, and values recorded while it runs may or may
+ * not be included.
+ *
+ * @note Calls made from inside another recorded call, such as the fallback of
+ * a compiled format to the string based parser, count toward the outer call
+ * only. The per format attempt and success counters count every attempt.
+ */
+class FDateStats {
+ public:
+  /** @brief Number of formats tried by strptime() with the "auto" format */
+  static constexpr size_t AUTO_FORMATS = 11;
+
+  /** @brief Parse counter slot used for explicitly given formats */
+  static constexpr size_t EXPLICIT_FORMAT = AUTO_FORMATS;
+
+  /** @brief Number of per format parse counter slots */
+  static constexpr size_t FORMAT_SLOTS = AUTO_FORMATS + 1;
+
+  /** @brief Number of scalar counters, see e_FDateStat */
+  static constexpr size_t SCALAR_COUNT = 6;
+
+  /** @brief Position of the first per format attempt counter */
+  static constexpr size_t PARSE_ATTEMPTS_OFFSET = SCALAR_COUNT;
+
+  /** @brief Position of the first per format success counter */
+  static constexpr size_t PARSE_SUCCESSES_OFFSET =
+      PARSE_ATTEMPTS_OFFSET + FORMAT_SLOTS;
+
+  /** @brief Total number of values filled by get() */
+  static constexpr size_t VALUE_COUNT = PARSE_SUCCESSES_OFFSET + FORMAT_SLOTS;
+
+  /** @brief Values of all counters, laid out as described by get() */
+  using t_values = std::array<int64_t, VALUE_COUNT>;
+
+  /**
+   * @brief Checks if fdate was built with instrumentation
+   * @return bool True if the counters are recorded
+   */
+  [[nodiscard]] static constexpr auto enabled() noexcept -> bool {
+#ifdef FDATE_STATS
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * @brief Gets the counters summed over all threads
+   *
+   * The values are the e_FDateStat counters, then FORMAT_SLOTS parse attempt
+   * counters and FORMAT_SLOTS parse success counters. Slots below
+   * AUTO_FORMATS follow the order of the automatically detected formats and
+   * slot EXPLICIT_FORMAT counts parses with any other format.
+   *
+   * @return t_values The counters, all zero without FDATE_ENABLE_STATS
+   */
+  [[nodiscard]] static auto get() noexcept -> t_values {
+    t_values values{};
+#ifdef FDATE_STATS
+    for (const auto& shard : shards()) {
+      for (size_t i = 0; i < VALUE_COUNT; ++i) {
+        values[i] += shard.values[i].load(std::memory_order_relaxed);
+      }
+    }
+#endif
+    return values;
+  }
+
+  /**
+   * @brief Sets all counters to zero
+   */
+  static void reset() noexcept {
+#ifdef FDATE_STATS
+    for (auto& shard : shards()) {
+      for (auto& value : shard.values) {
+        value.store(0, std::memory_order_relaxed);
+      }
+    }
+#endif
+  }
+
+  /**
+   * @brief Records an attempt to parse a string with one format
+   *
+   * @param slot Index of the automatically detected format, or
+   * EXPLICIT_FORMAT
+   * @param success True if the string matched the format
+   */
+  static void parse_attempt(const size_t slot, const bool success) noexcept {
+#ifdef FDATE_STATS
+    add(PARSE_ATTEMPTS_OFFSET + slot, 1);
+    if (success) {
+      add(PARSE_SUCCESSES_OFFSET + slot, 1);
+    }
+#else
+    static_cast<void>(slot);
+    static_cast<void>(success);
+#endif
+  }
+
+  /**
+   * @brief Times a parse or format call and counts it when it completes
+   *
+   * Only the outermost Scope on a thread records anything, so a recorded call
+   * that calls another one is counted and timed once.
+   */
+  class Scope {
+   public:
+    /**
+     * @brief Starts timing a parse call
+     * @return Scope Scope recording into the parse counters
+     */
+    [[nodiscard]] static auto parse() noexcept -> Scope {
+      return Scope(e_FDateStat::PARSE_CALLS);
+    }
+
+    /**
+     * @brief Starts timing a format call
+     * @return Scope Scope recording into the format counters
+     */
+    [[nodiscard]] static auto format() noexcept -> Scope {
+      return Scope(e_FDateStat::FORMAT_CALLS);
+    }
+
+    /**
+     * @brief Records the outcome of a parse call
+     * @param success True if the call returned a valid DateTime
+     */
+    void parsed(const bool success) noexcept {
+#ifdef FDATE_STATS
+      if (m_outermost) {
+        add(e_FDateStat::PARSE_CALLS, 1);
+        if (!success) {
+          add(e_FDateStat::PARSE_FAILURES, 1);
+        }
+      }
+#else
+      static_cast<void>(success);
+#endif
+    }
+
+    /**
+     * @brief Records strings produced by a format call
+     * @param count Number of strings
+     * @param bytes Total number of characters produced
+     */
+    void formatted(const size_t count, const size_t bytes) noexcept {
+#ifdef FDATE_STATS
+      if (m_outermost) {
+        add(e_FDateStat::FORMAT_CALLS, static_cast<int64_t>(count));
+        add(e_FDateStat::FORMAT_BYTES, static_cast<int64_t>(bytes));
+      }
+#else
+      static_cast<void>(count);
+      static_cast<void>(bytes);
+#endif
+    }
+
+    Scope(const Scope&) = delete;
+    Scope(Scope&&) = delete;
+    auto operator=(const Scope&) -> Scope& = delete;
+    auto operator=(Scope&&) -> Scope& = delete;
+
+    ~Scope() {
+#ifdef FDATE_STATS
+      if (m_outermost) {
+        const auto elapsed = std::chrono::steady_clock::now() - m_start;
+        add(m_kind == e_FDateStat::PARSE_CALLS
+                ? e_FDateStat::PARSE_NANOSECONDS
+                : e_FDateStat::FORMAT_NANOSECONDS,
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count());
+        active() = false;
+      }
+#endif
+    }
+
+   private:
+#ifdef FDATE_STATS
+    explicit Scope(const e_FDateStat kind) noexcept
+        : m_kind(kind), m_outermost(!active()) {
+      if (m_outermost) {
+        active() = true;
+        m_start = std::chrono::steady_clock::now();
+      }
+    }
+
+    /** @brief True while a Scope is open on the calling thread */
+    [[nodiscard]] static auto active() noexcept -> bool& {
+      thread_local bool open = false;
+      return open;
+    }
+
+    e_FDateStat m_kind;
+    bool m_outermost;
+    std::chrono::steady_clock::time_point m_start{};
+#else
+    explicit constexpr Scope(const e_FDateStat /*kind*/) noexcept {}
+#endif
+  };
+
+ private:
+#ifdef FDATE_STATS
+  /** @brief Number of shards the counters are spread over */
+  static constexpr size_t SHARD_COUNT = 64;
+
+  struct alignas(64) s_Shard {
+    std::array<std::atomic<int64_t>, VALUE_COUNT> values;
+  };
+
+  [[nodiscard]] static auto shards() noexcept
+      -> std::array<s_Shard, SHARD_COUNT>& {
+    static std::array<s_Shard, SHARD_COUNT> storage{};
+    return storage;
+  }
+
+  /** @brief Shard of the calling thread, assigned round robin */
+  [[nodiscard]] static auto shard() noexcept -> s_Shard& {
+    static std::atomic<size_t> next_shard{0};
+    thread_local s_Shard& mine =
+        shards()[next_shard.fetch_add(1, std::memory_order_relaxed) %
+                 SHARD_COUNT];
+    return mine;
+  }
+
+  static void add(const size_t index, const int64_t value) noexcept {
+    shard().values[index].fetch_add(value, std::memory_order_relaxed);
+  }
+
+  static void add(const e_FDateStat stat, const int64_t value) noexcept {
+    add(static_cast<size_t>(stat), value);
+  }
+#endif
+};
@@ -0,0 +1,246 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+
+#include "CalendarMath.hpp"
+#include "DateTimeCore.hpp"
+#include "TimeDelta.hpp"
+
+/**
+ * @brief A model clock that keeps the calendar fields of the current time
+ *
+ * A time stepping model asks for the year, month, day and hour of the current
+ * time every step, and each DateTime getter converts the timestamp to a civil
+ * date again. The ModelClock class holds the current time together with its
+ * calendar and clock fields. advance() adds a step and updates the fields in
+ * place: the clock fields are taken from the milliseconds since midnight and
+ * the date is only carried to the next day or month when the step crosses
+ * midnight. A full conversion is made at the end of a year and for steps that
+ * are negative or longer than a day.
+ *
+ * crossed_hour(), crossed_day(), crossed_month() and crossed_year() report
+ * whether the last step moved the clock into a different hour, day, month or
+ * year, which is what output and forcing schedules usually test for.
+ *
+ * The fields are identical to the DateTime getters for every time.
+ */
+class ModelClock {
+ public:
+  /**
+   * @brief Constructs a clock at the epoch (1970-01-01 00:00:00)
+   */
+  ModelClock() noexcept : ModelClock(DateTime()) {}
+
+  /**
+   * @brief Constructs a clock at a given time
+   *
+   * @param start The time of the clock
+   */
+  explicit ModelClock(const DateTime& start) noexcept { reset(start); }
+
+  /**
+   * @brief Moves the clock to a new time
+   *
+   * The fields are recomputed and the crossed_*() flags are cleared.
+   *
+   * @param time The new time of the clock
+   */
+  void reset(const DateTime& time) noexcept {
+    m_time = time;
+    synchronize();
+    m_crossed = e_Boundary::NONE;
+  }
+
+  /**
+   * @brief Advances the clock by a step
+   *
+   * @param step The step, which may be negative
+   */
+  void advance(const TimeDelta& step) noexcept {
+    const auto previous = m_fields;
+    const auto step_ms = step.totalMilliseconds();
+    m_time = m_time + step;
+
+    if (step_ms >= 0 && step_ms < CalendarMath::MILLISECONDS_PER_DAY) {
+      m_time_of_day += step_ms;
+      if (m_time_of_day >= CalendarMath::MILLISECONDS_PER_DAY) {
+        m_time_of_day -= CalendarMath::MILLISECONDS_PER_DAY;
+        next_day();
+      }
+      set_clock_fields();
+    } else {
+      synchronize();
+    }
+
+    if (m_fields.year != previous.year) {
+      m_crossed = e_Boundary::YEAR;
+    } else if (m_fields.month != previous.month) {
+      m_crossed = e_Boundary::MONTH;
+    } else if (m_fields.day != previous.day) {
+      m_crossed = e_Boundary::DAY;
+    } else if (m_fields.hour != previous.hour) {
+      m_crossed = e_Boundary::HOUR;
+    } else {
+      m_crossed = e_Boundary::NONE;
+    }
+  }
+
+  /**
+   * @brief Advances the clock by a step
+   *
+   * @param step The step
+   * @return ModelClock& Reference to this clock
+   */
+  auto operator+=(const TimeDelta& step) noexcept -> ModelClock& {
+    advance(step);
+    return *this;
+  }
+
+  /** @brief Gets the current time */
+  [[nodiscard]] auto time() const noexcept -> DateTime { return m_time; }
+
+  /** @brief Gets the current time in milliseconds since epoch */
+  [[nodiscard]] auto timestamp() const noexcept -> int64_t {
+    return m_time.timestamp();
+  }
+
+  /** @brief Gets all of the calendar and clock fields of the current time */
+  [[nodiscard]] auto fields() const noexcept
+      -> const CalendarMath::s_Fields& {
+    return m_fields;
+  }
+
+  /** @brief Gets the year */
+  [[nodiscard]] auto year() const noexcept -> int { return m_fields.year; }
+
+  /** @brief Gets the month (1-12) */
+  [[nodiscard]] auto month() const noexcept -> unsigned {
+    return m_fields.month;
+  }
+
+  /** @brief Gets the day of the month (1-31) */
+  [[nodiscard]] auto day() const noexcept -> unsigned { return m_fields.day; }
+
+  /** @brief Gets the hour (0-23) */
+  [[nodiscard]] auto hour() const noexcept -> unsigned {
+    return m_fields.hour;
+  }
+
+  /** @brief Gets the minute (0-59) */
+  [[nodiscard]] auto minute() const noexcept -> unsigned {
+    return m_fields.minute;
+  }
+
+  /** @brief Gets the second (0-59) */
+  [[nodiscard]] auto second() const noexcept -> unsigned {
+    return m_fields.second;
+  }
+
+  /** @brief Gets the millisecond (0-999) */
+  [[nodiscard]] auto millisecond() const noexcept -> unsigned {
+    return m_fields.millisecond;
+  }
+
+  /** @brief Gets the day of the year (1-366) */
+  [[nodiscard]] auto day_of_year() const noexcept -> unsigned {
+    return m_day_of_year;
+  }
+
+  /** @brief Gets the milliseconds since midnight */
+  [[nodiscard]] auto millisecond_of_day() const noexcept -> int64_t {
+    return m_time_of_day;
+  }
+
+  /** @brief Checks if the last step moved the clock into another hour */
+  [[nodiscard]] auto crossed_hour() const noexcept -> bool {
+    return m_crossed >= e_Boundary::HOUR;
+  }
+
+  /** @brief Checks if the last step moved the clock into another day */
+  [[nodiscard]] auto crossed_day() const noexcept -> bool {
+    return m_crossed >= e_Boundary::DAY;
+  }
+
+  /** @brief Checks if the last step moved the clock into another month */
+  [[nodiscard]] auto crossed_month() const noexcept -> bool {
+    return m_crossed >= e_Boundary::MONTH;
+  }
+
+  /** @brief Checks if the last step moved the clock into another year */
+  [[nodiscard]] auto crossed_year() const noexcept -> bool {
+    return m_crossed >= e_Boundary::YEAR;
+  }
+
+ private:
+  /** @brief Largest calendar boundary crossed by the last step */
+  enum class e_Boundary : uint8_t { NONE, HOUR, DAY, MONTH, YEAR };
+
+  /**
+   * @brief Recomputes every field from the current time
+   */
+  void synchronize() noexcept {
+    m_fields = m_time.to_fields();
+    m_time_of_day = static_cast<int64_t>(m_fields.hour) * 3600000 +
+                    static_cast<int64_t>(m_fields.minute) * 60000 +
+                    static_cast<int64_t>(m_fields.second) * 1000 +
+                    static_cast<int64_t>(m_fields.millisecond);
+    m_day_of_year = static_cast<unsigned>(
+        CalendarMath::days_from_civil(m_fields.year, m_fields.month,
+                                      m_fields.day) -
+        CalendarMath::days_from_civil(m_fields.year, 1, 1) + 1);
+  }
+
+  /**
+   * @brief Moves the date fields to the next day
+   *
+   * Called after m_time has been advanced. The end of a year is converted in
+   * full so the year matches the DateTime getters everywhere in the range.
+   */
+  void next_day() noexcept {
+    if (m_fields.day <
+        CalendarMath::days_in_month(m_fields.year, m_fields.month)) {
+      ++m_fields.day;
+      ++m_day_of_year;
+    } else if (m_fields.month < 12) {
+      m_fields.day = 1;
+      ++m_fields.month;
+      ++m_day_of_year;
+    } else {
+      synchronize();
+    }
+  }
+
+  /**
+   * @brief Sets the clock fields from the milliseconds since midnight
+   */
+  void set_clock_fields() noexcept {
+    const auto tod = static_cast<unsigned>(m_time_of_day);
+    m_fields.hour = tod / 3600000U;
+    m_fields.minute = tod / 60000U % 60U;
+    m_fields.second = tod / 1000U % 60U;
+    m_fields.millisecond = tod % 1000U;
+  }
+
+  DateTime m_time;
+  CalendarMath::s_Fields m_fields{};
+  int64_t m_time_of_day{0};
+  unsigned m_day_of_year{1};
+  e_Boundary m_crossed{e_Boundary::NONE};
+};
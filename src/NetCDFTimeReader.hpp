@@ -0,0 +1,441 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <netcdf.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "CFTimeUnits.hpp"
+#include "DateTime.hpp"
+
+/**
+ * @brief Reads the time axis of a NetCDF file as millisecond timestamps
+ *
+ * The NetCDFTimeReader class opens a NetCDF file, finds a one dimensional time
+ * variable and parses its CF units attribute. Values are then read in fixed
+ * size chunks and decoded straight into timestamps, so the staging memory is
+ * bounded by the chunk size however long the axis is. When the variable is
+ * stored in HDF5 chunks the read size is rounded up to a whole number of them.
+ *
+ * Floating point and integer variables of any width are accepted. Values
+ * equal to the _FillValue attribute, and values that do not fit in a
+ * timestamp such as the default fill values, decode to
+ * DateTime::INVALID_TIMESTAMP.
+ *
+ * @code
+ *   NetCDFTimeReader reader("fort.63.nc");
+ *   if (reader.valid()) {
+ *     reader.for_each_chunk([](size_t start, const int64_t* ts, size_t n) {
+ *       // ts[0 .. n) are the times of records start .. start + n
+ *     });
+ *   }
+ * @endcode
+ *
+ * @note Only the standard, gregorian and proleptic_gregorian calendars are
+ * accepted, and all three are decoded with the proleptic Gregorian calendar.
+ */
+class NetCDFTimeReader {
+ public:
+  /** @brief Default number of values read from the file at a time */
+  static constexpr size_t DEFAULT_CHUNK_SIZE = 65536;
+
+  /**
+   * @brief Opens a time variable of a NetCDF file
+   *
+   * @param filename Path of the NetCDF file
+   * @param variable Name of the time variable
+   * @param chunk_size Number of values read from the file at a time, 0 for
+   * DEFAULT_CHUNK_SIZE
+   */
+  explicit NetCDFTimeReader(const std::string& filename,
+                            const std::string& variable = "time",
+                            const size_t chunk_size = DEFAULT_CHUNK_SIZE)
+      : m_chunk_size(chunk_size == 0 ? DEFAULT_CHUNK_SIZE : chunk_size) {
+    if (!check(nc_open(filename.c_str(), NC_NOWRITE, &m_ncid),
+               "Could not open " + filename)) {
+      m_ncid = -1;
+      return;
+    }
+    if (!open_variable(variable)) {
+      close();
+    }
+  }
+
+  ~NetCDFTimeReader() noexcept { close(); }
+
+  NetCDFTimeReader(const NetCDFTimeReader&) = delete;
+  auto operator=(const NetCDFTimeReader&) -> NetCDFTimeReader& = delete;
+
+  NetCDFTimeReader(NetCDFTimeReader&& other) noexcept
+      : m_ncid(std::exchange(other.m_ncid, -1)),
+        m_varid(other.m_varid),
+        m_type(other.m_type),
+        m_size(other.m_size),
+        m_chunk_size(other.m_chunk_size),
+        m_has_fill(other.m_has_fill),
+        m_fill(other.m_fill),
+        m_float_fill(other.m_float_fill),
+        m_units(other.m_units),
+        m_error(std::move(other.m_error)),
+        m_float_buffer(std::move(other.m_float_buffer)),
+        m_integer_buffer(std::move(other.m_integer_buffer)) {}
+
+  auto operator=(NetCDFTimeReader&& other) noexcept -> NetCDFTimeReader& {
+    if (this != &other) {
+      close();
+      m_ncid = std::exchange(other.m_ncid, -1);
+      m_varid = other.m_varid;
+      m_type = other.m_type;
+      m_size = other.m_size;
+      m_chunk_size = other.m_chunk_size;
+      m_has_fill = other.m_has_fill;
+      m_fill = other.m_fill;
+      m_float_fill = other.m_float_fill;
+      m_units = other.m_units;
+      m_error = std::move(other.m_error);
+      m_float_buffer = std::move(other.m_float_buffer);
+      m_integer_buffer = std::move(other.m_integer_buffer);
+    }
+    return *this;
+  }
+
+  /**
+   * @brief Checks if the time variable was opened and its units understood
+   * @return bool True if values can be read
+   */
+  [[nodiscard]] auto valid() const noexcept -> bool { return m_ncid >= 0; }
+
+  /**
+   * @brief Gets a description of the last failure
+   * @return const std::string& The message, empty if nothing has failed
+   */
+  [[nodiscard]] auto error() const noexcept -> const std::string& {
+    return m_error;
+  }
+
+  /**
+   * @brief Gets the number of values of the time variable
+   * @return size_t The length of the time dimension
+   */
+  [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+
+  /**
+   * @brief Gets the number of values read from the file at a time
+   * @return size_t The chunk size
+   */
+  [[nodiscard]] auto chunk_size() const noexcept -> size_t {
+    return m_chunk_size;
+  }
+
+  /**
+   * @brief Gets the units of the time variable
+   * @return const CFTimeUnits& The parsed units attribute
+   */
+  [[nodiscard]] auto units() const noexcept -> const CFTimeUnits& {
+    return m_units;
+  }
+
+  /**
+   * @brief Reads a section of the time variable as timestamps
+   *
+   * @param start Index of the first value, from 0
+   * @param count Number of values
+   * @param timestamps Output array of count timestamps in milliseconds since
+   * epoch
+   * @return bool True if the values were read, false if the reader is
+   * invalid, the section is outside the variable or the read failed
+   */
+  [[nodiscard]] auto read(const size_t start, const size_t count,
+                          int64_t* timestamps) -> bool {
+    if (!valid()) {
+      return false;
+    }
+    if (start > m_size || count > m_size - start) {
+      m_error = "Requested section is outside the time variable";
+      return false;
+    }
+    for (size_t offset = 0; offset < count; offset += m_chunk_size) {
+      const size_t n = std::min(m_chunk_size, count - offset);
+      if (!read_chunk(start + offset, n, timestamps + offset)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Reads the whole time variable as timestamps
+   * @return std::vector<int64_t> The timestamps, empty if the read failed
+   */
+  [[nodiscard]] auto read_all() -> std::vector<int64_t> {
+    std::vector<int64_t> timestamps(m_size);
+    if (!read(0, m_size, timestamps.data())) {
+      return {};
+    }
+    return timestamps;
+  }
+
+  /**
+   * @brief Streams the time variable through a callback one chunk at a time
+   *
+   * @param callback Called as callback(start, timestamps, count) for each
+   * chunk in order, where timestamps is only valid during the call
+   * @return bool True if every chunk was read
+   */
+  template <typename Callback>
+  [[nodiscard]] auto for_each_chunk(Callback&& callback) -> bool {
+    if (!valid()) {
+      return false;
+    }
+    std::vector<int64_t> timestamps(std::min(m_chunk_size, m_size));
+    for (size_t start = 0; start < m_size; start += m_chunk_size) {
+      const size_t n = std::min(m_chunk_size, m_size - start);
+      if (!read_chunk(start, n, timestamps.data())) {
+        return false;
+      }
+      callback(start, static_cast<const int64_t*>(timestamps.data()), n);
+    }
+    return true;
+  }
+
+ private:
+  /**
+   * @brief Records a NetCDF error
+   *
+   * @param status Return code of a NetCDF call
+   * @param message Description of the call
+   * @return bool True if the call succeeded
+   */
+  auto check(const int status, const std::string& message) -> bool {
+    if (status == NC_NOERR) {
+      return true;
+    }
+    m_error = message + ": " + nc_strerror(status);
+    return false;
+  }
+
+  /**
+   * @brief Finds the time variable and reads its attributes
+   *
+   * @param variable Name of the time variable
+   * @return bool True if the variable can be decoded
+   */
+  auto open_variable(const std::string& variable) -> bool {
+    if (!check(nc_inq_varid(m_ncid, variable.c_str(), &m_varid),
+               "Could not find variable " + variable)) {
+      return false;
+    }
+
+    int ndims = 0;
+    if (!check(nc_inq_varndims(m_ncid, m_varid, &ndims),
+               "Could not query variable " + variable)) {
+      return false;
+    }
+    if (ndims != 1) {
+      m_error = "Variable " + variable + " is not one dimensional";
+      return false;
+    }
+
+    int dimid = 0;
+    if (!check(nc_inq_vardimid(m_ncid, m_varid, &dimid),
+               "Could not query variable " + variable) ||
+        !check(nc_inq_dimlen(m_ncid, dimid, &m_size),
+               "Could not query the dimension of " + variable) ||
+        !check(nc_inq_vartype(m_ncid, m_varid, &m_type),
+               "Could not query the type of " + variable)) {
+      return false;
+    }
+
+    switch (m_type) {
+      case NC_FLOAT:
+      case NC_DOUBLE:
+        m_has_fill = nc_get_att_double(m_ncid, m_varid, "_FillValue",
+                                       &m_float_fill) == NC_NOERR;
+        break;
+      case NC_BYTE:
+      case NC_UBYTE:
+      case NC_SHORT:
+      case NC_USHORT:
+      case NC_INT:
+      case NC_UINT:
+      case NC_INT64:
+      case NC_UINT64:
+        m_has_fill = nc_get_att_longlong(m_ncid, m_varid, "_FillValue",
+                                         &m_fill) == NC_NOERR;
+        break;
+      default:
+        m_error = "Variable " + variable + " is not numeric";
+        return false;
+    }
+
+    std::string units;
+    if (!read_text_attribute("units", units)) {
+      m_error = "Variable " + variable + " has no units attribute";
+      return false;
+    }
+    m_units = CFTimeUnits(units);
+    if (!m_units.valid()) {
+      m_error = "Could not parse units \"" + units + "\" of " + variable;
+      return false;
+    }
+
+    std::string calendar;
+    if (read_text_attribute("calendar", calendar) &&
+        calendar != "standard" && calendar != "gregorian" &&
+        calendar != "proleptic_gregorian") {
+      m_error = "Calendar \"" + calendar + "\" of " + variable +
+                " is not supported";
+      return false;
+    }
+
+    align_chunk_size();
+    if (m_type == NC_FLOAT || m_type == NC_DOUBLE) {
+      m_float_buffer.resize(std::min(m_chunk_size, m_size));
+    } else {
+      m_integer_buffer.resize(std::min(m_chunk_size, m_size));
+    }
+    return true;
+  }
+
+  /**
+   * @brief Reads a text attribute of the time variable
+   *
+   * @param name Name of the attribute
+   * @param value Output attribute value
+   * @return bool True if the attribute exists and is text
+   */
+  auto read_text_attribute(const char* name, std::string& value) const
+      -> bool {
+    nc_type type = NC_NAT;
+    size_t length = 0;
+    if (nc_inq_att(m_ncid, m_varid, name, &type, &length) != NC_NOERR) {
+      return false;
+    }
+    if (type == NC_CHAR) {
+      value.assign(length, '\0');
+      if (nc_get_att_text(m_ncid, m_varid, name, &value[0]) != NC_NOERR) {
+        return false;
+      }
+      value.erase(value.find_last_not_of(std::string(" \0", 2)) + 1);
+      return true;
+    }
+    if (type == NC_STRING && length == 1) {
+      char* text = nullptr;
+      if (nc_get_att_string(m_ncid, m_varid, name, &text) != NC_NOERR) {
+        return false;
+      }
+      value = text == nullptr ? "" : text;
+      nc_free_string(1, &text);
+      return true;
+    }
+    return false;
+  }
+
+  /**
+   * @brief Rounds the chunk size up to a whole number of storage chunks
+   */
+  void align_chunk_size() noexcept {
+    int storage = NC_CONTIGUOUS;
+    size_t storage_chunk = 0;
+    if (nc_inq_var_chunking(m_ncid, m_varid, &storage, &storage_chunk) ==
+            NC_NOERR &&
+        storage == NC_CHUNKED && storage_chunk > 0) {
+      m_chunk_size = (m_chunk_size + storage_chunk - 1) / storage_chunk *
+                     storage_chunk;
+    }
+  }
+
+  /**
+   * @brief Reads and decodes at most chunk_size() values
+   *
+   * @param start Index of the first value
+   * @param count Number of values, at most chunk_size()
+   * @param timestamps Output array of count timestamps
+   * @return bool True if the values were read
+   */
+  auto read_chunk(const size_t start, const size_t count, int64_t* timestamps)
+      -> bool {
+    if (m_type == NC_FLOAT || m_type == NC_DOUBLE) {
+      if (!check(nc_get_vara_double(m_ncid, m_varid, &start, &count,
+                                    m_float_buffer.data()),
+                 "Could not read the time variable")) {
+        return false;
+      }
+      // Fill values become NaN, which decodes to an invalid timestamp
+      if (m_has_fill) {
+        for (size_t i = 0; i < count; ++i) {
+          if (m_float_buffer[i] == m_float_fill) {
+            m_float_buffer[i] = std::numeric_limits<double>::quiet_NaN();
+          }
+        }
+      }
+      m_units.to_timestamps(m_float_buffer.data(), count, timestamps);
+      return true;
+    }
+
+    if (!check(nc_get_vara_longlong(m_ncid, m_varid, &start, &count,
+                                    m_integer_buffer.data()),
+               "Could not read the time variable")) {
+      return false;
+    }
+    // Fill values are masked before scaling and marked invalid after it
+    for (size_t i = 0; i < count; ++i) {
+      const bool fill = m_has_fill && m_integer_buffer[i] == m_fill;
+      timestamps[i] = fill ? 0 : int64_t{m_integer_buffer[i]};
+    }
+    m_units.to_timestamps(timestamps, count, timestamps);
+    if (m_has_fill) {
+      for (size_t i = 0; i < count; ++i) {
+        if (m_integer_buffer[i] == m_fill) {
+          timestamps[i] = DateTime::INVALID_TIMESTAMP;
+        }
+      }
+    }
+    return true;
+  }
+
+  /**
+   * @brief Closes the file
+   */
+  void close() noexcept {
+    if (m_ncid >= 0) {
+      nc_close(m_ncid);
+      m_ncid = -1;
+    }
+  }
+
+  int m_ncid{-1};
+  int m_varid{-1};
+  nc_type m_type{NC_NAT};
+  size_t m_size{0};
+  size_t m_chunk_size;
+  bool m_has_fill{false};
+  long long m_fill{0};
+  double m_float_fill{0.0};
+  CFTimeUnits m_units;
+  std::string m_error;
+  std::vector<double> m_float_buffer;
+  std::vector<long long> m_integer_buffer;
+};
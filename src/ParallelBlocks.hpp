@@ -0,0 +1,101 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+#ifdef FDATE_OPENMP
+#include <omp.h>
+#endif
+
+/**
+ * @brief Splits array operations into blocks that run on OpenMP threads
+ *
+ * for_each_block() divides the index range [0, count) into blocks of a fixed
+ * size and hands them to the threads of an OpenMP team as they become free, so
+ * a thread that draws cheap elements takes more blocks than one that draws
+ * expensive ones. When fdate is built without OpenMP the blocks run in order
+ * on the calling thread.
+ *
+ * @note The function passed to for_each_block() runs on worker threads. It
+ * must not throw, and errors it records with FDateError are not visible to
+ * the calling thread; it reports failure through its return value instead.
+ */
+class ParallelBlocks {
+ public:
+  /** @brief Default number of elements handed to a thread at a time */
+  static constexpr size_t DEFAULT_BLOCK_SIZE = 4096;
+
+  /**
+   * @brief Checks if fdate was built with OpenMP
+   * @return bool True if blocks can run concurrently
+   */
+  [[nodiscard]] static constexpr auto enabled() noexcept -> bool {
+#ifdef FDATE_OPENMP
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  /**
+   * @brief Gets the number of threads a parallel operation may use
+   * @return int The OpenMP thread limit, 1 without OpenMP
+   */
+  [[nodiscard]] static auto max_threads() noexcept -> int {
+#ifdef FDATE_OPENMP
+    return omp_get_max_threads();
+#else
+    return 1;
+#endif
+  }
+
+  /**
+   * @brief Calls function(begin, end) on blocks covering [0, count)
+   *
+   * @param count Number of elements
+   * @param block_size Number of elements per block, 0 for DEFAULT_BLOCK_SIZE
+   * @param function Callable taking (size_t begin, size_t end) and returning
+   * bool, true on success
+   * @return bool True if every block succeeded
+   */
+  template <typename Function>
+  static auto for_each_block(const size_t count, const size_t block_size,
+                             const Function& function) noexcept -> bool {
+    const size_t block = block_size == 0 ? DEFAULT_BLOCK_SIZE : block_size;
+    const auto n_blocks = static_cast<int64_t>((count + block - 1) / block);
+    bool success = true;
+
+#ifdef FDATE_OPENMP
+#pragma omp parallel for schedule(dynamic) if (n_blocks > 1)
+#endif
+    for (int64_t b = 0; b < n_blocks; ++b) {
+      const auto begin = static_cast<size_t>(b) * block;
+      const auto end = std::min(begin + block, count);
+      if (!function(begin, end)) {
+#ifdef FDATE_OPENMP
+#pragma omp atomic write
+#endif
+        success = false;
+      }
+    }
+    return success;
+  }
+};
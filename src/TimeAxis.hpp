@@ -0,0 +1,501 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "DateTimeCore.hpp"
+#include "DateTimeRange.hpp"
+#include "TimeDelta.hpp"
+
+/**
+ * @brief A compactly stored time axis with random access and a binary format
+ *
+ * The TimeAxis class stores the times of the records of a file, such as a
+ * hotstart or checkpoint file, in far less than one 64-bit timestamp per
+ * record. A uniform axis is stored as its start, step and size. Any other
+ * axis is stored as a stream of variable length integers holding the change
+ * of the step from one record to the next, which takes one byte per record
+ * for an axis whose steps differ by less than 64 ms and rarely more than two
+ * or three.
+ *
+ * The decoder state is kept every BLOCK_SIZE records, so reading any record of
+ * an irregular axis decodes fewer than BLOCK_SIZE integers. decode() writes
+ * the whole axis in one pass.
+ *
+ * serialize() writes the axis to a single buffer in a fixed little endian
+ * layout that can be written to and read from a file in one call:
+ *
+ * | Bytes | Contents                                            |
+ * |-------|-----------------------------------------------------|
+ * | 0-3   | "FDTA"                                              |
+ * | 4     | Format version, FORMAT_VERSION                      |
+ * | 5     | Encoding, see e_Encoding                            |
+ * | 6-7   | Zero                                                |
+ * | 8-15  | Number of records                                   |
+ * | 16-23 | First time in milliseconds since epoch              |
+ * | 24-31 | Step in milliseconds, zero for DELTA_OF_DELTA       |
+ * | 32-39 | Length of the encoded stream in bytes               |
+ * | 40-   | Encoded stream, empty for UNIFORM                   |
+ *
+ * Each integer of the stream is the difference between the step into a
+ * record and the step into the record before it, taking the step into the
+ * first record as zero. It is zigzag encoded and written as an unsigned
+ * LEB128 variable length integer.
+ */
+class TimeAxis {
+ public:
+  /** @brief How the times of the axis are stored */
+  enum class e_Encoding : uint8_t {
+    UNIFORM = 0,         ///< Start and step
+    DELTA_OF_DELTA = 1,  ///< Stream of changes of the step
+  };
+
+  /** @brief Records between stored decoder states of an irregular axis */
+  static constexpr size_t BLOCK_SIZE = 64;
+
+  /** @brief Version written to and accepted from serialized axes */
+  static constexpr uint8_t FORMAT_VERSION = 1;
+
+  /** @brief Size of the serialized header in bytes */
+  static constexpr size_t HEADER_SIZE = 40;
+
+  /**
+   * @brief Constructs an empty axis
+   */
+  TimeAxis() noexcept = default;
+
+  /**
+   * @brief Constructs an axis from an array of times
+   *
+   * The times are stored exactly and do not have to be sorted, although
+   * sorted axes with nearly constant steps are the ones stored compactly.
+   *
+   * @param timestamps Array of count times in milliseconds since epoch
+   * @param count Number of times
+   */
+  TimeAxis(const int64_t* timestamps, const size_t count) : m_size(count) {
+    if (count == 0) {
+      return;
+    }
+    m_start = timestamps[0];
+    if (count == 1) {
+      return;
+    }
+
+    m_step = difference(timestamps[1], timestamps[0]);
+    bool uniform = true;
+    for (size_t i = 2; i < count && uniform; ++i) {
+      uniform = difference(timestamps[i], timestamps[i - 1]) == m_step;
+    }
+    if (uniform) {
+      return;
+    }
+
+    m_encoding = e_Encoding::DELTA_OF_DELTA;
+    m_step = 0;
+    m_checkpoints.reserve((count + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    m_checkpoints.push_back({m_start, 0, 0});
+    m_stream.reserve(count);
+
+    int64_t delta = 0;
+    for (size_t i = 1; i < count; ++i) {
+      const auto next_delta = difference(timestamps[i], timestamps[i - 1]);
+      write_varint(zigzag(difference(next_delta, delta)));
+      delta = next_delta;
+      if (i % BLOCK_SIZE == 0) {
+        m_checkpoints.push_back({timestamps[i], delta, m_stream.size()});
+      }
+    }
+    m_stream.shrink_to_fit();
+  }
+
+  /**
+   * @brief Constructs an axis from a vector of times
+   *
+   * @param timestamps Times in milliseconds since epoch
+   */
+  explicit TimeAxis(const std::vector<int64_t>& timestamps)
+      : TimeAxis(timestamps.data(), timestamps.size()) {}
+
+  /**
+   * @brief Constructs a uniform axis holding the DateTimes of a range
+   *
+   * @param range The range, stored as its start, step and size
+   */
+  explicit TimeAxis(const DateTimeRange& range) noexcept
+      : m_size(range.size()),
+        m_start(range.start().timestamp()),
+        m_step(range.step().totalMilliseconds()) {}
+
+  /**
+   * @brief Creates a uniform axis
+   *
+   * @param start The first DateTime
+   * @param step The spacing between DateTimes
+   * @param count The number of DateTimes
+   * @return TimeAxis The axis start, start + step, ...
+   */
+  [[nodiscard]] static auto uniform(const DateTime& start,
+                                    const TimeDelta& step,
+                                    const size_t count) noexcept -> TimeAxis {
+    return TimeAxis(DateTimeRange::from_count(start, step, count));
+  }
+
+  /**
+   * @brief Gets the number of times in the axis
+   * @return size_t The number of times
+   */
+  [[nodiscard]] auto size() const noexcept -> size_t { return m_size; }
+
+  /**
+   * @brief Checks if the axis holds no times
+   * @return bool True if the axis is empty
+   */
+  [[nodiscard]] auto empty() const noexcept -> bool { return m_size == 0; }
+
+  /**
+   * @brief Gets how the axis is stored
+   * @return e_Encoding The encoding
+   */
+  [[nodiscard]] auto encoding() const noexcept -> e_Encoding {
+    return m_encoding;
+  }
+
+  /**
+   * @brief Checks if the axis is stored as a start and step
+   * @return bool True for a uniform axis
+   */
+  [[nodiscard]] auto is_uniform() const noexcept -> bool {
+    return m_encoding == e_Encoding::UNIFORM;
+  }
+
+  /**
+   * @brief Gets the step of a uniform axis
+   * @return TimeDelta The step, zero for an irregular axis
+   */
+  [[nodiscard]] auto step() const noexcept -> TimeDelta {
+    return TimeDelta::fromMilliseconds(m_step);
+  }
+
+  /**
+   * @brief Gets a time of the axis
+   *
+   * Constant time for a uniform axis and fewer than BLOCK_SIZE integers
+   * decoded otherwise.
+   *
+   * @param index The index of the time, from 0. Not bounds checked.
+   * @return int64_t The time in milliseconds since epoch
+   */
+  [[nodiscard]] auto operator[](const size_t index) const noexcept
+      -> int64_t {
+    if (m_encoding == e_Encoding::UNIFORM) {
+      return m_start + static_cast<int64_t>(index) * m_step;
+    }
+
+    const auto& checkpoint = m_checkpoints[index / BLOCK_SIZE];
+    auto value = checkpoint.value;
+    auto delta = checkpoint.delta;
+    auto offset = checkpoint.offset;
+    for (size_t i = index % BLOCK_SIZE; i > 0; --i) {
+      delta = sum(delta, unzigzag(read_varint(m_stream.data(), offset)));
+      value = sum(value, delta);
+    }
+    return value;
+  }
+
+  /**
+   * @brief Gets a DateTime of the axis
+   *
+   * @param index The index of the DateTime, from 0. Not bounds checked.
+   * @return DateTime The DateTime
+   */
+  [[nodiscard]] auto at(const size_t index) const noexcept -> DateTime {
+    return DateTime((*this)[index]);
+  }
+
+  /**
+   * @brief Writes all times of the axis to an array
+   *
+   * @param timestamps Array of at least size() elements receiving the times in
+   * milliseconds since epoch
+   */
+  void decode(int64_t* timestamps) const noexcept {
+    if (m_encoding == e_Encoding::UNIFORM) {
+      DateTimeRange::from_count(DateTime(m_start),
+                                TimeDelta::fromMilliseconds(m_step), m_size)
+          .fill(timestamps);
+      return;
+    }
+
+    int64_t value = m_start;
+    int64_t delta = 0;
+    size_t offset = 0;
+    timestamps[0] = value;
+    for (size_t i = 1; i < m_size; ++i) {
+      delta = sum(delta, unzigzag(read_varint(m_stream.data(), offset)));
+      value = sum(value, delta);
+      timestamps[i] = value;
+    }
+  }
+
+  /**
+   * @brief Gets all times of the axis
+   * @return std::vector<int64_t> The times in milliseconds since epoch
+   */
+  [[nodiscard]] auto decode() const -> std::vector<int64_t> {
+    std::vector<int64_t> timestamps(m_size);
+    if (m_size > 0) {
+      decode(timestamps.data());
+    }
+    return timestamps;
+  }
+
+  /**
+   * @brief Gets the size of the serialized axis
+   * @return size_t Number of bytes written by serialize()
+   */
+  [[nodiscard]] auto serialized_size() const noexcept -> size_t {
+    return HEADER_SIZE + m_stream.size();
+  }
+
+  /**
+   * @brief Writes the axis to a buffer in the layout described above
+   *
+   * @param buffer Buffer of at least serialized_size() bytes
+   * @return size_t Number of bytes written
+   */
+  auto serialize(uint8_t* buffer) const noexcept -> size_t {
+    buffer[0] = 'F';
+    buffer[1] = 'D';
+    buffer[2] = 'T';
+    buffer[3] = 'A';
+    buffer[4] = FORMAT_VERSION;
+    buffer[5] = static_cast<uint8_t>(m_encoding);
+    buffer[6] = 0;
+    buffer[7] = 0;
+    store(buffer + 8, m_size);
+    store(buffer + 16, static_cast<uint64_t>(m_start));
+    store(buffer + 24, static_cast<uint64_t>(m_step));
+    store(buffer + 32, m_stream.size());
+    std::copy(m_stream.begin(), m_stream.end(), buffer + HEADER_SIZE);
+    return serialized_size();
+  }
+
+  /**
+   * @brief Writes the axis to a new buffer
+   * @return std::vector<uint8_t> The serialized axis
+   */
+  [[nodiscard]] auto serialize() const -> std::vector<uint8_t> {
+    std::vector<uint8_t> buffer(serialized_size());
+    // Never empty, but the check shows the optimizer that data() is not null
+    if (!buffer.empty()) {
+      serialize(buffer.data());
+    }
+    return buffer;
+  }
+
+  /**
+   * @brief Reads an axis written by serialize()
+   *
+   * The header and the whole stream are checked, so a truncated or corrupt
+   * buffer is rejected rather than read past its end.
+   *
+   * @param buffer The serialized axis
+   * @param size Number of bytes available in buffer, which may be more than
+   * the serialized axis
+   * @param axis Receives the axis if the buffer is valid, unchanged otherwise
+   * @return size_t Number of bytes read, 0 if the buffer does not hold a valid
+   * axis
+   */
+  static auto deserialize(const uint8_t* buffer, const size_t size,
+                          TimeAxis& axis) -> size_t {
+    if (buffer == nullptr || size < HEADER_SIZE || buffer[0] != 'F' ||
+        buffer[1] != 'D' || buffer[2] != 'T' || buffer[3] != 'A' ||
+        buffer[4] != FORMAT_VERSION || buffer[6] != 0 || buffer[7] != 0) {
+      return 0;
+    }
+
+    TimeAxis result;
+    const auto count = load(buffer + 8);
+    const auto stream_size = load(buffer + 32);
+    if (static_cast<size_t>(count) != count ||
+        stream_size > size - HEADER_SIZE) {
+      return 0;
+    }
+    result.m_size = static_cast<size_t>(count);
+    result.m_start = static_cast<int64_t>(load(buffer + 16));
+    result.m_step = static_cast<int64_t>(load(buffer + 24));
+
+    const auto* stream = buffer + HEADER_SIZE;
+    const auto stream_bytes = static_cast<size_t>(stream_size);
+    if (buffer[5] == static_cast<uint8_t>(e_Encoding::UNIFORM)) {
+      if (stream_bytes != 0) {
+        return 0;
+      }
+    } else if (buffer[5] ==
+               static_cast<uint8_t>(e_Encoding::DELTA_OF_DELTA)) {
+      // Every record after the first takes at least one byte
+      if (result.m_size < 2 || result.m_size - 1 > stream_bytes ||
+          result.m_step != 0) {
+        return 0;
+      }
+      result.m_encoding = e_Encoding::DELTA_OF_DELTA;
+      if (!result.index_stream(stream, stream_bytes)) {
+        return 0;
+      }
+    } else {
+      return 0;
+    }
+
+    axis = std::move(result);
+    return HEADER_SIZE + stream_bytes;
+  }
+
+ private:
+  /** @brief Decoder state at the start of a block of an irregular axis */
+  struct s_Checkpoint {
+    int64_t value;  ///< Time of the first record of the block
+    int64_t delta;  ///< Step into the first record of the block
+    size_t offset;  ///< Position in the stream of the next record
+  };
+
+  /** @brief Longest LEB128 encoding of a 64-bit integer */
+  static constexpr size_t MAX_VARINT_BYTES = 10;
+
+  /**
+   * @brief Subtracts two times, wrapping on overflow so any axis round trips
+   */
+  [[nodiscard]] static auto difference(const int64_t a,
+                                       const int64_t b) noexcept -> int64_t {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) -
+                                static_cast<uint64_t>(b));
+  }
+
+  /**
+   * @brief Adds two times, wrapping on overflow to invert difference()
+   */
+  [[nodiscard]] static auto sum(const int64_t a, const int64_t b) noexcept
+      -> int64_t {
+    return static_cast<int64_t>(static_cast<uint64_t>(a) +
+                                static_cast<uint64_t>(b));
+  }
+
+  /** @brief Maps 0, -1, 1, -2, ... to 0, 1, 2, 3, ... */
+  [[nodiscard]] static auto zigzag(const int64_t value) noexcept -> uint64_t {
+    return (static_cast<uint64_t>(value) << 1U) ^
+           (value < 0 ? ~uint64_t{0} : uint64_t{0});
+  }
+
+  /** @brief Inverts zigzag() */
+  [[nodiscard]] static auto unzigzag(const uint64_t value) noexcept
+      -> int64_t {
+    return static_cast<int64_t>((value >> 1U) ^ (~(value & 1U) + 1U));
+  }
+
+  void write_varint(uint64_t value) {
+    while (value >= 0x80U) {
+      m_stream.push_back(static_cast<uint8_t>(value | 0x80U));
+      value >>= 7U;
+    }
+    m_stream.push_back(static_cast<uint8_t>(value));
+  }
+
+  /**
+   * @brief Reads a varint written by write_varint() from a checked stream
+   */
+  [[nodiscard]] static auto read_varint(const uint8_t* stream,
+                                        size_t& offset) noexcept -> uint64_t {
+    uint64_t value = 0;
+    unsigned shift = 0;
+    uint8_t byte = 0;
+    do {
+      byte = stream[offset++];
+      value |= static_cast<uint64_t>(byte & 0x7FU) << shift;
+      shift += 7;
+    } while ((byte & 0x80U) != 0);
+    return value;
+  }
+
+  /**
+   * @brief Copies a serialized stream, checking it and rebuilding the
+   * checkpoints
+   *
+   * @param stream The encoded stream
+   * @param size Length of the stream in bytes
+   * @return bool True if the stream holds exactly size() - 1 valid varints
+   */
+  auto index_stream(const uint8_t* stream, const size_t size) -> bool {
+    m_checkpoints.clear();
+    m_checkpoints.reserve((m_size + BLOCK_SIZE - 1) / BLOCK_SIZE);
+    m_checkpoints.push_back({m_start, 0, 0});
+
+    int64_t value = m_start;
+    int64_t delta = 0;
+    size_t offset = 0;
+    for (size_t i = 1; i < m_size; ++i) {
+      // Find the end of the varint before reading it
+      size_t length = 0;
+      while (offset + length < size && length < MAX_VARINT_BYTES &&
+             (stream[offset + length] & 0x80U) != 0) {
+        ++length;
+      }
+      if (offset + length >= size || length == MAX_VARINT_BYTES) {
+        return false;
+      }
+      delta = sum(delta, unzigzag(read_varint(stream, offset)));
+      value = sum(value, delta);
+      if (i % BLOCK_SIZE == 0) {
+        m_checkpoints.push_back({value, delta, offset});
+      }
+    }
+    if (offset != size) {
+      return false;
+    }
+
+    m_stream.assign(stream, stream + size);
+    return true;
+  }
+
+  /** @brief Stores a 64-bit integer in little endian byte order */
+  static void store(uint8_t* buffer, const uint64_t value) noexcept {
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+      buffer[i] = static_cast<uint8_t>(value >> (8U * i));
+    }
+  }
+
+  /** @brief Loads a 64-bit integer stored by store() */
+  [[nodiscard]] static auto load(const uint8_t* buffer) noexcept -> uint64_t {
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(uint64_t); ++i) {
+      value |= static_cast<uint64_t>(buffer[i]) << (8U * i);
+    }
+    return value;
+  }
+
+  size_t m_size{0};
+  int64_t m_start{0};
+  int64_t m_step{0};
+  e_Encoding m_encoding{e_Encoding::UNIFORM};
+  std::vector<s_Checkpoint> m_checkpoints;
+  std::vector<uint8_t> m_stream;
+};
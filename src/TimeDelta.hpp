@@ -17,15 +17,19 @@
  */
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <charconv>
 #include <chrono>
-#include <iomanip>
-#include <sstream>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <ratio>
 #include <string>
 
-#include "date_hh.h"
-
 /**
- * @brief A high-precision time duration class with millisecond accuracy
+ * @brief A time duration with a precision chosen at compile time
  *
  * The TimeDelta class represents time intervals or durations with millisecond
  * precision. It can be used for time arithmetic operations and provides
@@ -40,26 +44,48 @@
  * and total duration access (e.g., totalDays(), totalHours()) for flexible time
  * calculations.
  *
- * @note All internal calculations use std::chrono::milliseconds for precision
+ * The duration is stored as a single std::chrono::duration of type Duration,
+ * so the precision and the size of the object are fixed at compile time.
+ * TimeDelta is the millisecond instantiation used throughout fdate and by the
+ * C interface. CompactTimeDelta holds whole seconds in 32 bits and
+ * PreciseTimeDelta holds microseconds.
+ *
+ * @tparam Duration The std::chrono::duration used for storage. Its period
+ * must be one second or finer.
+ *
+ * @note The components and the string representation stop at milliseconds,
+ * so finer parts of a PreciseTimeDelta are only visible through duration()
+ * and totalMicroseconds()
  * @note Negative time spans are supported and handled correctly
- * @see DateTime for date and time point operations
+ * @see BasicDateTime for date and time point operations
  */
-class TimeDelta {
-  /** @brief Internal duration storage with millisecond precision */
-  std::chrono::milliseconds m_duration;
+template <typename Duration>
+class BasicTimeDelta {
+  static_assert(
+      std::ratio_less_equal_v<typename Duration::period, std::ratio<1>>,
+      "BasicTimeDelta needs a precision of one second or finer");
+
+  /** @brief Whole days, with the same 32-bit count as date::days */
+  using t_days = std::chrono::duration<int, std::ratio<86400>>;
+
+  /** @brief Internal duration storage */
+  Duration m_duration;
 
   /**
-   * @brief Private constructor from milliseconds to initialize the TimeDelta
+   * @brief Private constructor from the storage duration
    *
-   * @param milliseconds The duration in milliseconds
+   * @param duration The duration
    *
    * @note This constructor is private to enforce the use of factory methods and
    * public constructors
    */
-  explicit constexpr TimeDelta(std::chrono::milliseconds milliseconds) noexcept
-      : m_duration(milliseconds) {}
+  explicit constexpr BasicTimeDelta(const Duration duration) noexcept
+      : m_duration(duration) {}
 
  public:
+  /** @brief The std::chrono::duration used for storage */
+  using t_duration = Duration;
+
   /**
    * @brief Structure to hold the decomposed components of a TimeDelta
    *
@@ -79,7 +105,7 @@ class TimeDelta {
   /**
    * @brief Default constructor initializes the TimeDelta to zero duration
    */
-  constexpr TimeDelta() noexcept : m_duration(std::chrono::milliseconds{0}) {}
+  constexpr BasicTimeDelta() noexcept : m_duration(Duration{0}) {}
 
   /**
    * @brief Constructs a TimeDelta from a components structure
@@ -89,12 +115,25 @@ class TimeDelta {
    * @note All components are summed to create the total duration
    * @note Negative components are handled correctly
    */
-  constexpr explicit TimeDelta(const s_TimedeltaComponents& components) noexcept
-      : m_duration(std::chrono::milliseconds{
-            date::days(components.days) + std::chrono::hours(components.hours) +
+  constexpr explicit BasicTimeDelta(
+      const s_TimedeltaComponents& components) noexcept
+      : m_duration(std::chrono::duration_cast<Duration>(
+            t_days(components.days) + std::chrono::hours(components.hours) +
             std::chrono::minutes(components.minutes) +
             std::chrono::seconds(components.seconds) +
-            std::chrono::milliseconds(components.milliseconds)}) {}
+            std::chrono::milliseconds(components.milliseconds))) {}
+
+  /**
+   * @brief Converts a TimeDelta of another precision
+   *
+   * @tparam OtherDuration The storage duration of the other TimeDelta
+   * @param other The TimeDelta to convert, truncated toward zero if it is
+   * finer than this precision
+   */
+  template <typename OtherDuration>
+  constexpr explicit BasicTimeDelta(
+      const BasicTimeDelta<OtherDuration>& other) noexcept
+      : m_duration(std::chrono::duration_cast<Duration>(other.duration())) {}
 
   /**
    * @brief Constructs a TimeDelta from individual time components
@@ -110,11 +149,11 @@ class TimeDelta {
    * @note No validation is performed; values outside typical ranges (e.g.,
    * hours > 23) are accepted
    */
-  explicit constexpr TimeDelta(const int days, const int hours,
-                               const int minutes, const int seconds,
-                               const int milliseconds) noexcept
-      : TimeDelta(s_TimedeltaComponents{days, hours, minutes, seconds,
-                                        milliseconds}) {}
+  explicit constexpr BasicTimeDelta(const int days, const int hours,
+                                    const int minutes, const int seconds,
+                                    const int milliseconds) noexcept
+      : BasicTimeDelta(s_TimedeltaComponents{days, hours, minutes, seconds,
+                                             milliseconds}) {}
 
   // Static factory methods
 
@@ -127,8 +166,8 @@ class TimeDelta {
    * @see fromHours(), fromMinutes(), fromSeconds(), fromMilliseconds()
    */
   [[nodiscard]] static constexpr auto fromDays(const int64_t days) noexcept
-      -> TimeDelta {
-    return TimeDelta(s_TimedeltaComponents{days, 0, 0, 0, 0});
+      -> BasicTimeDelta {
+    return BasicTimeDelta(s_TimedeltaComponents{days, 0, 0, 0, 0});
   }
 
   /**
@@ -140,8 +179,8 @@ class TimeDelta {
    * @see fromDays(), fromMinutes(), fromSeconds(), fromMilliseconds()
    */
   [[nodiscard]] static constexpr auto fromHours(const int64_t hours) noexcept
-      -> TimeDelta {
-    return TimeDelta(s_TimedeltaComponents{0, hours, 0, 0, 0});
+      -> BasicTimeDelta {
+    return BasicTimeDelta(s_TimedeltaComponents{0, hours, 0, 0, 0});
   }
 
   /**
@@ -153,8 +192,8 @@ class TimeDelta {
    * @see fromDays(), fromHours(), fromSeconds(), fromMilliseconds()
    */
   [[nodiscard]] static constexpr auto fromMinutes(
-      const int64_t minutes) noexcept -> TimeDelta {
-    return TimeDelta(s_TimedeltaComponents{0, 0, minutes, 0, 0});
+      const int64_t minutes) noexcept -> BasicTimeDelta {
+    return BasicTimeDelta(s_TimedeltaComponents{0, 0, minutes, 0, 0});
   }
 
   /**
@@ -166,8 +205,8 @@ class TimeDelta {
    * @see fromDays(), fromHours(), fromMinutes(), fromMilliseconds()
    */
   [[nodiscard]] static constexpr auto fromSeconds(
-      const int64_t seconds) noexcept -> TimeDelta {
-    return TimeDelta(s_TimedeltaComponents{0, 0, 0, seconds, 0});
+      const int64_t seconds) noexcept -> BasicTimeDelta {
+    return BasicTimeDelta(s_TimedeltaComponents{0, 0, 0, seconds, 0});
   }
 
   /**
@@ -179,8 +218,22 @@ class TimeDelta {
    * @see fromDays(), fromHours(), fromMinutes(), fromSeconds()
    */
   [[nodiscard]] static constexpr auto fromMilliseconds(
-      const int64_t milliseconds) noexcept -> TimeDelta {
-    return TimeDelta(s_TimedeltaComponents{0, 0, 0, 0, milliseconds});
+      const int64_t milliseconds) noexcept -> BasicTimeDelta {
+    return BasicTimeDelta(s_TimedeltaComponents{0, 0, 0, 0, milliseconds});
+  }
+
+  /**
+   * @brief Creates a TimeDelta from a std::chrono::duration
+   *
+   * @param duration The duration, truncated toward zero if it is finer than
+   * this precision
+   * @return TimeDelta object representing the specified duration
+   */
+  template <typename Rep, typename Period>
+  [[nodiscard]] static constexpr auto fromDuration(
+      const std::chrono::duration<Rep, Period>& duration) noexcept
+      -> BasicTimeDelta {
+    return BasicTimeDelta(std::chrono::duration_cast<Duration>(duration));
   }
 
   /**
@@ -194,7 +247,7 @@ class TimeDelta {
    * @see to_components() for static version
    */
   [[nodiscard]] constexpr auto components() const noexcept {
-    return to_components(m_duration.count());
+    return to_components(totalMilliseconds());
   }
 
   /**
@@ -217,7 +270,7 @@ class TimeDelta {
     const bool negative = duration_ms < 0;
     int64_t this_duration = negative ? -duration_ms : duration_ms;
 
-    const auto n_days = std::chrono::duration_cast<date::days>(
+    const auto n_days = std::chrono::duration_cast<t_days>(
         std::chrono::milliseconds(this_duration));
     this_duration -=
         std::chrono::duration_cast<std::chrono::milliseconds>(n_days).count();
@@ -341,7 +394,7 @@ class TimeDelta {
    * @see days() for only the days component
    */
   [[nodiscard]] constexpr auto totalDays() const noexcept -> int64_t {
-    return std::chrono::duration_cast<date::days>(m_duration).count();
+    return std::chrono::duration_cast<t_days>(m_duration).count();
   }
 
   /**
@@ -396,21 +449,32 @@ class TimeDelta {
    * @see milliseconds() for only the milliseconds component
    */
   [[nodiscard]] constexpr auto totalMilliseconds() const noexcept -> int64_t {
-    return m_duration.count();
+    return std::chrono::duration_cast<std::chrono::milliseconds>(m_duration)
+        .count();
+  }
+
+  /**
+   * @brief Gets the total duration expressed as microseconds
+   *
+   * @return int64_t The total number of microseconds in the TimeDelta (can be
+   * negative)
+   */
+  [[nodiscard]] constexpr auto totalMicroseconds() const noexcept -> int64_t {
+    return std::chrono::duration_cast<std::chrono::microseconds>(m_duration)
+        .count();
   }
 
   // Internal access
 
   /**
-   * @brief Gets the internal std::chrono::milliseconds representation
+   * @brief Gets the internal std::chrono::duration representation
    *
-   * @return std::chrono::milliseconds The internal duration object
+   * @return Duration The internal duration object
    *
    * @note This method provides direct access to the internal representation
    * @note Primarily used for integration with other chrono-based operations
    */
-  [[nodiscard]] constexpr auto duration() const noexcept
-      -> std::chrono::milliseconds {
+  [[nodiscard]] constexpr auto duration() const noexcept -> Duration {
     return m_duration;
   }
 
@@ -424,10 +488,9 @@ class TimeDelta {
    *
    * @see operator-() for subtraction
    */
-  [[nodiscard]] constexpr auto operator+(const TimeDelta& other) const noexcept
-      -> TimeDelta {
-    return TimeDelta(
-        to_components(m_duration.count() + other.m_duration.count()));
+  [[nodiscard]] constexpr auto operator+(
+      const BasicTimeDelta& other) const noexcept -> BasicTimeDelta {
+    return BasicTimeDelta(m_duration + other.m_duration);
   }
 
   /**
@@ -439,10 +502,9 @@ class TimeDelta {
    *
    * @see operator+() for addition
    */
-  [[nodiscard]] constexpr auto operator-(const TimeDelta& other) const noexcept
-      -> TimeDelta {
-    return TimeDelta(
-        to_components(m_duration.count() - other.m_duration.count()));
+  [[nodiscard]] constexpr auto operator-(
+      const BasicTimeDelta& other) const noexcept -> BasicTimeDelta {
+    return BasicTimeDelta(m_duration - other.m_duration);
   }
 
   /**
@@ -455,8 +517,9 @@ class TimeDelta {
    * @see operator/() for division
    */
   [[nodiscard]] constexpr auto operator*(const int64_t factor) const noexcept
-      -> TimeDelta {
-    return TimeDelta(to_components(m_duration.count() * factor));
+      -> BasicTimeDelta {
+    return BasicTimeDelta(
+        std::chrono::duration_cast<Duration>(m_duration * factor));
   }
 
   /**
@@ -470,10 +533,12 @@ class TimeDelta {
    * @see operator*() for multiplication
    */
   [[nodiscard]] constexpr auto operator/(const int64_t divisor) const noexcept
-      -> TimeDelta {
-    return divisor == 0
-               ? fromMilliseconds(0)
-               : TimeDelta(to_components(m_duration.count() / divisor));
+      -> BasicTimeDelta {
+    if (divisor == 0) {
+      return fromMilliseconds(0);
+    }
+    return BasicTimeDelta(
+        std::chrono::duration_cast<Duration>(m_duration / divisor));
   }
 
   // Comparison Operators
@@ -484,8 +549,8 @@ class TimeDelta {
    * @param other The TimeDelta to compare with
    * @return bool True if both TimeDeltas represent the same duration
    */
-  [[nodiscard]] constexpr auto operator==(const TimeDelta& other) const noexcept
-      -> bool {
+  [[nodiscard]] constexpr auto operator==(
+      const BasicTimeDelta& other) const noexcept -> bool {
     return m_duration == other.m_duration;
   }
 
@@ -495,8 +560,8 @@ class TimeDelta {
    * @param other The TimeDelta to compare with
    * @return bool True if the TimeDeltas represent different durations
    */
-  [[nodiscard]] constexpr auto operator!=(const TimeDelta& other) const noexcept
-      -> bool {
+  [[nodiscard]] constexpr auto operator!=(
+      const BasicTimeDelta& other) const noexcept -> bool {
     return m_duration != other.m_duration;
   }
 
@@ -506,8 +571,8 @@ class TimeDelta {
    * @param other The TimeDelta to compare with
    * @return bool True if this TimeDelta is shorter than the other
    */
-  [[nodiscard]] constexpr auto operator<(const TimeDelta& other) const noexcept
-      -> bool {
+  [[nodiscard]] constexpr auto operator<(
+      const BasicTimeDelta& other) const noexcept -> bool {
     return m_duration < other.m_duration;
   }
 
@@ -517,8 +582,8 @@ class TimeDelta {
    * @param other The TimeDelta to compare with
    * @return bool True if this TimeDelta is longer than the other
    */
-  [[nodiscard]] constexpr auto operator>(const TimeDelta& other) const noexcept
-      -> bool {
+  [[nodiscard]] constexpr auto operator>(
+      const BasicTimeDelta& other) const noexcept -> bool {
     return m_duration > other.m_duration;
   }
 
@@ -528,8 +593,8 @@ class TimeDelta {
    * @param other The TimeDelta to compare with
    * @return bool True if this TimeDelta is shorter than or equal to the other
    */
-  [[nodiscard]] constexpr auto operator<=(const TimeDelta& other) const noexcept
-      -> bool {
+  [[nodiscard]] constexpr auto operator<=(
+      const BasicTimeDelta& other) const noexcept -> bool {
     return m_duration <= other.m_duration;
   }
 
@@ -539,13 +604,70 @@ class TimeDelta {
    * @param other The TimeDelta to compare with
    * @return bool True if this TimeDelta is longer than or equal to the other
    */
-  [[nodiscard]] constexpr auto operator>=(const TimeDelta& other) const noexcept
-      -> bool {
+  [[nodiscard]] constexpr auto operator>=(
+      const BasicTimeDelta& other) const noexcept -> bool {
     return m_duration >= other.m_duration;
   }
 
   // String representation
 
+  /** @brief Longest string written by format_to(), without a terminator */
+  static constexpr size_t MAX_STRING_LENGTH = 27;
+
+  /**
+   * @brief Writes the TimeDelta into a character buffer
+   *
+   * Writes the same text as toString(), at most (capacity - 1) characters
+   * followed by a null terminator, in the same way as snprintf. The duration
+   * is split into its components once and no heap allocation is performed.
+   *
+   * @param out The destination buffer (may be nullptr if capacity is 0)
+   * @param capacity The size of the destination buffer
+   * @return size_t The full length of the string, at most MAX_STRING_LENGTH.
+   * The output was truncated if this is larger than or equal to capacity.
+   */
+  auto format_to(char* out, const size_t capacity) const noexcept -> size_t {
+    const auto total = totalMilliseconds();
+    auto magnitude = total < 0 ? uint64_t{0} - static_cast<uint64_t>(total)
+                               : static_cast<uint64_t>(total);
+    const auto milliseconds = static_cast<unsigned>(magnitude % 1000U);
+    magnitude /= 1000U;
+    const auto seconds = static_cast<unsigned>(magnitude % 60U);
+    magnitude /= 60U;
+    const auto minutes = static_cast<unsigned>(magnitude % 60U);
+    magnitude /= 60U;
+    const auto hours = static_cast<unsigned>(magnitude % 24U);
+    const auto days = magnitude / 24U;
+
+    std::array<char, MAX_STRING_LENGTH> text{};
+    char* end = text.data();
+    if (total < 0) {
+      *end++ = '-';
+    }
+    if (days != 0) {
+      end = std::to_chars(end, text.data() + text.size(), days).ptr;
+      *end++ = 'd';
+      *end++ = ' ';
+    }
+    end = put_digits(end, hours, 2);
+    *end++ = ':';
+    end = put_digits(end, minutes, 2);
+    *end++ = ':';
+    end = put_digits(end, seconds, 2);
+    if (milliseconds != 0) {
+      *end++ = '.';
+      end = put_digits(end, milliseconds, 3);
+    }
+
+    const auto size = static_cast<size_t>(end - text.data());
+    if (capacity > 0) {
+      const auto length = std::min(size, capacity - 1);
+      std::copy_n(text.data(), length, out);
+      out[length] = '\0';
+    }
+    return size;
+  }
+
   /**
    * @brief Converts the TimeDelta to a human-readable string representation
    *
@@ -553,32 +675,305 @@ class TimeDelta {
    * - If days are present: "Nd HH:MM:SS" or "Nd HH:MM:SS.mmm"
    * - If no days: "HH:MM:SS" or "HH:MM:SS.mmm"
    * - Milliseconds are only included if non-zero
-   * - Negative TimeDeltas are indicated by negative component values
+   * - Negative TimeDeltas are written as the length of the duration preceded
+   *   by a single '-'
    *
    * Examples:
    * - "02:30:45" (2 hours, 30 minutes, 45 seconds)
    * - "1d 14:30:25.123" (1 day, 14 hours, 30 minutes, 25 seconds, 123
    * milliseconds)
    * - "00:00:00.500" (500 milliseconds)
+   * - "-1d 00:00:00.250" (minus 1 day and 250 milliseconds)
    *
    * @return std::string A formatted string representation of the TimeDelta
    *
    * @note All components are zero-padded for consistent formatting
    * @note Days are shown without padding when present
+   * @see parse() to read the string back
    */
   [[nodiscard]] auto toString() const -> std::string {
-    std::ostringstream oss;
-    if (days() != 0) {
-      oss << days() << "d ";
+    std::array<char, MAX_STRING_LENGTH + 1> buffer{};
+    const auto size = format_to(buffer.data(), buffer.size());
+    return {buffer.data(), size};
+  }
+
+  /**
+   * @brief Reads a TimeDelta from a string
+   *
+   * Two forms are accepted, each optionally preceded by '-' or '+' and
+   * surrounded by blanks:
+   * - The form written by toString(), "[Nd ]H:MM:SS[.fff]", such as
+   *   "1d 14:30:25.123" or "36:00:00". Hours may have any number of digits.
+   * - An ISO 8601 duration of weeks, days, hours, minutes and seconds, such
+   *   as "P1DT2H", "PT90M", "P2W" or "PT0.5S". Years and months are rejected
+   *   because their length is not fixed.
+   *
+   * Fractions are only accepted on the seconds and are truncated to the
+   * precision of milliseconds.
+   *
+   * @param str The string to read (need not be null terminated)
+   * @param length The length of the string
+   * @param result Receives the TimeDelta if the string is valid, unchanged
+   * otherwise
+   * @return bool True if the string was read
+   */
+  static auto parse(const char* str, const size_t length,
+                    BasicTimeDelta& result) noexcept -> bool {
+    if (str == nullptr) {
+      return false;
+    }
+    size_t begin = 0;
+    size_t end = length;
+    while (begin < end && str[begin] == ' ') {
+      ++begin;
+    }
+    while (end > begin && str[end - 1] == ' ') {
+      --end;
+    }
+
+    bool negative = false;
+    if (begin < end && (str[begin] == '-' || str[begin] == '+')) {
+      negative = str[begin] == '-';
+      ++begin;
+    }
+    if (begin == end) {
+      return false;
     }
-    oss << std::setfill('0') << std::setw(2) << hours() << ":"
-        << std::setfill('0') << std::setw(2) << minutes() << ":"
-        << std::setfill('0') << std::setw(2) << seconds();
 
-    if (milliseconds() != 0) {
-      oss << "." << std::setfill('0') << std::setw(3) << milliseconds();
+    int64_t total_ms = 0;
+    const bool parsed =
+        str[begin] == 'P'
+            ? parse_iso_duration(str + begin + 1, end - begin - 1, total_ms)
+            : parse_clock(str + begin, end - begin, total_ms);
+    if (!parsed) {
+      return false;
     }
 
-    return oss.str();
+    result = fromDuration(
+        std::chrono::milliseconds(negative ? -total_ms : total_ms));
+    return true;
+  }
+
+  /**
+   * @brief Reads a TimeDelta from a string
+   *
+   * @param str The string to read
+   * @param result Receives the TimeDelta if the string is valid
+   * @return bool True if the string was read
+   * @see parse(const char*, size_t, BasicTimeDelta&)
+   */
+  static auto parse(const std::string& str, BasicTimeDelta& result) noexcept
+      -> bool {
+    return parse(str.data(), str.size(), result);
+  }
+
+ private:
+  /** @brief Milliseconds in each unit read by the parsers */
+  static constexpr int64_t MS_PER_SECOND = 1000;
+  static constexpr int64_t MS_PER_MINUTE = 60 * MS_PER_SECOND;
+  static constexpr int64_t MS_PER_HOUR = 60 * MS_PER_MINUTE;
+  static constexpr int64_t MS_PER_DAY = 24 * MS_PER_HOUR;
+  static constexpr int64_t MS_PER_WEEK = 7 * MS_PER_DAY;
+
+  /**
+   * @brief Writes a fixed number of decimal digits
+   *
+   * @param out The destination, with room for n_digits characters
+   * @param value The value to write
+   * @param n_digits The number of digits to write
+   * @return char* The position after the digits
+   */
+  static auto put_digits(char* out, unsigned value,
+                         const size_t n_digits) noexcept -> char* {
+    for (size_t i = n_digits; i > 0; --i) {
+      out[i - 1] = static_cast<char>('0' + value % 10U);
+      value /= 10U;
+    }
+    return out + n_digits;
+  }
+
+  /**
+   * @brief Reads a run of decimal digits
+   *
+   * @param str The string
+   * @param length The length of the string
+   * @param pos Position of the first digit, advanced past the digits
+   * @param value The value of the digits
+   * @return size_t The number of digits read, 0 if there were none or the
+   * value overflows
+   */
+  static auto read_number(const char* str, const size_t length, size_t& pos,
+                          int64_t& value) noexcept -> size_t {
+    const auto start = pos;
+    value = 0;
+    while (pos < length && str[pos] >= '0' && str[pos] <= '9') {
+      const auto digit = static_cast<int64_t>(str[pos] - '0');
+      if (value > (std::numeric_limits<int64_t>::max() - digit) / 10) {
+        return 0;
+      }
+      value = value * 10 + digit;
+      ++pos;
+    }
+    return pos - start;
+  }
+
+  /**
+   * @brief Reads the digits of a fraction of a second as milliseconds
+   *
+   * @param str The string
+   * @param length The length of the string
+   * @param pos Position of the first digit, advanced past the digits
+   * @param milliseconds The fraction, truncated to milliseconds
+   * @return bool True if there was at least one digit
+   */
+  static auto read_fraction(const char* str, const size_t length, size_t& pos,
+                            int64_t& milliseconds) noexcept -> bool {
+    const auto start = pos;
+    milliseconds = 0;
+    int64_t scale = 100;
+    while (pos < length && str[pos] >= '0' && str[pos] <= '9') {
+      milliseconds += static_cast<int64_t>(str[pos] - '0') * scale;
+      scale /= 10;
+      ++pos;
+    }
+    return pos > start;
+  }
+
+  /**
+   * @brief Adds value * scale to a total, checking for overflow
+   *
+   * @return bool False if the total does not fit in 64 bits
+   */
+  static auto add_scaled(int64_t& total, const int64_t value,
+                         const int64_t scale) noexcept -> bool {
+    if (value > (std::numeric_limits<int64_t>::max() - total) / scale) {
+      return false;
+    }
+    total += value * scale;
+    return true;
+  }
+
+  /**
+   * @brief Reads the "[Nd ]H:MM:SS[.fff]" form without a sign
+   */
+  static auto parse_clock(const char* str, const size_t length,
+                          int64_t& total_ms) noexcept -> bool {
+    size_t pos = 0;
+    int64_t value = 0;
+    if (read_number(str, length, pos, value) == 0) {
+      return false;
+    }
+
+    total_ms = 0;
+    if (pos < length && str[pos] == 'd') {
+      if (!add_scaled(total_ms, value, MS_PER_DAY)) {
+        return false;
+      }
+      ++pos;
+      const auto days_end = pos;
+      while (pos < length && str[pos] == ' ') {
+        ++pos;
+      }
+      if (pos == days_end || read_number(str, length, pos, value) == 0) {
+        return false;
+      }
+    }
+    if (!add_scaled(total_ms, value, MS_PER_HOUR)) {
+      return false;
+    }
+
+    for (const auto scale : {MS_PER_MINUTE, MS_PER_SECOND}) {
+      if (pos >= length || str[pos] != ':') {
+        return false;
+      }
+      ++pos;
+      if (read_number(str, length, pos, value) != 2 || value > 59 ||
+          !add_scaled(total_ms, value, scale)) {
+        return false;
+      }
+    }
+
+    if (pos < length && str[pos] == '.') {
+      ++pos;
+      int64_t fraction = 0;
+      if (!read_fraction(str, length, pos, fraction) ||
+          !add_scaled(total_ms, fraction, 1)) {
+        return false;
+      }
+    }
+    return pos == length;
+  }
+
+  /**
+   * @brief Reads an ISO 8601 duration after its leading 'P'
+   */
+  static auto parse_iso_duration(const char* str, const size_t length,
+                                 int64_t& total_ms) noexcept -> bool {
+    // Designators in the order they must appear, the date part first
+    static constexpr std::array<char, 5> DESIGNATORS{'W', 'D', 'H', 'M', 'S'};
+    static constexpr std::array<int64_t, 5> SCALES{
+        MS_PER_WEEK, MS_PER_DAY, MS_PER_HOUR, MS_PER_MINUTE, MS_PER_SECOND};
+    static constexpr size_t FIRST_TIME_DESIGNATOR = 2;
+
+    total_ms = 0;
+    size_t pos = 0;
+    size_t next = 0;  // First designator still allowed
+    bool time = false;
+    bool pending = true;  // Waiting for a component after 'P' or 'T'
+    while (pos < length) {
+      if (str[pos] == 'T') {
+        if (time || next > FIRST_TIME_DESIGNATOR) {
+          return false;
+        }
+        time = true;
+        pending = true;
+        next = FIRST_TIME_DESIGNATOR;
+        ++pos;
+        continue;
+      }
+
+      int64_t value = 0;
+      if (read_number(str, length, pos, value) == 0) {
+        return false;
+      }
+      int64_t fraction = 0;
+      bool has_fraction = false;
+      if (pos < length && (str[pos] == '.' || str[pos] == ',')) {
+        ++pos;
+        has_fraction = true;
+        if (!read_fraction(str, length, pos, fraction)) {
+          return false;
+        }
+      }
+      if (pos == length) {
+        return false;
+      }
+
+      // Find the designator among the ones allowed in this part
+      const size_t first = time ? FIRST_TIME_DESIGNATOR : next;
+      const size_t last = time ? DESIGNATORS.size() : FIRST_TIME_DESIGNATOR;
+      size_t index = std::max(first, next);
+      while (index < last && DESIGNATORS[index] != str[pos]) {
+        ++index;
+      }
+      if (index == last || (has_fraction && DESIGNATORS[index] != 'S') ||
+          !add_scaled(total_ms, value, SCALES[index]) ||
+          !add_scaled(total_ms, fraction, 1)) {
+        return false;
+      }
+      next = index + 1;
+      pending = false;
+      ++pos;
+    }
+    return !pending;
   }
 };
+
+/** @brief Millisecond TimeDelta used by DateTime and the C interface */
+using TimeDelta = BasicTimeDelta<std::chrono::milliseconds>;
+
+/** @brief TimeDelta of whole seconds in 32 bits, used by CompactDateTime */
+using CompactTimeDelta = BasicTimeDelta<std::chrono::duration<int32_t>>;
+
+/** @brief Microsecond TimeDelta, used by PreciseDateTime */
+using PreciseTimeDelta = BasicTimeDelta<std::chrono::microseconds>;
@@ -0,0 +1,25 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "DateTime.hpp"
+
+// Parsing and formatting members for code that includes only
+// DateTimeCore.hpp
+template class BasicDateTime<std::chrono::milliseconds>;
+template class BasicDateTime<std::chrono::duration<int32_t>, 2000>;
+template class BasicDateTime<std::chrono::microseconds>;
@@ -0,0 +1,141 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <cstdint>
+#include <string>
+
+#include "FDateError.hpp"
+#include "NetCDFTimeReader.hpp"
+
+extern "C" {
+
+//=============================================================================
+// NetCDF time variable functions
+//=============================================================================
+
+/**
+ * @brief Open the time variable of a NetCDF file
+ *
+ * @param filename Path of the NetCDF file
+ * @param filename_len Length of the path
+ * @param variable Name of the time variable
+ * @param variable_len Length of the name
+ * @param chunk_size Number of values read from the file at a time, 0 for the
+ * default
+ * @return void* Handle to the reader, nullptr if the file or variable could
+ * not be opened
+ */
+auto f_datetime_netcdf_open(const char* filename, const int filename_len,
+                            const char* variable, const int variable_len,
+                            const int chunk_size) -> void* {
+  if (filename == nullptr || filename_len <= 0 || variable == nullptr ||
+      variable_len <= 0 || chunk_size < 0) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid NetCDF filename, variable or chunk size");
+    return nullptr;
+  }
+
+  try {
+    auto* reader = new NetCDFTimeReader(
+        std::string(filename, static_cast<size_t>(filename_len)),
+        std::string(variable, static_cast<size_t>(variable_len)),
+        static_cast<size_t>(chunk_size));
+    if (!reader->valid()) {
+      FDateError::set(e_FDateError::IO, reader->error().data(),
+                      reader->error().size());
+      delete reader;
+      return nullptr;
+    }
+    return reader;
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Close a NetCDF time variable reader
+ *
+ * @param handle Handle created by f_datetime_netcdf_open (may be nullptr)
+ */
+void f_datetime_netcdf_close(void* handle) {
+  delete static_cast<NetCDFTimeReader*>(handle);
+}
+
+/**
+ * @brief Get the number of values of a NetCDF time variable
+ *
+ * @param handle Handle created by f_datetime_netcdf_open
+ * @return int64_t Length of the time dimension, 0 for a null handle
+ */
+auto f_datetime_netcdf_size(const void* handle) -> int64_t {
+  if (handle == nullptr) {
+    return 0;
+  }
+  return static_cast<int64_t>(
+      static_cast<const NetCDFTimeReader*>(handle)->size());
+}
+
+/**
+ * @brief Get the units of a NetCDF time variable
+ *
+ * @param handle Handle created by f_datetime_netcdf_open
+ * @param unit_ms Output length of one unit in milliseconds
+ * @param epoch_ms Output reference date as milliseconds since epoch
+ * @return true if the handle is valid, false otherwise
+ */
+auto f_datetime_netcdf_units(const void* handle, int64_t* unit_ms,
+                             int64_t* epoch_ms) -> bool {
+  if (handle == nullptr || unit_ms == nullptr || epoch_ms == nullptr) {
+    return false;
+  }
+
+  const auto& units = static_cast<const NetCDFTimeReader*>(handle)->units();
+  *unit_ms = units.unit_milliseconds();
+  *epoch_ms = units.epoch().timestamp();
+  return true;
+}
+
+/**
+ * @brief Read a section of a NetCDF time variable as DateTimes
+ *
+ * The section is read in chunks of the size given to f_datetime_netcdf_open.
+ *
+ * @param handle Handle created by f_datetime_netcdf_open
+ * @param start Index of the first value, from 0
+ * @param count Number of values
+ * @param dt_ms Output array of DateTimes as milliseconds since epoch
+ * @return true if the values were read, false otherwise
+ */
+auto f_datetime_netcdf_read(void* handle, const int64_t start, const int count,
+                            int64_t* dt_ms) -> bool {
+  if (handle == nullptr || start < 0 || count < 0 || dt_ms == nullptr) {
+    return false;
+  }
+
+  auto* reader = static_cast<NetCDFTimeReader*>(handle);
+  if (!reader->read(static_cast<size_t>(start), static_cast<size_t>(count),
+                    dt_ms)) {
+    FDateError::set(e_FDateError::IO, reader->error().data(),
+                    reader->error().size());
+    return false;
+  }
+  return true;
+}
+
+}  // extern "C"
@@ -16,12 +16,247 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <cstdint>
 #include <cstring>
-#include <iostream>
+#include <limits>
+#include <memory>
 #include <string>
+#include <string_view>
+#include <vector>
 
+#include "AlarmSet.hpp"
+#include "CFTimeUnits.hpp"
+#include "CalendarKernels.hpp"
 #include "DateTime.hpp"
+#include "DateTimeFormatSet.hpp"
+#include "DateTimeIndex.hpp"
+#include "DateTimeRange.hpp"
+#include "DelimitedTimeReader.hpp"
+#include "FDateError.hpp"
+#include "FDateStats.hpp"
+#include "ModelClock.hpp"
+#include "ParallelBlocks.hpp"
+#include "TimeAxis.hpp"
+#include "datetime_wrapper.hpp"
+
+namespace {
+
+/**
+ * @brief Views a Fortran character argument in place
+ *
+ * @param str Start of the characters (need not be null terminated)
+ * @param length Number of characters, including any trailing blanks
+ * @return std::string_view The characters without trailing blanks
+ */
+auto trimmed_view(const char* str, size_t length) noexcept
+    -> std::string_view {
+  while (length > 0 && str[length - 1] == ' ') {
+    --length;
+  }
+  return {str, length};
+}
+
+/**
+ * @brief Converts a formatted length to the int used for Fortran lengths
+ *
+ * @param length Full length of a formatted string
+ * @return int The length, clamped to the largest int
+ */
+auto fortran_length(const size_t length) noexcept -> int {
+  constexpr auto max_length =
+      static_cast<size_t>(std::numeric_limits<int>::max());
+  return static_cast<int>(std::min(length, max_length));
+}
+
+/**
+ * @brief Parses a string with each format of a block of fixed-width formats
+ * in turn
+ *
+ * @param str The string to parse
+ * @param formats Contiguous array of formats, each width characters long and
+ * padded with blanks. Blank elements are skipped.
+ * @param width Width of each format
+ * @param count Number of formats
+ * @return int64_t Timestamp of the first successful parse, or
+ * INVALID_TIMESTAMP if every format fails
+ */
+auto strptime_format_block(const std::string_view str, const char* formats,
+                           const size_t width, const size_t count)
+    -> int64_t {
+  for (size_t i = 0; i < count; ++i) {
+    const auto format = trimmed_view(formats + i * width, width);
+    if (format.empty()) {
+      continue;
+    }
+    const auto date_time = DateTime::strptime(str, format);
+    if (date_time.valid()) {
+      return date_time.timestamp();
+    }
+  }
+  return DateTime::INVALID_TIMESTAMP;
+}
+
+/**
+ * @brief Parses elements [begin, end) of a block of fixed-width strings
+ *
+ * @param strs Contiguous array of strings, each str_len characters long
+ * @param str_len Length of each string
+ * @param format Compiled format
+ * @param begin First element to parse
+ * @param end One past the last element to parse
+ * @param dt_ms Output array of DateTimes, already set to INVALID_TIMESTAMP
+ * @param valid Output array of flags, already set to false
+ */
+void strptime_block(const char* strs, const size_t str_len,
+                    const DateTimeFormat& format, const size_t begin,
+                    const size_t end, int64_t* dt_ms, bool* valid) {
+  // Each element is parsed in place without being copied
+  for (size_t i = begin; i < end; ++i) {
+    const auto element = trimmed_view(strs + i * str_len, str_len);
+    if (element.empty()) {
+      continue;
+    }
+
+    const auto date_time = DateTime::strptime(element, format);
+    if (date_time.valid()) {
+      dt_ms[i] = date_time.timestamp();
+      valid[i] = true;
+    }
+  }
+}
+
+/**
+ * @brief Parses an array of fixed-width strings, optionally on OpenMP threads
+ *
+ * @see f_datetime_strptime_array
+ */
+void strptime_array(const char* strs, const int str_len, const int count,
+                    const char* format, const int format_len, int64_t* dt_ms,
+                    bool* valid, const bool parallel) {
+  if (count <= 0 || dt_ms == nullptr || valid == nullptr) {
+    return;
+  }
+
+  const auto count_t = static_cast<size_t>(count);
+  std::fill(dt_ms, dt_ms + count_t, DateTime::INVALID_TIMESTAMP);
+  std::fill(valid, valid + count_t, false);
+
+  if (str_len <= 0 || strs == nullptr || format_len <= 0 ||
+      format == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid string/format length or null string/format");
+    return;
+  }
+
+  try {
+    const auto str_len_t = static_cast<size_t>(str_len);
+    const auto format_len_t = static_cast<size_t>(format_len);
+    const DateTimeFormat format_cpp(std::string(format, format_len_t));
+
+    if (!parallel) {
+      strptime_block(strs, str_len_t, format_cpp, 0, count_t, dt_ms, valid);
+      return;
+    }
+
+    const bool success = ParallelBlocks::for_each_block(
+        count_t, 0, [&](const size_t begin, const size_t end) noexcept {
+          try {
+            strptime_block(strs, str_len_t, format_cpp, begin, end, dt_ms,
+                           valid);
+            return true;
+          } catch (...) {
+            return false;
+          }
+        });
+    if (success) {
+      return;
+    }
+  } catch (...) {
+    // Reported below along with a failed block
+  }
+
+  FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+  std::fill(dt_ms, dt_ms + count_t, DateTime::INVALID_TIMESTAMP);
+  std::fill(valid, valid + count_t, false);
+}
+
+/**
+ * @brief Formats an array of DateTimes, optionally on OpenMP threads
+ *
+ * @see f_datetime_strftime_array
+ */
+void strftime_array(const int64_t* dt_ms, const int count, const char* format,
+                    const int format_len, char* buffer, const int str_len,
+                    const bool milliseconds, const bool parallel) {
+  if (count <= 0) {
+    return;
+  }
+
+  if (dt_ms == nullptr || format_len <= 0 || format == nullptr ||
+      str_len <= 0 || buffer == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid format/buffer size or null array/format/buffer");
+    return;
+  }
+
+  const auto count_t = static_cast<size_t>(count);
+  const auto format_len_t = static_cast<size_t>(format_len);
+  const auto str_len_t = static_cast<size_t>(str_len);
+
+  try {
+    const DateTimeFormat format_cpp(std::string(format, format_len_t));
+    if (!parallel) {
+      DateTime::format_array_to(dt_ms, count_t, format_cpp, buffer, str_len_t,
+                                milliseconds);
+      return;
+    }
+
+    const bool success = ParallelBlocks::for_each_block(
+        count_t, 0, [&](const size_t begin, const size_t end) noexcept {
+          try {
+            DateTime::format_array_to(dt_ms + begin, end - begin, format_cpp,
+                                      buffer + begin * str_len_t, str_len_t,
+                                      milliseconds);
+            return true;
+          } catch (...) {
+            return false;
+          }
+        });
+    if (success) {
+      return;
+    }
+  } catch (...) {
+    // Reported below along with a failed block
+  }
+
+  FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+  std::fill(buffer, buffer + count_t * str_len_t, ' ');
+}
+
+/**
+ * @brief Writes a DateTime as a null terminated ISO 8601 string
+ *
+ * @tparam Milliseconds If true, the seconds are followed by ".mmm"
+ * @param date The DateTime
+ * @param buffer Output buffer, truncated to capacity - 1 characters
+ * @param capacity Size of the output buffer, at least 1
+ */
+template <bool Milliseconds>
+void write_iso_string(const DateTime& date, char* buffer,
+                      const size_t capacity) {
+  typename FixedDateTimeFormat<FixedIso, Milliseconds>::t_buffer iso;
+  if (date.format<FixedIso, Milliseconds>(iso)) {
+    const auto length = std::min(iso.size(), capacity - 1);
+    std::copy_n(iso.data(), length, buffer);
+    buffer[length] = '\0';
+    return;
+  }
+  date.format_to(buffer, capacity, FixedIso::PATTERN,
+                 sizeof(FixedIso::PATTERN) - 1, Milliseconds);
+}
+
+}  // namespace
 
 extern "C" {
 
@@ -246,18 +481,85 @@ auto f_timedelta_divide(const int64_t ts_ms, const int divisor) -> int64_t {
 void f_timedelta_to_string(const int64_t ts_ms, char* buffer,
                            const int buffer_size) {
   if (buffer_size <= 0 || buffer == nullptr) {
-    std::cerr << "[ERROR]: Invalid buffer size or null buffer\n";
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid buffer size or null buffer");
     return;
   }
 
-  const TimeDelta time_delta(TimeDelta::to_components(ts_ms));
-  const std::string str = time_delta.toString();
+  TimeDelta::fromMilliseconds(ts_ms).format_to(
+      buffer, static_cast<size_t>(buffer_size));
+}
 
-  const size_t copy_length =
-      std::min(static_cast<size_t>(buffer_size - 1), str.length());
+/**
+ * @brief Parse a TimeDelta from a string
+ *
+ * Accepts the "[Nd ]HH:MM:SS[.mmm]" form written by f_timedelta_to_string and
+ * ISO 8601 durations such as "P1DT2H30M"
+ *
+ * @param str String representation of a TimeDelta
+ * @param str_len Length of the string
+ * @param ts_ms Receives the TimeDelta as milliseconds, 0 if it is invalid
+ * @return bool True if the string was parsed
+ */
+auto f_timedelta_parse(const char* str, const int str_len, int64_t* ts_ms)
+    -> bool {
+  if (ts_ms == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT, "Null output pointer");
+    return false;
+  }
+  *ts_ms = 0;
+  if (str_len <= 0 || str == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid string length or null string");
+    return false;
+  }
 
-  strncpy(buffer, str.c_str(), copy_length);
-  buffer[copy_length] = '\0';
+  TimeDelta time_delta;
+  if (!TimeDelta::parse(str, static_cast<size_t>(str_len), time_delta)) {
+    FDateError::set(e_FDateError::PARSE, "Could not parse the string");
+    return false;
+  }
+  *ts_ms = time_delta.totalMilliseconds();
+  return true;
+}
+
+/**
+ * @brief Parse an array of TimeDeltas from fixed-width strings
+ *
+ * The strings are stored back to back, each str_len characters long, as a
+ * Fortran character array is. Entries that cannot be parsed are returned as
+ * 0 with valid set to false.
+ *
+ * @param strs Contiguous array of count strings
+ * @param str_len Length of each string
+ * @param count Number of strings
+ * @param ts_ms Output array of TimeDeltas as milliseconds
+ * @param valid Output array of flags set when an entry was parsed
+ */
+void f_timedelta_parse_array(const char* strs, const int str_len,
+                             const int count, int64_t* ts_ms, bool* valid) {
+  if (count <= 0 || ts_ms == nullptr || valid == nullptr) {
+    return;
+  }
+
+  const auto count_t = static_cast<size_t>(count);
+  std::fill(ts_ms, ts_ms + count_t, 0);
+  std::fill(valid, valid + count_t, false);
+
+  if (str_len <= 0 || strs == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid string length or null string");
+    return;
+  }
+
+  const auto str_len_t = static_cast<size_t>(str_len);
+  TimeDelta time_delta;
+  for (size_t i = 0; i < count_t; ++i) {
+    if (TimeDelta::parse(strs + i * str_len_t, str_len_t, time_delta)) {
+      ts_ms[i] = time_delta.totalMilliseconds();
+      valid[i] = true;
+    }
+  }
 }
 
 /**
@@ -382,29 +684,26 @@ auto f_datetime_now() -> int64_t { return DateTime::now().timestamp(); }
 auto f_datetime_strptime(const char* str, const char* format, const int str_len,
                          const int format_len) -> int64_t {
   // Cast the lengths coming from fortran over to size_t
-  if (str_len <= 0 || format == nullptr) {
-    return DateTime::INVALID_TIMESTAMP;
-  }
-
-  if (format_len <= 0 || str == nullptr) {
+  if (str_len <= 0 || format == nullptr || format_len <= 0 || str == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid string/format length or null string/format");
     return DateTime::INVALID_TIMESTAMP;
   }
 
   try {
-    const auto str_len_t = static_cast<size_t>(str_len);
-    const auto format_len_t = static_cast<size_t>(format_len);
-
-    // Create strings from Fortran character arrays
-    const std::string str_cpp(str, str_len_t);
-    const std::string format_cpp(format, format_len_t);
+    // The Fortran character arrays are read in place
+    const std::string_view str_view(str, static_cast<size_t>(str_len));
+    const std::string_view format_view(format, static_cast<size_t>(format_len));
 
-    const auto date_time = DateTime::strptime(str_cpp, format_cpp);
+    const auto date_time = DateTime::strptime(str_view, format_view);
     if (date_time.valid()) {
       return date_time.timestamp();
     } else {
+      FDateError::set(e_FDateError::PARSE, "Could not parse the string");
       return DateTime::INVALID_TIMESTAMP;
     }
   } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
     return DateTime::INVALID_TIMESTAMP;
   }
 }
@@ -486,6 +785,132 @@ auto f_datetime_get_millisecond(const int64_t dt_ms) -> int64_t {
   return date.millisecond();
 }
 
+/**
+ * @brief Get all date and time components from a DateTime in one call
+ *
+ * @param dt_ms DateTime as milliseconds since epoch
+ * @param year Year component
+ * @param month Month component (1-12)
+ * @param day Day component (1-31)
+ * @param hour Hour component (0-23)
+ * @param minute Minute component (0-59)
+ * @param second Second component (0-59)
+ * @param millisecond Millisecond component (0-999)
+ */
+void f_datetime_get_fields(const int64_t dt_ms, int* year, int* month, int* day,
+                           int* hour, int* minute, int* second,
+                           int* millisecond) {
+  if (year == nullptr || month == nullptr || day == nullptr ||
+      hour == nullptr || minute == nullptr || second == nullptr ||
+      millisecond == nullptr) {
+    return;
+  }
+
+  const auto fields = DateTime(dt_ms).to_fields();
+  *year = fields.year;
+  *month = static_cast<int>(fields.month);
+  *day = static_cast<int>(fields.day);
+  *hour = static_cast<int>(fields.hour);
+  *minute = static_cast<int>(fields.minute);
+  *second = static_cast<int>(fields.second);
+  *millisecond = static_cast<int>(fields.millisecond);
+}
+
+/**
+ * @brief Get the date and time components of an array of DateTimes
+ *
+ * Any output array may be null, in which case that component is skipped.
+ *
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes in the array
+ * @param year Output array of year components
+ * @param month Output array of month components (1-12)
+ * @param day Output array of day components (1-31)
+ * @param hour Output array of hour components (0-23)
+ * @param minute Output array of minute components (0-59)
+ * @param second Output array of second components (0-59)
+ * @param millisecond Output array of millisecond components (0-999)
+ */
+void f_datetime_get_fields_array(const int64_t* dt_ms, const int count,
+                                 int* year, int* month, int* day, int* hour,
+                                 int* minute, int* second, int* millisecond) {
+  if (count <= 0 || dt_ms == nullptr) {
+    return;
+  }
+
+  CalendarKernels::timestamps_to_fields(dt_ms, static_cast<size_t>(count),
+                                        year, month, day, hour, minute, second,
+                                        millisecond);
+}
+
+/**
+ * @brief Get the date and time components of an array of DateTimes on OpenMP
+ * threads
+ *
+ * Behaves as f_datetime_get_fields_array with the array split into blocks
+ * that are decomposed concurrently. Without OpenMP the blocks are decomposed
+ * in order.
+ *
+ * @see f_datetime_get_fields_array
+ */
+void f_datetime_get_fields_array_parallel(const int64_t* dt_ms,
+                                          const int count, int* year,
+                                          int* month, int* day, int* hour,
+                                          int* minute, int* second,
+                                          int* millisecond) {
+  if (count <= 0 || dt_ms == nullptr) {
+    return;
+  }
+
+  // Blocks are a whole number of kernel blocks so each thread stays on the
+  // vectorized path
+  constexpr size_t block_size = 64 * CalendarKernels::BLOCK_SIZE;
+  const auto at = [](int* field, const size_t begin) noexcept -> int* {
+    return field != nullptr ? field + begin : nullptr;
+  };
+  (void)ParallelBlocks::for_each_block(
+      static_cast<size_t>(count), block_size,
+      [&](const size_t begin, const size_t end) noexcept {
+        CalendarKernels::timestamps_to_fields(
+            dt_ms + begin, end - begin, at(year, begin), at(month, begin),
+            at(day, begin), at(hour, begin), at(minute, begin),
+            at(second, begin), at(millisecond, begin));
+        return true;
+      });
+}
+
+/**
+ * @brief Create an array of DateTimes from arrays of components
+ *
+ * Each element is validated in the same way as f_datetime_create. The hour,
+ * minute, second and millisecond arrays may be null, in which case they are
+ * taken as zero.
+ *
+ * @param year Array of years
+ * @param month Array of months (1-12)
+ * @param day Array of days (1-31)
+ * @param hour Array of hours (0-23)
+ * @param minute Array of minutes (0-59)
+ * @param second Array of seconds (0-59)
+ * @param millisecond Array of milliseconds (0-999)
+ * @param count Number of elements in each array
+ * @param dt_ms Output array of DateTimes as milliseconds since epoch, set to
+ * INVALID_TIMESTAMP where a component is out of range
+ */
+void f_datetime_create_array(const int* year, const int* month, const int* day,
+                             const int* hour, const int* minute,
+                             const int* second, const int* millisecond,
+                             const int count, int64_t* dt_ms) {
+  if (count <= 0 || dt_ms == nullptr || year == nullptr || month == nullptr ||
+      day == nullptr) {
+    return;
+  }
+
+  CalendarKernels::fields_to_timestamps(year, month, day, hour, minute, second,
+                                        millisecond,
+                                        static_cast<size_t>(count), dt_ms);
+}
+
 /**
  * @brief Get the Julian Day Number (JDN) for a DateTime
  *
@@ -519,6 +944,219 @@ auto f_datetime_get_julian_century(const int64_t dt_ms) -> double {
   return date.julianCentury();
 }
 
+/**
+ * @brief Get the Julian Day (JD) for an array of DateTimes
+ *
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes in the array
+ * @param jd Output array of Julian Days, identical to f_datetime_get_julian_day
+ */
+void f_datetime_get_julian_day_array(const int64_t* dt_ms, const int count,
+                                     double* jd) {
+  if (count <= 0 || dt_ms == nullptr || jd == nullptr) {
+    return;
+  }
+  CalendarKernels::julian_days(dt_ms, static_cast<size_t>(count), jd);
+}
+
+/**
+ * @brief Get the Julian Century (JC) for an array of DateTimes
+ *
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes in the array
+ * @param jc Output array of Julian Centuries, identical to
+ * f_datetime_get_julian_century
+ */
+void f_datetime_get_julian_century_array(const int64_t* dt_ms, const int count,
+                                         double* jc) {
+  if (count <= 0 || dt_ms == nullptr || jc == nullptr) {
+    return;
+  }
+  CalendarKernels::julian_centuries(dt_ms, static_cast<size_t>(count), jc);
+}
+
+/**
+ * @brief Round a DateTime down to a whole number of intervals
+ *
+ * @param dt_ms DateTime as milliseconds since epoch
+ * @param interval_ms Length of the interval in milliseconds
+ * @param origin_ms Time the intervals are counted from, as milliseconds since
+ * epoch
+ * @return int64_t Rounded DateTime as milliseconds since epoch, or
+ * INVALID_TIMESTAMP if the DateTime is invalid or the interval is not positive
+ */
+auto f_datetime_floor(const int64_t dt_ms, const int64_t interval_ms,
+                      const int64_t origin_ms) -> int64_t {
+  return DateTime(dt_ms)
+      .floor(TimeDelta::fromMilliseconds(interval_ms), DateTime(origin_ms))
+      .timestamp();
+}
+
+/**
+ * @brief Round a DateTime up to a whole number of intervals
+ *
+ * @see f_datetime_floor
+ */
+auto f_datetime_ceil(const int64_t dt_ms, const int64_t interval_ms,
+                     const int64_t origin_ms) -> int64_t {
+  return DateTime(dt_ms)
+      .ceil(TimeDelta::fromMilliseconds(interval_ms), DateTime(origin_ms))
+      .timestamp();
+}
+
+/**
+ * @brief Round a DateTime to the nearest whole number of intervals, upwards
+ * from the middle
+ *
+ * @see f_datetime_floor
+ */
+auto f_datetime_round(const int64_t dt_ms, const int64_t interval_ms,
+                      const int64_t origin_ms) -> int64_t {
+  return DateTime(dt_ms)
+      .round(TimeDelta::fromMilliseconds(interval_ms), DateTime(origin_ms))
+      .timestamp();
+}
+
+/**
+ * @brief Round a DateTime down to the start of a calendar month
+ *
+ * @param dt_ms DateTime as milliseconds since epoch
+ * @param months Number of months per bin, counted from January of year 0
+ * (3 for quarters, 12 for years)
+ * @return int64_t Start of the bin as milliseconds since epoch, or
+ * INVALID_TIMESTAMP if the DateTime is invalid or months is not positive
+ */
+auto f_datetime_floor_to_month(const int64_t dt_ms, const int months)
+    -> int64_t {
+  if (months <= 0) {
+    return DateTime::INVALID_TIMESTAMP;
+  }
+  return DateTime(dt_ms)
+      .floor_to_month(static_cast<unsigned>(months))
+      .timestamp();
+}
+
+/**
+ * @brief Round a DateTime up to the start of a calendar month
+ *
+ * @see f_datetime_floor_to_month
+ */
+auto f_datetime_ceil_to_month(const int64_t dt_ms, const int months)
+    -> int64_t {
+  if (months <= 0) {
+    return DateTime::INVALID_TIMESTAMP;
+  }
+  return DateTime(dt_ms)
+      .ceil_to_month(static_cast<unsigned>(months))
+      .timestamp();
+}
+
+/**
+ * @brief Round an array of DateTimes to whole numbers of an interval
+ *
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes in the array
+ * @param interval_ms Length of the interval in milliseconds
+ * @param origin_ms Time the intervals are counted from, as milliseconds since
+ * epoch
+ * @param rounding 0 to round down, 1 to round up, 2 to the nearest
+ * @param aligned_ms Output array of rounded DateTimes, identical to
+ * f_datetime_floor, f_datetime_ceil and f_datetime_round
+ */
+void f_datetime_round_array(const int64_t* dt_ms, const int count,
+                            const int64_t interval_ms, const int64_t origin_ms,
+                            const int rounding, int64_t* aligned_ms) {
+  if (count <= 0 || dt_ms == nullptr || aligned_ms == nullptr) {
+    return;
+  }
+  if (rounding < 0 ||
+      rounding > static_cast<int>(CalendarKernels::e_Rounding::NEAREST)) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT, "Unknown rounding");
+    std::fill(aligned_ms, aligned_ms + count, DateTime::INVALID_TIMESTAMP);
+    return;
+  }
+  CalendarKernels::round_to_interval(
+      dt_ms, static_cast<size_t>(count), interval_ms, origin_ms,
+      static_cast<CalendarKernels::e_Rounding>(rounding), aligned_ms);
+}
+
+/**
+ * @brief Round an array of DateTimes down to the start of calendar months
+ *
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes in the array
+ * @param months Number of months per bin, counted from January of year 0
+ * @param aligned_ms Output array of bin starts, identical to
+ * f_datetime_floor_to_month
+ */
+void f_datetime_floor_to_month_array(const int64_t* dt_ms, const int count,
+                                     const int months, int64_t* aligned_ms) {
+  if (count <= 0 || dt_ms == nullptr || aligned_ms == nullptr) {
+    return;
+  }
+  CalendarKernels::floor_to_months(dt_ms, static_cast<size_t>(count),
+                                   static_cast<unsigned>(std::max(months, 0)),
+                                   aligned_ms);
+}
+
+/**
+ * @brief Split a sorted array of DateTimes into bins of an interval
+ *
+ * A bin starts wherever the rounded down DateTime changes, so each bin of a
+ * sorted array is a contiguous run of elements in one interval.
+ *
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes in the array
+ * @param interval_ms Length of the interval in milliseconds
+ * @param origin_ms Time the intervals are counted from, as milliseconds since
+ * epoch
+ * @param starts Output array of count indices, from 0, of the first element
+ * of each bin
+ * @param bin_ms Output array of count bin start times as milliseconds since
+ * epoch
+ * @return int Number of bins written to starts and bin_ms
+ */
+auto f_datetime_bin_by_interval(const int64_t* dt_ms, const int count,
+                                const int64_t interval_ms,
+                                const int64_t origin_ms, int* starts,
+                                int64_t* bin_ms) -> int {
+  if (count <= 0 || dt_ms == nullptr || starts == nullptr ||
+      bin_ms == nullptr) {
+    return 0;
+  }
+
+  return static_cast<int>(CalendarKernels::bin_by_interval(
+      dt_ms, static_cast<size_t>(count), interval_ms, origin_ms, starts,
+      bin_ms));
+}
+
+/**
+ * @brief Split a sorted array of DateTimes into bins of calendar months
+ *
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes in the array
+ * @param months Number of months per bin, counted from January of year 0
+ * @param starts Output array of count indices, from 0, of the first element
+ * of each bin
+ * @param bin_ms Output array of count bin start times as milliseconds since
+ * epoch
+ * @return int Number of bins written to starts and bin_ms
+ *
+ * @see f_datetime_bin_by_interval
+ */
+auto f_datetime_bin_by_month(const int64_t* dt_ms, const int count,
+                             const int months, int* starts, int64_t* bin_ms)
+    -> int {
+  if (count <= 0 || dt_ms == nullptr || starts == nullptr ||
+      bin_ms == nullptr) {
+    return 0;
+  }
+
+  return static_cast<int>(CalendarKernels::bin_by_months(
+      dt_ms, static_cast<size_t>(count),
+      static_cast<unsigned>(std::max(months, 0)), starts, bin_ms));
+}
+
 /**
  * @brief Add a TimeDelta to a DateTime
  *
@@ -562,58 +1200,196 @@ auto f_datetime_difference(const int64_t dt1_ms, const int64_t dt2_ms)
 }
 
 /**
- * @brief Format a DateTime to a string
+ * @brief Add TimeDeltas to an array of DateTimes
  *
- * @param dt_ms DateTime as milliseconds since epoch
- * @param format Format string (similar to strftime)
- * @param buffer Output buffer for the string
- * @param format_len Length of the format string
- * @param buffer_size Size of the output buffer
+ * A stride of 0 uses the first element for every result, so an array can be
+ * combined with a single value without expanding it.
+ *
+ * @param dt_ms DateTimes as milliseconds since epoch
+ * @param dt_stride Step between DateTimes (0 or 1)
+ * @param ts_ms TimeDeltas as milliseconds
+ * @param ts_stride Step between TimeDeltas (0 or 1)
+ * @param count Number of results
+ * @param result Output array of count DateTimes as milliseconds since epoch,
+ * identical to f_datetime_add_timedelta element by element
  */
-void f_datetime_strftime(const int64_t dt_ms, const char* format, char* buffer,
-                         const int format_len, const int buffer_size) {
-  if (format_len <= 0 || buffer_size <= 0 || format == nullptr ||
-      buffer == nullptr) {
-    std::cerr << "[ERROR]: Invalid format/buffer size or null buffer/format\n";
+void f_datetime_add_timedelta_array(const int64_t* dt_ms, const int dt_stride,
+                                    const int64_t* ts_ms, const int ts_stride,
+                                    const int count, int64_t* result) {
+  if (count <= 0 || dt_ms == nullptr || ts_ms == nullptr ||
+      result == nullptr) {
     return;
   }
 
-  const auto format_len_t = static_cast<size_t>(format_len);
-  const auto buffer_size_t = static_cast<size_t>(buffer_size);
-
-  const DateTime date(dt_ms);
-  const std::string format_cpp(format, format_len_t);
-  const std::string str = date.strftime(format_cpp);
-  strncpy(buffer, str.c_str(), buffer_size_t - 1);
-  buffer[buffer_size_t - 1] = '\0';
+  const auto dt_step = static_cast<size_t>(dt_stride != 0);
+  const auto ts_step = static_cast<size_t>(ts_stride != 0);
+  for (size_t i = 0; i < static_cast<size_t>(count); ++i) {
+    const DateTime date(dt_ms[i * dt_step]);
+    const TimeDelta time_delta(TimeDelta::to_components(ts_ms[i * ts_step]));
+    result[i] = (date + time_delta).timestamp();
+  }
 }
 
 /**
- * @brief Format a DateTime to a string with milliseconds
+ * @brief Subtract TimeDeltas from an array of DateTimes
  *
- * @param dt_ms DateTime as milliseconds since epoch
- * @param format Format string (similar to strftime)
- * @param buffer Output buffer for the string
- * @param format_len Length of the format string
- * @param buffer_size Size of the output buffer
+ * A stride of 0 uses the first element for every result, so an array can be
+ * combined with a single value without expanding it.
+ *
+ * @param dt_ms DateTimes as milliseconds since epoch
+ * @param dt_stride Step between DateTimes (0 or 1)
+ * @param ts_ms TimeDeltas as milliseconds
+ * @param ts_stride Step between TimeDeltas (0 or 1)
+ * @param count Number of results
+ * @param result Output array of count DateTimes as milliseconds since epoch,
+ * identical to f_datetime_subtract_timedelta element by element
  */
-void f_datetime_strftime_milliseconds(const int64_t dt_ms, const char* format,
-                                      char* buffer, const int format_len,
-                                      const int buffer_size) {
-  if (format_len <= 0 || buffer_size <= 0 || format == nullptr ||
-      buffer == nullptr) {
-    std::cerr << "[ERROR]: Invalid format/buffer size or null format/buffer\n";
+void f_datetime_subtract_timedelta_array(const int64_t* dt_ms,
+                                         const int dt_stride,
+                                         const int64_t* ts_ms,
+                                         const int ts_stride, const int count,
+                                         int64_t* result) {
+  if (count <= 0 || dt_ms == nullptr || ts_ms == nullptr ||
+      result == nullptr) {
+    return;
+  }
+
+  const auto dt_step = static_cast<size_t>(dt_stride != 0);
+  const auto ts_step = static_cast<size_t>(ts_stride != 0);
+  for (size_t i = 0; i < static_cast<size_t>(count); ++i) {
+    const DateTime date(dt_ms[i * dt_step]);
+    const TimeDelta time_delta(TimeDelta::to_components(ts_ms[i * ts_step]));
+    result[i] = (date - time_delta).timestamp();
+  }
+}
+
+/**
+ * @brief Calculate the differences between arrays of DateTimes
+ *
+ * A stride of 0 uses the first element for every result, so an array can be
+ * combined with a single value without expanding it.
+ *
+ * @param dt1_ms First DateTimes as milliseconds since epoch
+ * @param dt1_stride Step between first DateTimes (0 or 1)
+ * @param dt2_ms Second DateTimes as milliseconds since epoch
+ * @param dt2_stride Step between second DateTimes (0 or 1)
+ * @param count Number of results
+ * @param result Output array of count TimeDeltas as milliseconds, identical to
+ * f_datetime_difference element by element
+ */
+void f_datetime_difference_array(const int64_t* dt1_ms, const int dt1_stride,
+                                 const int64_t* dt2_ms, const int dt2_stride,
+                                 const int count, int64_t* result) {
+  if (count <= 0 || dt1_ms == nullptr || dt2_ms == nullptr ||
+      result == nullptr) {
     return;
   }
 
+  const auto dt1_step = static_cast<size_t>(dt1_stride != 0);
+  const auto dt2_step = static_cast<size_t>(dt2_stride != 0);
+  for (size_t i = 0; i < static_cast<size_t>(count); ++i) {
+    const DateTime dt1(dt1_ms[i * dt1_step]);
+    const DateTime dt2(dt2_ms[i * dt2_step]);
+    result[i] = (dt1 - dt2).totalMilliseconds();
+  }
+}
+
+/**
+ * @brief Parse an array of DateTimes from fixed-width strings using one format
+ *
+ * The strings are stored back to back, each occupying str_len characters, as
+ * in a Fortran character(len=str_len) array. Trailing blanks in each element
+ * are ignored. The format is compiled once and reused for every element.
+ *
+ * @param strs Contiguous array of count strings, each str_len characters long
+ * @param str_len Length of each string in the array
+ * @param count Number of strings in the array
+ * @param format Format string (similar to strftime), or "auto"
+ * @param format_len Length of the format string
+ * @param dt_ms Output array of count DateTimes as milliseconds since epoch.
+ * Elements that fail to parse are set to INVALID_TIMESTAMP.
+ * @param valid Output array of count flags set to true for elements that
+ * parsed successfully
+ */
+void f_datetime_strptime_array(const char* strs, const int str_len,
+                               const int count, const char* format,
+                               const int format_len, int64_t* dt_ms,
+                               bool* valid) {
+  strptime_array(strs, str_len, count, format, format_len, dt_ms, valid,
+                 false);
+}
+
+/**
+ * @brief Parse an array of DateTimes from fixed-width strings on OpenMP threads
+ *
+ * Behaves as f_datetime_strptime_array with the array split into blocks that
+ * are parsed concurrently. Without OpenMP the blocks are parsed in order.
+ *
+ * @see f_datetime_strptime_array
+ */
+void f_datetime_strptime_array_parallel(const char* strs, const int str_len,
+                                        const int count, const char* format,
+                                        const int format_len, int64_t* dt_ms,
+                                        bool* valid) {
+  strptime_array(strs, str_len, count, format, format_len, dt_ms, valid, true);
+}
+
+/**
+ * @brief Format a DateTime to a string
+ *
+ * @param dt_ms DateTime as milliseconds since epoch
+ * @param format Format string (similar to strftime)
+ * @param buffer Output buffer for the string
+ * @param format_len Length of the format string
+ * @param buffer_size Size of the output buffer
+ * @return int Full length of the formatted string, not counting the null
+ * terminator. The output was truncated if this is at least buffer_size. 0 if
+ * the arguments are invalid.
+ */
+auto f_datetime_strftime(const int64_t dt_ms, const char* format, char* buffer,
+                         const int format_len, const int buffer_size) -> int {
+  if (format_len <= 0 || buffer_size <= 0 || format == nullptr ||
+      buffer == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid format/buffer size or null buffer/format");
+    return 0;
+  }
+
+  const auto format_len_t = static_cast<size_t>(format_len);
+  const auto buffer_size_t = static_cast<size_t>(buffer_size);
+
+  const DateTime date(dt_ms);
+  return fortran_length(
+      date.format_to(buffer, buffer_size_t, format, format_len_t, false));
+}
+
+/**
+ * @brief Format a DateTime to a string with milliseconds
+ *
+ * @param dt_ms DateTime as milliseconds since epoch
+ * @param format Format string (similar to strftime)
+ * @param buffer Output buffer for the string
+ * @param format_len Length of the format string
+ * @param buffer_size Size of the output buffer
+ * @return int Full length of the formatted string
+ * @see f_datetime_strftime
+ */
+auto f_datetime_strftime_milliseconds(const int64_t dt_ms, const char* format,
+                                      char* buffer, const int format_len,
+                                      const int buffer_size) -> int {
+  if (format_len <= 0 || buffer_size <= 0 || format == nullptr ||
+      buffer == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid format/buffer size or null format/buffer");
+    return 0;
+  }
+
   const auto format_len_t = static_cast<size_t>(format_len);
   const auto buffer_size_t = static_cast<size_t>(buffer_size);
 
   const DateTime date(dt_ms);
-  const std::string format_cpp(format, format_len_t);
-  const std::string str = date.strftime_w_milliseconds(format_cpp);
-  strncpy(buffer, str.c_str(), buffer_size_t - 1);
-  buffer[buffer_size_t - 1] = '\0';
+  return fortran_length(
+      date.format_to(buffer, buffer_size_t, format, format_len_t, true));
 }
 
 /**
@@ -626,16 +1402,74 @@ void f_datetime_strftime_milliseconds(const int64_t dt_ms, const char* format,
 void f_datetime_to_iso_string(const int64_t dt_ms, char* buffer,
                               const int buffer_size) {
   if (buffer_size <= 0 || buffer == nullptr) {
-    std::cerr << "[ERROR]: Invalid buffer size or null buffer\n";
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid buffer size or null buffer");
     return;
   }
 
-  const auto buffer_size_t = static_cast<size_t>(buffer_size);
+  write_iso_string<false>(DateTime(dt_ms), buffer,
+                          static_cast<size_t>(buffer_size));
+}
 
-  const DateTime date(dt_ms);
-  const std::string str = date.to_iso_string();
-  strncpy(buffer, str.c_str(), buffer_size_t - 1);
-  buffer[buffer_size_t - 1] = '\0';
+/**
+ * @brief Convert a DateTime to ISO string format with milliseconds
+ *
+ * @param dt_ms DateTime as milliseconds since epoch
+ * @param buffer Output buffer for the string
+ * @param buffer_size Size of the output buffer
+ */
+void f_datetime_to_iso_string_msec(const int64_t dt_ms, char* buffer,
+                                   const int buffer_size) {
+  if (buffer_size <= 0 || buffer == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid buffer size or null buffer");
+    return;
+  }
+
+  write_iso_string<true>(DateTime(dt_ms), buffer,
+                         static_cast<size_t>(buffer_size));
+}
+
+/**
+ * @brief Format an array of DateTimes into a block of fixed-width strings
+ *
+ * Element i is written to buffer + i * str_len and padded with blanks, so the
+ * buffer can be a Fortran character(len=str_len) array. No null terminators
+ * are written. The format is compiled once and reused for every element.
+ *
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes in the array
+ * @param format Format string (similar to strftime)
+ * @param format_len Length of the format string
+ * @param buffer Output block of count * str_len characters
+ * @param str_len Width of each string in the output block
+ * @param milliseconds If true, seconds are written with milliseconds
+ */
+void f_datetime_strftime_array(const int64_t* dt_ms, const int count,
+                               const char* format, const int format_len,
+                               char* buffer, const int str_len,
+                               const bool milliseconds) {
+  strftime_array(dt_ms, count, format, format_len, buffer, str_len,
+                 milliseconds, false);
+}
+
+/**
+ * @brief Format an array of DateTimes into fixed-width strings on OpenMP
+ * threads
+ *
+ * Behaves as f_datetime_strftime_array with the array split into blocks that
+ * are formatted concurrently. Without OpenMP the blocks are formatted in
+ * order.
+ *
+ * @see f_datetime_strftime_array
+ */
+void f_datetime_strftime_array_parallel(const int64_t* dt_ms, const int count,
+                                        const char* format,
+                                        const int format_len, char* buffer,
+                                        const int str_len,
+                                        const bool milliseconds) {
+  strftime_array(dt_ms, count, format, format_len, buffer, str_len,
+                 milliseconds, true);
 }
 
 /**
@@ -716,20 +1550,25 @@ auto f_datetime_invalid_timestamp() -> int64_t {
 /**
  * @brief Parse a DateTime from a string using an array of format options
  *
+ * The formats are read in place from a Fortran character(len=format_len)
+ * array, so no per-call array of pointers or copies are needed. Trailing
+ * blanks in each format are ignored and blank formats are skipped.
+ *
  * @param str String representation of a DateTime
- * @param formats Array of format strings (similar to strftime)
+ * @param formats Contiguous array of num_formats format strings (similar to
+ * strftime), each format_len characters long
  * @param str_len Length of the string
- * @param formats_len Array of lengths for each format string
+ * @param format_len Width of each format string in the array
  * @param num_formats Number of format strings in the array
  * @return int64_t DateTime as milliseconds since epoch, or INVALID_TIMESTAMP if
  * all formats fail
  */
-auto f_datetime_strptime_with_formats(const char* str, const char** formats,
-                                      const int str_len, const int* formats_len,
+auto f_datetime_strptime_with_formats(const char* str, const char* formats,
+                                      const int str_len, const int format_len,
                                       const int num_formats) -> int64_t {
   // Enhanced input validation
   if (str_len <= 0 || str == nullptr || formats == nullptr ||
-      formats_len == nullptr || num_formats <= 0) {
+      format_len <= 0 || num_formats <= 0) {
     return DateTime::INVALID_TIMESTAMP;
   }
 
@@ -744,31 +1583,18 @@ auto f_datetime_strptime_with_formats(const char* str, const char** formats,
   }
 
   try {
-    const auto str_len_t = static_cast<size_t>(str_len);
-    const std::string str_cpp(str, str_len_t);
-
-    // Try each format until one succeeds
-    for (int i = 0; i < num_formats; ++i) {
-      if (formats[i] == nullptr || formats_len[i] <= 0) {
-        continue;
-      }
-
-      // Validate individual format length to prevent excessive memory usage
-      if (formats_len[i] > 1000) {
-        continue;
-      }
-
-      const auto format_len_t = static_cast<size_t>(formats_len[i]);
-      const std::string format_cpp(formats[i], format_len_t);
-
-      const auto date_time = DateTime::strptime(str_cpp, format_cpp);
-      if (date_time.valid()) {
-        return date_time.timestamp();
-      }
+    const std::string_view str_view(str, static_cast<size_t>(str_len));
+    const auto timestamp = strptime_format_block(
+        str_view, formats, static_cast<size_t>(format_len),
+        static_cast<size_t>(num_formats));
+    if (timestamp != DateTime::INVALID_TIMESTAMP) {
+      return timestamp;
     }
 
+    FDateError::set(e_FDateError::PARSE, "Could not parse the string");
     return DateTime::INVALID_TIMESTAMP;
   } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
     return DateTime::INVALID_TIMESTAMP;
   }
 }
@@ -778,55 +1604,1504 @@ auto f_datetime_strptime_with_formats(const char* str, const char** formats,
  * custom formats
  *
  * @param str String representation of a DateTime
- * @param fallback_formats Array of fallback format strings to try after
- * auto-detection fails
+ * @param fallback_formats Contiguous array of num_formats fallback format
+ * strings, each format_len characters long, tried after auto-detection fails
+ * (may be nullptr if num_formats is 0)
  * @param str_len Length of the string
- * @param formats_len Array of lengths for each fallback format string
+ * @param format_len Width of each fallback format string in the array
  * @param num_formats Number of fallback format strings in the array
  * @return int64_t DateTime as milliseconds since epoch, or INVALID_TIMESTAMP if
  * all attempts fail
+ * @see f_datetime_strptime_with_formats
  */
 auto f_datetime_strptime_auto_with_fallback(const char* str,
-                                            const char** fallback_formats,
+                                            const char* fallback_formats,
                                             const int str_len,
-                                            const int* formats_len,
+                                            const int format_len,
                                             const int num_formats) -> int64_t {
   if (str_len <= 0 || str == nullptr) {
     return DateTime::INVALID_TIMESTAMP;
   }
 
   try {
-    const auto str_len_t = static_cast<size_t>(str_len);
-    const std::string str_cpp(str, str_len_t);
+    const std::string_view str_view(str, static_cast<size_t>(str_len));
 
     // First try automatic format detection
-    const auto date_time = DateTime::strptime(str_cpp, "auto");
+    const auto date_time = DateTime::strptime(str_view, "auto");
     if (date_time.valid()) {
       return date_time.timestamp();
     }
 
     // If auto-detection failed and we have fallback formats, try them
-    if (fallback_formats != nullptr && formats_len != nullptr &&
-        num_formats > 0) {
-      for (int i = 0; i < num_formats; ++i) {
-        if (fallback_formats[i] == nullptr || formats_len[i] <= 0) {
-          continue;
-        }
+    if (fallback_formats != nullptr && format_len > 0 && num_formats > 0) {
+      const auto timestamp = strptime_format_block(
+          str_view, fallback_formats, static_cast<size_t>(format_len),
+          static_cast<size_t>(num_formats));
+      if (timestamp != DateTime::INVALID_TIMESTAMP) {
+        return timestamp;
+      }
+    }
 
-        const auto format_len_t = static_cast<size_t>(formats_len[i]);
-        const std::string format_cpp(fallback_formats[i], format_len_t);
+    FDateError::set(e_FDateError::PARSE, "Could not parse the string");
+    return DateTime::INVALID_TIMESTAMP;
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return DateTime::INVALID_TIMESTAMP;
+  }
+}
 
-        const auto fallback_date_time = DateTime::strptime(str_cpp, format_cpp);
-        if (fallback_date_time.valid()) {
-          return fallback_date_time.timestamp();
-        }
-      }
+//=============================================================================
+// DateTimeFormat functions
+//=============================================================================
+
+/**
+ * @brief Compile a format string into a reusable DateTimeFormat handle
+ *
+ * @param format Format string (similar to strftime), or "auto"
+ * @param format_len Length of the format string
+ * @return void* Handle to the compiled format, or nullptr on failure. The
+ * handle must be released with f_datetime_format_destroy.
+ */
+auto f_datetime_format_create(const char* format, const int format_len)
+    -> void* {
+  if (format_len <= 0 || format == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid format length or null format");
+    return nullptr;
+  }
+
+  try {
+    const auto format_len_t = static_cast<size_t>(format_len);
+    return new DateTimeFormat(std::string(format, format_len_t));
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Release a DateTimeFormat handle
+ *
+ * @param handle Handle created by f_datetime_format_create (may be nullptr)
+ */
+void f_datetime_format_destroy(void* handle) {
+  delete static_cast<DateTimeFormat*>(handle);
+}
+
+/**
+ * @brief Parse a DateTime from a string using a compiled format
+ *
+ * @param str String representation of a DateTime
+ * @param handle Handle created by f_datetime_format_create
+ * @param str_len Length of the string
+ * @return int64_t DateTime as milliseconds since epoch, or INVALID_TIMESTAMP if
+ * parsing fails
+ */
+auto f_datetime_strptime_compiled(const char* str, const void* handle,
+                                  const int str_len) -> int64_t {
+  if (str_len <= 0 || str == nullptr || handle == nullptr) {
+    return DateTime::INVALID_TIMESTAMP;
+  }
+
+  try {
+    const std::string_view str_view(str, static_cast<size_t>(str_len));
+    const auto& format = *static_cast<const DateTimeFormat*>(handle);
+
+    const auto date_time = DateTime::strptime(str_view, format);
+    if (date_time.valid()) {
+      return date_time.timestamp();
+    } else {
+      FDateError::set(e_FDateError::PARSE, "Could not parse the string");
+      return DateTime::INVALID_TIMESTAMP;
     }
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return DateTime::INVALID_TIMESTAMP;
+  }
+}
+
+/**
+ * @brief Format a DateTime to a string using a compiled format
+ *
+ * @param dt_ms DateTime as milliseconds since epoch
+ * @param handle Handle created by f_datetime_format_create
+ * @param buffer Output buffer for the string
+ * @param buffer_size Size of the output buffer
+ * @return int Full length of the formatted string
+ * @see f_datetime_strftime
+ */
+auto f_datetime_strftime_compiled(const int64_t dt_ms, const void* handle,
+                                  char* buffer, const int buffer_size) -> int {
+  if (buffer_size <= 0 || handle == nullptr || buffer == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid buffer size or null buffer/format");
+    return 0;
+  }
+
+  const auto buffer_size_t = static_cast<size_t>(buffer_size);
+
+  const DateTime date(dt_ms);
+  const auto& format = *static_cast<const DateTimeFormat*>(handle);
+  return fortran_length(
+      date.format_to(buffer, buffer_size_t, format, false));
+}
+
+/**
+ * @brief Format a DateTime to a string with milliseconds using a compiled
+ * format
+ *
+ * @param dt_ms DateTime as milliseconds since epoch
+ * @param handle Handle created by f_datetime_format_create
+ * @param buffer Output buffer for the string
+ * @param buffer_size Size of the output buffer
+ * @return int Full length of the formatted string
+ * @see f_datetime_strftime
+ */
+auto f_datetime_strftime_compiled_milliseconds(const int64_t dt_ms,
+                                               const void* handle, char* buffer,
+                                               const int buffer_size) -> int {
+  if (buffer_size <= 0 || handle == nullptr || buffer == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid buffer size or null buffer/format");
+    return 0;
+  }
+
+  const auto buffer_size_t = static_cast<size_t>(buffer_size);
+
+  const DateTime date(dt_ms);
+  const auto& format = *static_cast<const DateTimeFormat*>(handle);
+  return fortran_length(
+      date.format_to(buffer, buffer_size_t, format, true));
+}
+
+//=============================================================================
+// DateTimeFormatSet functions
+//=============================================================================
+
+/**
+ * @brief Create an empty DateTimeFormatSet
+ *
+ * @param order Order the formats are tried in: 0 in the order they were
+ * added, 1 with the last format that matched first, 2 by how often each
+ * format has matched
+ * @return void* Handle to the format set, or nullptr on failure. The handle
+ * must be released with f_datetime_format_set_destroy.
+ */
+auto f_datetime_format_set_create(const int order) -> void* {
+  if (order < 0 ||
+      order > static_cast<int>(DateTimeFormatSet::e_FormatOrder::HIT_COUNT)) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT, "Unknown format order");
+    return nullptr;
+  }
+
+  try {
+    return new DateTimeFormatSet(
+        static_cast<DateTimeFormatSet::e_FormatOrder>(order));
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Release a DateTimeFormatSet handle
+ *
+ * @param handle Handle created by f_datetime_format_set_create (may be
+ * nullptr)
+ */
+void f_datetime_format_set_destroy(void* handle) {
+  delete static_cast<DateTimeFormatSet*>(handle);
+}
+
+/**
+ * @brief Compile a format and add it to a DateTimeFormatSet
+ *
+ * @param handle Handle to the format set
+ * @param format Format string (similar to strftime), or "auto"
+ * @param format_len Length of the format string
+ * @return int Index of the format, from 0, or -1 on failure
+ */
+auto f_datetime_format_set_add(void* handle, const char* format,
+                               const int format_len) -> int {
+  if (handle == nullptr || format_len <= 0 || format == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Null format set, invalid format length or null format");
+    return DateTimeFormatSet::NO_MATCH;
+  }
+
+  try {
+    return static_cast<DateTimeFormatSet*>(handle)->add(
+        std::string(format, static_cast<size_t>(format_len)));
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return DateTimeFormatSet::NO_MATCH;
+  }
+}
+
+/**
+ * @brief Get the number of formats in a DateTimeFormatSet
+ *
+ * @param handle Handle to the format set
+ * @return int Number of formats, 0 for a null handle
+ */
+auto f_datetime_format_set_size(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  return static_cast<int>(
+      static_cast<const DateTimeFormatSet*>(handle)->size());
+}
 
+/**
+ * @brief Parse a DateTime with the formats of a DateTimeFormatSet
+ *
+ * The formats are tried in the current order of the set, which is then
+ * updated with the format that matched.
+ *
+ * @param handle Handle to the format set
+ * @param str String representation of a DateTime
+ * @param str_len Length of the string
+ * @param matched Output index of the format that matched, from 0, or -1 if
+ * none did (may be nullptr)
+ * @return int64_t DateTime as milliseconds since epoch, or INVALID_TIMESTAMP
+ * if no format matched
+ */
+auto f_datetime_format_set_parse(void* handle, const char* str,
+                                 const int str_len, int* matched) -> int64_t {
+  if (matched != nullptr) {
+    *matched = DateTimeFormatSet::NO_MATCH;
+  }
+  if (handle == nullptr || str_len <= 0 || str == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Null format set, invalid string length or null string");
     return DateTime::INVALID_TIMESTAMP;
+  }
+
+  try {
+    auto* format_set = static_cast<DateTimeFormatSet*>(handle);
+    const auto date_time =
+        format_set->parse(std::string_view(str, static_cast<size_t>(str_len)));
+    if (matched != nullptr) {
+      *matched = format_set->last_match();
+    }
+    if (!date_time.valid()) {
+      FDateError::set(e_FDateError::PARSE, "Could not parse the string");
+    }
+    return date_time.timestamp();
   } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
     return DateTime::INVALID_TIMESTAMP;
   }
 }
 
+/**
+ * @brief Parse an array of fixed-width strings with a DateTimeFormatSet
+ *
+ * Each element is parsed in place and the order of the set is updated after
+ * every element, so a block of strings written with the same format is
+ * parsed on the first try after its first element. Trailing blanks in each
+ * element are ignored and blank elements are left invalid.
+ *
+ * @param handle Handle to the format set
+ * @param strs Contiguous array of count strings, each str_len characters long
+ * @param str_len Length of each string
+ * @param count Number of strings
+ * @param dt_ms Output array of count DateTimes as milliseconds since epoch.
+ * Elements that fail to parse are set to INVALID_TIMESTAMP.
+ * @param valid Output array of count flags set to true for elements that
+ * parsed successfully
+ * @param matched Output array of count indices of the format that parsed
+ * each element, or -1 (may be nullptr)
+ */
+void f_datetime_format_set_parse_array(void* handle, const char* strs,
+                                       const int str_len, const int count,
+                                       int64_t* dt_ms, bool* valid,
+                                       int* matched) {
+  if (count <= 0 || dt_ms == nullptr || valid == nullptr) {
+    return;
+  }
+
+  const auto count_t = static_cast<size_t>(count);
+  std::fill(dt_ms, dt_ms + count_t, DateTime::INVALID_TIMESTAMP);
+  std::fill(valid, valid + count_t, false);
+  if (matched != nullptr) {
+    std::fill(matched, matched + count_t, DateTimeFormatSet::NO_MATCH);
+  }
+
+  if (handle == nullptr || str_len <= 0 || strs == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Null format set, invalid string length or null strings");
+    return;
+  }
+
+  try {
+    auto* format_set = static_cast<DateTimeFormatSet*>(handle);
+    const auto str_len_t = static_cast<size_t>(str_len);
+    for (size_t i = 0; i < count_t; ++i) {
+      const auto element = trimmed_view(strs + i * str_len_t, str_len_t);
+      if (element.empty()) {
+        continue;
+      }
+      const auto date_time = format_set->parse(element);
+      if (date_time.valid()) {
+        dt_ms[i] = date_time.timestamp();
+        valid[i] = true;
+        if (matched != nullptr) {
+          matched[i] = format_set->last_match();
+        }
+      }
+    }
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    std::fill(dt_ms, dt_ms + count_t, DateTime::INVALID_TIMESTAMP);
+    std::fill(valid, valid + count_t, false);
+  }
+}
+
+/**
+ * @brief Get the number of strings one format of a DateTimeFormatSet parsed
+ *
+ * @param handle Handle to the format set
+ * @param index Index of the format, from 0
+ * @return int64_t Number of successful parses, 0 if there is no such format
+ */
+auto f_datetime_format_set_hits(const void* handle, const int index)
+    -> int64_t {
+  if (handle == nullptr || index < 0) {
+    return 0;
+  }
+  return static_cast<const DateTimeFormatSet*>(handle)->hits(
+      static_cast<size_t>(index));
+}
+
+/**
+ * @brief Get the format of a DateTimeFormatSet that parsed the last string
+ *
+ * @param handle Handle to the format set
+ * @return int Index of the format, from 0, or -1 if the last string was not
+ * parsed or the handle is null
+ */
+auto f_datetime_format_set_last_match(const void* handle) -> int {
+  if (handle == nullptr) {
+    return DateTimeFormatSet::NO_MATCH;
+  }
+  return static_cast<const DateTimeFormatSet*>(handle)->last_match();
+}
+
+//=============================================================================
+// DateTimeRange functions
+//=============================================================================
+
+/**
+ * @brief Count the DateTimes in the range start, start + step, ... up to end
+ *
+ * @param start_ms First DateTime as milliseconds since epoch
+ * @param end_ms Last DateTime that may be in the range
+ * @param step_ms Step as milliseconds
+ * @return int64_t Number of DateTimes, 0 for a zero step or a step pointing
+ * away from end
+ */
+auto f_datetime_range_size(const int64_t start_ms, const int64_t end_ms,
+                           const int64_t step_ms) -> int64_t {
+  return DateTimeRange::count(start_ms, end_ms, step_ms);
+}
+
+/**
+ * @brief Get one DateTime of the range start, start + step, ...
+ *
+ * @param start_ms First DateTime as milliseconds since epoch
+ * @param step_ms Step as milliseconds
+ * @param index Index of the DateTime, from 0
+ * @return int64_t start + index * step as milliseconds since epoch
+ */
+auto f_datetime_range_at(const int64_t start_ms, const int64_t step_ms,
+                         const int64_t index) -> int64_t {
+  return DateTimeRange::from_count(DateTime(start_ms),
+                                   TimeDelta::fromMilliseconds(step_ms), 0)
+      .timestamp(static_cast<size_t>(index));
+}
+
+/**
+ * @brief Fill an array with the range start, start + step, ...
+ *
+ * @param start_ms First DateTime as milliseconds since epoch
+ * @param step_ms Step as milliseconds
+ * @param count Number of DateTimes to write
+ * @param dt_ms Output array of count DateTimes as milliseconds since epoch
+ */
+void f_datetime_range_fill(const int64_t start_ms, const int64_t step_ms,
+                           const int count, int64_t* dt_ms) {
+  if (count <= 0 || dt_ms == nullptr) {
+    return;
+  }
+
+  DateTimeRange::from_count(DateTime(start_ms),
+                            TimeDelta::fromMilliseconds(step_ms),
+                            static_cast<size_t>(count))
+      .fill(dt_ms);
+}
+
+//=============================================================================
+// DateTimeIndex functions
+//=============================================================================
+
+/**
+ * @brief Create a DateTimeIndex over a sorted time axis
+ *
+ * @param dt_ms Array of strictly increasing DateTimes as milliseconds since
+ * epoch
+ * @param count Number of DateTimes in the array
+ * @return void* Handle to the index, or nullptr if the axis is empty or not
+ * strictly increasing. The handle must be released with
+ * f_datetime_index_destroy.
+ */
+auto f_datetime_index_create(const int64_t* dt_ms, const int count) -> void* {
+  if (count <= 0 || dt_ms == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid time axis size or null time axis");
+    return nullptr;
+  }
+
+  const auto count_t = static_cast<size_t>(count);
+  if (!DateTimeIndex::is_strictly_increasing(dt_ms, count_t)) {
+    FDateError::set(e_FDateError::INVALID_INPUT,
+                    "Time axis must be strictly increasing");
+    return nullptr;
+  }
+
+  try {
+    return new DateTimeIndex(dt_ms, count_t);
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Release a DateTimeIndex handle
+ *
+ * @param handle Handle created by f_datetime_index_create (may be nullptr)
+ */
+void f_datetime_index_destroy(void* handle) {
+  delete static_cast<DateTimeIndex*>(handle);
+}
+
+/**
+ * @brief Get the number of DateTimes in a DateTimeIndex
+ *
+ * @param handle Handle created by f_datetime_index_create
+ * @return int Number of DateTimes, 0 for a null handle
+ */
+auto f_datetime_index_size(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  return static_cast<int>(static_cast<const DateTimeIndex*>(handle)->size());
+}
+
+/**
+ * @brief Find the DateTimes of an index bracketing a DateTime
+ *
+ * @param handle Handle created by f_datetime_index_create
+ * @param dt_ms DateTime as milliseconds since epoch
+ * @param index Output index of the DateTime at or before dt_ms, from 0
+ * @param weight Output linear interpolation weight of index + 1
+ * @return true if dt_ms is within the time axis, false if it was clamped to
+ * one end or the handle is null
+ */
+auto f_datetime_index_bracket(void* handle, const int64_t dt_ms, int* index,
+                              double* weight) -> bool {
+  if (handle == nullptr || index == nullptr || weight == nullptr) {
+    return false;
+  }
+
+  const auto result = static_cast<DateTimeIndex*>(handle)->bracket(dt_ms);
+  *index = static_cast<int>(result.index);
+  *weight = result.weight;
+  return result.in_range;
+}
+
+//=============================================================================
+// TimeAxis functions
+//=============================================================================
+
+/**
+ * @brief Create a TimeAxis from an array of DateTimes
+ *
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes in the array
+ * @return void* Handle to the axis, or nullptr if the array is empty. The
+ * handle must be released with f_time_axis_destroy.
+ */
+auto f_time_axis_create(const int64_t* dt_ms, const int count) -> void* {
+  if (count <= 0 || dt_ms == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid time axis size or null time axis");
+    return nullptr;
+  }
+
+  try {
+    return new TimeAxis(dt_ms, static_cast<size_t>(count));
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Create a uniform TimeAxis
+ *
+ * @param start_ms First DateTime as milliseconds since epoch
+ * @param step_ms Spacing between DateTimes in milliseconds
+ * @param count Number of DateTimes
+ * @return void* Handle to the axis, or nullptr if count is negative. The
+ * handle must be released with f_time_axis_destroy.
+ */
+auto f_time_axis_create_uniform(const int64_t start_ms, const int64_t step_ms,
+                                const int64_t count) -> void* {
+  if (count < 0) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT, "Invalid time axis size");
+    return nullptr;
+  }
+
+  try {
+    return new TimeAxis(TimeAxis::uniform(DateTime(start_ms),
+                                          TimeDelta::fromMilliseconds(step_ms),
+                                          static_cast<size_t>(count)));
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Create a TimeAxis from a buffer written by f_time_axis_serialize
+ *
+ * @param buffer Serialized axis
+ * @param size Number of bytes in the buffer
+ * @return void* Handle to the axis, or nullptr if the buffer does not hold a
+ * valid axis. The handle must be released with f_time_axis_destroy.
+ */
+auto f_time_axis_deserialize(const uint8_t* buffer, const int64_t size)
+    -> void* {
+  if (size <= 0 || buffer == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid buffer size or null buffer");
+    return nullptr;
+  }
+
+  try {
+    auto axis = std::make_unique<TimeAxis>();
+    if (TimeAxis::deserialize(buffer, static_cast<size_t>(size), *axis) ==
+        0) {
+      FDateError::set(e_FDateError::INVALID_INPUT,
+                      "Buffer does not hold a serialized time axis");
+      return nullptr;
+    }
+    return axis.release();
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Release a TimeAxis handle
+ *
+ * @param handle Handle created by one of the f_time_axis_create functions
+ * (may be nullptr)
+ */
+void f_time_axis_destroy(void* handle) {
+  delete static_cast<TimeAxis*>(handle);
+}
+
+/**
+ * @brief Get the number of DateTimes in a TimeAxis
+ *
+ * @param handle Handle to the axis
+ * @return int64_t Number of DateTimes, 0 for a null handle
+ */
+auto f_time_axis_size(const void* handle) -> int64_t {
+  if (handle == nullptr) {
+    return 0;
+  }
+  return static_cast<int64_t>(static_cast<const TimeAxis*>(handle)->size());
+}
+
+/**
+ * @brief Check if a TimeAxis is stored as a start and step
+ *
+ * @param handle Handle to the axis
+ * @return true for a uniform axis, false otherwise or for a null handle
+ */
+auto f_time_axis_is_uniform(const void* handle) -> bool {
+  return handle != nullptr &&
+         static_cast<const TimeAxis*>(handle)->is_uniform();
+}
+
+/**
+ * @brief Get one DateTime of a TimeAxis
+ *
+ * @param handle Handle to the axis
+ * @param index Index of the DateTime, from 0
+ * @return int64_t DateTime as milliseconds since epoch, or INVALID_TIMESTAMP
+ * if the handle is null or the index is out of range
+ */
+auto f_time_axis_at(const void* handle, const int64_t index) -> int64_t {
+  if (handle == nullptr) {
+    return DateTime::INVALID_TIMESTAMP;
+  }
+  const auto& axis = *static_cast<const TimeAxis*>(handle);
+  if (index < 0 || static_cast<size_t>(index) >= axis.size()) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Time axis index out of range");
+    return DateTime::INVALID_TIMESTAMP;
+  }
+  return axis[static_cast<size_t>(index)];
+}
+
+/**
+ * @brief Write the DateTimes of a TimeAxis to an array
+ *
+ * @param handle Handle to the axis
+ * @param dt_ms Output array of count DateTimes as milliseconds since epoch
+ * @param count Size of the array, which must be the size of the axis
+ * @return true if the array was filled, false otherwise
+ */
+auto f_time_axis_decode(const void* handle, int64_t* dt_ms,
+                        const int64_t count) -> bool {
+  if (handle == nullptr || dt_ms == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Null time axis or null array");
+    return false;
+  }
+  const auto& axis = *static_cast<const TimeAxis*>(handle);
+  if (count < 0 || static_cast<size_t>(count) != axis.size()) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Array size does not match the time axis");
+    return false;
+  }
+  if (count > 0) {
+    axis.decode(dt_ms);
+  }
+  return true;
+}
+
+/**
+ * @brief Get the number of bytes written by f_time_axis_serialize
+ *
+ * @param handle Handle to the axis
+ * @return int64_t Size of the serialized axis, 0 for a null handle
+ */
+auto f_time_axis_serialized_size(const void* handle) -> int64_t {
+  if (handle == nullptr) {
+    return 0;
+  }
+  return static_cast<int64_t>(
+      static_cast<const TimeAxis*>(handle)->serialized_size());
+}
+
+/**
+ * @brief Serialize a TimeAxis to a buffer
+ *
+ * @param handle Handle to the axis
+ * @param buffer Output buffer
+ * @param size Size of the buffer, at least f_time_axis_serialized_size
+ * @return int64_t Number of bytes written, 0 if the buffer is too small or the
+ * handle is null
+ */
+auto f_time_axis_serialize(const void* handle, uint8_t* buffer,
+                           const int64_t size) -> int64_t {
+  if (handle == nullptr || buffer == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Null time axis or null buffer");
+    return 0;
+  }
+  const auto& axis = *static_cast<const TimeAxis*>(handle);
+  if (size < 0 || static_cast<size_t>(size) < axis.serialized_size()) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Buffer is too small for the time axis");
+    return 0;
+  }
+  return static_cast<int64_t>(axis.serialize(buffer));
+}
+
+//=============================================================================
+// ModelClock functions
+//=============================================================================
+
+/**
+ * @brief Create a ModelClock
+ *
+ * @param start_ms Time of the clock as milliseconds since epoch
+ * @return void* Handle to the clock, or nullptr on failure. The handle must be
+ * released with f_model_clock_destroy.
+ */
+auto f_model_clock_create(const int64_t start_ms) -> void* {
+  try {
+    return new ModelClock(DateTime(start_ms));
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Release a ModelClock handle
+ *
+ * @param handle Handle created by f_model_clock_create (may be nullptr)
+ */
+void f_model_clock_destroy(void* handle) {
+  delete static_cast<ModelClock*>(handle);
+}
+
+/**
+ * @brief Move a ModelClock to a new time
+ *
+ * @param handle Handle to the clock
+ * @param dt_ms New time as milliseconds since epoch
+ */
+void f_model_clock_reset(void* handle, const int64_t dt_ms) {
+  if (handle != nullptr) {
+    static_cast<ModelClock*>(handle)->reset(DateTime(dt_ms));
+  }
+}
+
+/**
+ * @brief Advance a ModelClock by a step
+ *
+ * @param handle Handle to the clock
+ * @param step_ms Step as milliseconds
+ */
+void f_model_clock_advance(void* handle, const int64_t step_ms) {
+  if (handle != nullptr) {
+    static_cast<ModelClock*>(handle)->advance(
+        TimeDelta::fromMilliseconds(step_ms));
+  }
+}
+
+/**
+ * @brief Get the time of a ModelClock
+ *
+ * @param handle Handle to the clock
+ * @return int64_t Time as milliseconds since epoch, or INVALID_TIMESTAMP for a
+ * null handle
+ */
+auto f_model_clock_timestamp(const void* handle) -> int64_t {
+  if (handle == nullptr) {
+    return DateTime::INVALID_TIMESTAMP;
+  }
+  return static_cast<const ModelClock*>(handle)->timestamp();
+}
+
+/**
+ * @brief Get the year of a ModelClock
+ *
+ * @param handle Handle to the clock
+ * @return int Year, 0 for a null handle
+ */
+auto f_model_clock_year(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  const auto& clock = *static_cast<const ModelClock*>(handle);
+  return clock.year();
+}
+
+/**
+ * @brief Get the month of a ModelClock
+ *
+ * @param handle Handle to the clock
+ * @return int Month (1-12), 0 for a null handle
+ */
+auto f_model_clock_month(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  const auto& clock = *static_cast<const ModelClock*>(handle);
+  return static_cast<int>(clock.month());
+}
+
+/**
+ * @brief Get the day of month of a ModelClock
+ *
+ * @param handle Handle to the clock
+ * @return int Day of month (1-31), 0 for a null handle
+ */
+auto f_model_clock_day(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  const auto& clock = *static_cast<const ModelClock*>(handle);
+  return static_cast<int>(clock.day());
+}
+
+/**
+ * @brief Get the hour of a ModelClock
+ *
+ * @param handle Handle to the clock
+ * @return int Hour (0-23), 0 for a null handle
+ */
+auto f_model_clock_hour(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  const auto& clock = *static_cast<const ModelClock*>(handle);
+  return static_cast<int>(clock.hour());
+}
+
+/**
+ * @brief Get the minute of a ModelClock
+ *
+ * @param handle Handle to the clock
+ * @return int Minute (0-59), 0 for a null handle
+ */
+auto f_model_clock_minute(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  const auto& clock = *static_cast<const ModelClock*>(handle);
+  return static_cast<int>(clock.minute());
+}
+
+/**
+ * @brief Get the second of a ModelClock
+ *
+ * @param handle Handle to the clock
+ * @return int Second (0-59), 0 for a null handle
+ */
+auto f_model_clock_second(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  const auto& clock = *static_cast<const ModelClock*>(handle);
+  return static_cast<int>(clock.second());
+}
+
+/**
+ * @brief Get the millisecond of a ModelClock
+ *
+ * @param handle Handle to the clock
+ * @return int Millisecond (0-999), 0 for a null handle
+ */
+auto f_model_clock_millisecond(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  const auto& clock = *static_cast<const ModelClock*>(handle);
+  return static_cast<int>(clock.millisecond());
+}
+
+/**
+ * @brief Get the day of year of a ModelClock
+ *
+ * @param handle Handle to the clock
+ * @return int Day of year (1-366), 0 for a null handle
+ */
+auto f_model_clock_day_of_year(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  const auto& clock = *static_cast<const ModelClock*>(handle);
+  return static_cast<int>(clock.day_of_year());
+}
+
+/**
+ * @brief Check if the last step of a ModelClock moved it into another hour
+ *
+ * @param handle Handle to the clock
+ * @return true if the step crossed an hour boundary, false otherwise or for a
+ * null handle
+ */
+auto f_model_clock_crossed_hour(const void* handle) -> bool {
+  return handle != nullptr &&
+         static_cast<const ModelClock*>(handle)->crossed_hour();
+}
+
+/**
+ * @brief Check if the last step of a ModelClock moved it into another day
+ *
+ * @param handle Handle to the clock
+ * @return true if the step crossed a day boundary, false otherwise or for a
+ * null handle
+ */
+auto f_model_clock_crossed_day(const void* handle) -> bool {
+  return handle != nullptr &&
+         static_cast<const ModelClock*>(handle)->crossed_day();
+}
+
+/**
+ * @brief Check if the last step of a ModelClock moved it into another month
+ *
+ * @param handle Handle to the clock
+ * @return true if the step crossed a month boundary, false otherwise or for a
+ * null handle
+ */
+auto f_model_clock_crossed_month(const void* handle) -> bool {
+  return handle != nullptr &&
+         static_cast<const ModelClock*>(handle)->crossed_month();
+}
+
+/**
+ * @brief Check if the last step of a ModelClock moved it into another year
+ *
+ * @param handle Handle to the clock
+ * @return true if the step crossed a year boundary, false otherwise or for a
+ * null handle
+ */
+auto f_model_clock_crossed_year(const void* handle) -> bool {
+  return handle != nullptr &&
+         static_cast<const ModelClock*>(handle)->crossed_year();
+}
+
+//=============================================================================
+// AlarmSet functions
+//=============================================================================
+
+/**
+ * @brief Create an empty AlarmSet
+ *
+ * @return void* Handle to the alarm set, or nullptr on failure. The handle must
+ * be released with f_alarm_set_destroy.
+ */
+auto f_alarm_set_create() -> void* {
+  try {
+    return new AlarmSet();
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Release an AlarmSet handle
+ *
+ * @param handle Handle created by f_alarm_set_create (may be nullptr)
+ */
+void f_alarm_set_destroy(void* handle) {
+  delete static_cast<AlarmSet*>(handle);
+}
+
+/**
+ * @brief Add an alarm that fires every fixed interval
+ *
+ * @param handle Handle to the alarm set
+ * @param first_ms First fire time as milliseconds since epoch
+ * @param interval_ms Interval between fires in milliseconds
+ * @return int Identifier of the alarm, from 0, or -1 on failure
+ */
+auto f_alarm_set_add_interval(void* handle, const int64_t first_ms,
+                              const int64_t interval_ms) -> int {
+  if (handle == nullptr || interval_ms <= 0) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Null alarm set or non-positive interval");
+    return AlarmSet::INVALID_ALARM;
+  }
+
+  try {
+    return static_cast<AlarmSet*>(handle)->add_interval(
+        DateTime(first_ms), TimeDelta::fromMilliseconds(interval_ms));
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return AlarmSet::INVALID_ALARM;
+  }
+}
+
+/**
+ * @brief Add an alarm that fires every given number of months
+ *
+ * @param handle Handle to the alarm set
+ * @param first_ms First fire time as milliseconds since epoch, which sets the
+ * day of the month and time of day of later fires
+ * @param months Number of months between fires
+ * @return int Identifier of the alarm, from 0, or -1 on failure
+ */
+auto f_alarm_set_add_monthly(void* handle, const int64_t first_ms,
+                             const int months) -> int {
+  if (handle == nullptr || months <= 0) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Null alarm set or non-positive number of months");
+    return AlarmSet::INVALID_ALARM;
+  }
+
+  try {
+    return static_cast<AlarmSet*>(handle)->add_monthly(DateTime(first_ms),
+                                                       months);
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return AlarmSet::INVALID_ALARM;
+  }
+}
+
+/**
+ * @brief Get the number of alarms in an AlarmSet
+ *
+ * @param handle Handle to the alarm set
+ * @return int Number of alarms, 0 for a null handle
+ */
+auto f_alarm_set_size(const void* handle) -> int {
+  if (handle == nullptr) {
+    return 0;
+  }
+  return static_cast<int>(static_cast<const AlarmSet*>(handle)->size());
+}
+
+/**
+ * @brief Get the time the next alarm of an AlarmSet fires
+ *
+ * @param handle Handle to the alarm set
+ * @return int64_t Next fire time as milliseconds since epoch, or
+ * INVALID_TIMESTAMP if the set is empty or the handle is null
+ */
+auto f_alarm_set_next_time(const void* handle) -> int64_t {
+  if (handle == nullptr) {
+    return DateTime::INVALID_TIMESTAMP;
+  }
+  return static_cast<const AlarmSet*>(handle)->next_time().timestamp();
+}
+
+/**
+ * @brief Get the time one alarm of an AlarmSet fires next
+ *
+ * @param handle Handle to the alarm set
+ * @param id Identifier of the alarm
+ * @return int64_t Next fire time as milliseconds since epoch, or
+ * INVALID_TIMESTAMP if there is no such alarm
+ */
+auto f_alarm_set_alarm_next_time(const void* handle, const int id)
+    -> int64_t {
+  if (handle == nullptr) {
+    return DateTime::INVALID_TIMESTAMP;
+  }
+  return static_cast<const AlarmSet*>(handle)->next_time(id).timestamp();
+}
+
+/**
+ * @brief Check if any alarm of an AlarmSet fires at or before a time
+ *
+ * @param handle Handle to the alarm set
+ * @param now_ms Current time as milliseconds since epoch
+ * @return true if an alarm is due, false otherwise or for a null handle
+ */
+auto f_alarm_set_due(const void* handle, const int64_t now_ms) -> bool {
+  return handle != nullptr &&
+         static_cast<const AlarmSet*>(handle)->due(DateTime(now_ms));
+}
+
+/**
+ * @brief Take the next alarm of an AlarmSet that fires at or before a time
+ *
+ * The alarm is rescheduled to its first fire time after now_ms
+ *
+ * @param handle Handle to the alarm set
+ * @param now_ms Current time as milliseconds since epoch
+ * @return int Identifier of the alarm, or -1 if no alarm is due
+ */
+auto f_alarm_set_pop(void* handle, const int64_t now_ms) -> int {
+  if (handle == nullptr) {
+    return AlarmSet::INVALID_ALARM;
+  }
+  try {
+    return static_cast<AlarmSet*>(handle)->pop(DateTime(now_ms));
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return AlarmSet::INVALID_ALARM;
+  }
+}
+
+//=============================================================================
+// CF time units functions
+//=============================================================================
+
+/**
+ * @brief Parse a CF convention time units attribute
+ *
+ * @param units Units attribute, e.g. "hours since 1990-01-01 00:00:00"
+ * @param units_len Length of the attribute
+ * @param unit_ms Output length of one unit in milliseconds
+ * @param epoch_ms Output reference date as milliseconds since epoch
+ * @return true if the attribute was understood, false otherwise
+ */
+auto f_datetime_cf_units_parse(const char* units, const int units_len,
+                               int64_t* unit_ms, int64_t* epoch_ms) -> bool {
+  if (units_len <= 0 || units == nullptr || unit_ms == nullptr ||
+      epoch_ms == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid units length or null units/output");
+    return false;
+  }
+
+  const CFTimeUnits cf_units(units, static_cast<size_t>(units_len));
+  *unit_ms = cf_units.unit_milliseconds();
+  *epoch_ms = cf_units.epoch().timestamp();
+  if (!cf_units.valid()) {
+    FDateError::set(e_FDateError::PARSE, "Could not parse the units attribute");
+    return false;
+  }
+  return true;
+}
+
+/**
+ * @brief Convert floating point CF time offsets to DateTimes
+ *
+ * @param unit_ms Length of one unit in milliseconds
+ * @param epoch_ms Reference date as milliseconds since epoch
+ * @param values Array of offsets in the unit
+ * @param count Number of offsets
+ * @param dt_ms Output array of DateTimes as milliseconds since epoch
+ */
+void f_datetime_cf_decode_double(const int64_t unit_ms, const int64_t epoch_ms,
+                                 const double* values, const int count,
+                                 int64_t* dt_ms) {
+  if (count <= 0 || values == nullptr || dt_ms == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid count or null input/output");
+    return;
+  }
+
+  // Non-positive units fill the output with invalid values
+  const CFTimeUnits cf_units(unit_ms, DateTime(epoch_ms));
+  if (!cf_units.valid()) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT, "Non-positive unit length");
+  }
+  cf_units.to_timestamps(values, static_cast<size_t>(count), dt_ms);
+}
+
+/**
+ * @brief Convert 32-bit integer CF time offsets to DateTimes
+ *
+ * @param unit_ms Length of one unit in milliseconds
+ * @param epoch_ms Reference date as milliseconds since epoch
+ * @param values Array of offsets in the unit
+ * @param count Number of offsets
+ * @param dt_ms Output array of DateTimes as milliseconds since epoch
+ */
+void f_datetime_cf_decode_int32(const int64_t unit_ms, const int64_t epoch_ms,
+                                const int32_t* values, const int count,
+                                int64_t* dt_ms) {
+  if (count <= 0 || values == nullptr || dt_ms == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid count or null input/output");
+    return;
+  }
+
+  // Non-positive units fill the output with invalid values
+  const CFTimeUnits cf_units(unit_ms, DateTime(epoch_ms));
+  if (!cf_units.valid()) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT, "Non-positive unit length");
+  }
+  cf_units.to_timestamps(values, static_cast<size_t>(count), dt_ms);
+}
+
+/**
+ * @brief Convert 64-bit integer CF time offsets to DateTimes
+ *
+ * @param unit_ms Length of one unit in milliseconds
+ * @param epoch_ms Reference date as milliseconds since epoch
+ * @param values Array of offsets in the unit
+ * @param count Number of offsets
+ * @param dt_ms Output array of DateTimes as milliseconds since epoch
+ */
+void f_datetime_cf_decode_int64(const int64_t unit_ms, const int64_t epoch_ms,
+                                const int64_t* values, const int count,
+                                int64_t* dt_ms) {
+  if (count <= 0 || values == nullptr || dt_ms == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid count or null input/output");
+    return;
+  }
+
+  // Non-positive units fill the output with invalid values
+  const CFTimeUnits cf_units(unit_ms, DateTime(epoch_ms));
+  if (!cf_units.valid()) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT, "Non-positive unit length");
+  }
+  cf_units.to_timestamps(values, static_cast<size_t>(count), dt_ms);
+}
+
+/**
+ * @brief Convert DateTimes to floating point CF time offsets
+ *
+ * @param unit_ms Length of one unit in milliseconds
+ * @param epoch_ms Reference date as milliseconds since epoch
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes
+ * @param values Output array of offsets in the unit
+ */
+void f_datetime_cf_encode_double(const int64_t unit_ms, const int64_t epoch_ms,
+                                 const int64_t* dt_ms, const int count,
+                                 double* values) {
+  if (count <= 0 || dt_ms == nullptr || values == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid count or null input/output");
+    return;
+  }
+
+  // Non-positive units fill the output with invalid values
+  const CFTimeUnits cf_units(unit_ms, DateTime(epoch_ms));
+  if (!cf_units.valid()) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT, "Non-positive unit length");
+  }
+  cf_units.from_timestamps(dt_ms, static_cast<size_t>(count), values);
+}
+
+/**
+ * @brief Convert DateTimes to 64-bit integer CF time offsets
+ *
+ * @param unit_ms Length of one unit in milliseconds
+ * @param epoch_ms Reference date as milliseconds since epoch
+ * @param dt_ms Array of DateTimes as milliseconds since epoch
+ * @param count Number of DateTimes
+ * @param values Output array of offsets in the unit
+ */
+void f_datetime_cf_encode_int64(const int64_t unit_ms, const int64_t epoch_ms,
+                                const int64_t* dt_ms, const int count,
+                                int64_t* values) {
+  if (count <= 0 || dt_ms == nullptr || values == nullptr) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid count or null input/output");
+    return;
+  }
+
+  // Non-positive units fill the output with invalid values
+  const CFTimeUnits cf_units(unit_ms, DateTime(epoch_ms));
+  if (!cf_units.valid()) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT, "Non-positive unit length");
+  }
+  cf_units.from_timestamps(dt_ms, static_cast<size_t>(count), values);
+}
+
+//=============================================================================
+// Delimited text functions
+//=============================================================================
+
+/**
+ * @brief Read the timestamp column of a delimited text file
+ *
+ * The file is memory mapped where supported and read in chunks otherwise.
+ * Each record line gives one timestamp, INVALID_TIMESTAMP if the line has too
+ * few fields or its field could not be parsed.
+ *
+ * @param filename Path of the file
+ * @param filename_len Length of the path
+ * @param format Format of the timestamp field (similar to strftime), or "auto"
+ * @param format_len Length of the format string
+ * @param delimiter Field delimiter, or ' ' to split on runs of blanks and tabs
+ * @param column Index of the timestamp field, from 0
+ * @param span Number of fields forming the timestamp, e.g. 2 for a date
+ * field followed by a time field
+ * @param header_lines Number of lines skipped at the start of the file
+ * @param comment Lines starting with this character are skipped, '\0' for
+ * none
+ * @return void* Handle to the timestamps, or nullptr on failure. The handle
+ * must be released with f_datetime_text_column_destroy.
+ */
+auto f_datetime_text_column_read(const char* filename, const int filename_len,
+                                 const char* format, const int format_len,
+                                 const char delimiter, const int column,
+                                 const int span, const int header_lines,
+                                 const char comment) -> void* {
+  if (filename_len <= 0 || filename == nullptr || format_len <= 0 ||
+      format == nullptr || column < 0 || span <= 0 || header_lines < 0) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid filename, format, column, span or header lines");
+    return nullptr;
+  }
+
+  try {
+    DelimitedTimeReader reader(
+        std::string(filename, static_cast<size_t>(filename_len)));
+    if (!reader.valid()) {
+      FDateError::set(e_FDateError::IO, reader.error().data(),
+                      reader.error().size());
+      return nullptr;
+    }
+
+    DelimitedTimeReader::s_Options options;
+    options.delimiter = delimiter;
+    options.column = static_cast<size_t>(column);
+    options.span = static_cast<size_t>(span);
+    options.header_lines = static_cast<size_t>(header_lines);
+    options.comment = comment;
+
+    const DateTimeFormat compiled(
+        std::string(format, static_cast<size_t>(format_len)));
+    auto timestamps = std::make_unique<std::vector<int64_t>>();
+    if (!reader.read(compiled, options, *timestamps)) {
+      FDateError::set(e_FDateError::IO, reader.error().data(),
+                      reader.error().size());
+      return nullptr;
+    }
+    return timestamps.release();
+  } catch (...) {
+    FDateError::set(e_FDateError::INTERNAL, "Unexpected exception");
+    return nullptr;
+  }
+}
+
+/**
+ * @brief Release the timestamps read from a delimited text file
+ *
+ * @param handle Handle created by f_datetime_text_column_read (may be
+ * nullptr)
+ */
+void f_datetime_text_column_destroy(void* handle) {
+  delete static_cast<std::vector<int64_t>*>(handle);
+}
+
+/**
+ * @brief Get the number of timestamps read from a delimited text file
+ *
+ * @param handle Handle to the timestamps
+ * @return int64_t Number of records, 0 for a null handle
+ */
+auto f_datetime_text_column_size(const void* handle) -> int64_t {
+  if (handle == nullptr) {
+    return 0;
+  }
+  return static_cast<int64_t>(
+      static_cast<const std::vector<int64_t>*>(handle)->size());
+}
+
+/**
+ * @brief Copy the timestamps read from a delimited text file
+ *
+ * @param handle Handle to the timestamps
+ * @param count Number of timestamps to copy, at most the number read
+ * @param dt_ms Output array of DateTimes as milliseconds since epoch
+ * @param valid Output array of flags, true where the field was parsed
+ */
+void f_datetime_text_column_copy(const void* handle, const int64_t count,
+                                 int64_t* dt_ms, bool* valid) {
+  if (handle == nullptr || count <= 0 || dt_ms == nullptr ||
+      valid == nullptr) {
+    return;
+  }
+
+  const auto& timestamps = *static_cast<const std::vector<int64_t>*>(handle);
+  const auto n = std::min(static_cast<size_t>(count), timestamps.size());
+  for (size_t i = 0; i < n; ++i) {
+    dt_ms[i] = timestamps[i];
+    valid[i] = timestamps[i] != DateTime::INVALID_TIMESTAMP;
+  }
+}
+
+//=============================================================================
+// Error reporting functions
+//=============================================================================
+
+/**
+ * @brief Get the code of the last error recorded on the calling thread
+ *
+ * Errors are recorded per thread and are not cleared by successful calls.
+ *
+ * @return int Error code, 0 if no error has been recorded since the last
+ * f_fdate_clear_error
+ */
+auto f_fdate_last_error() -> int {
+  return static_cast<int>(FDateError::code());
+}
+
+/**
+ * @brief Get the message of the last error recorded on the calling thread
+ *
+ * @param buffer Output buffer for the null terminated message
+ * @param buffer_size Size of the output buffer
+ */
+void f_fdate_last_error_message(char* buffer, const int buffer_size) {
+  if (buffer_size <= 0 || buffer == nullptr) {
+    return;
+  }
+
+  const char* message = FDateError::message();
+  const size_t copy_length = std::min(static_cast<size_t>(buffer_size - 1),
+                                      std::strlen(message));
+  std::memcpy(buffer, message, copy_length);
+  buffer[copy_length] = '\0';
+}
+
+/**
+ * @brief Clear the last error recorded on the calling thread
+ */
+void f_fdate_clear_error() { FDateError::clear(); }
+
+/**
+ * @brief Get the number of threads the parallel array functions may use
+ *
+ * @return int The OpenMP thread limit, 1 if fdate was built without OpenMP
+ */
+auto f_fdate_max_threads() -> int { return ParallelBlocks::max_threads(); }
+
+//=============================================================================
+// Instrumentation functions
+//=============================================================================
+
+/**
+ * @brief Check if fdate was built with instrumentation counters
+ *
+ * @return true if built with FDATE_ENABLE_STATS, false otherwise
+ */
+auto f_fdate_stats_enabled() -> bool { return FDateStats::enabled(); }
+
+/**
+ * @brief Get the instrumentation counters summed over all threads
+ *
+ * The layout of the values is described by FDateStats::get(): the
+ * e_FDateStat counters followed by the per format parse attempt and parse
+ * success counters. All counters are zero without FDATE_ENABLE_STATS.
+ *
+ * @param values Output array for the counters
+ * @param count Size of the output array
+ * @return int Number of counters available. Only the first count are
+ * written if this is larger than count.
+ */
+auto f_fdate_stats_get(int64_t* values, const int count) -> int {
+  if (values == nullptr || count < 0) {
+    FDateError::set(e_FDateError::INVALID_ARGUMENT,
+                    "Invalid stats output array");
+    return 0;
+  }
+
+  const auto stats = FDateStats::get();
+  const auto n = std::min(stats.size(), static_cast<size_t>(count));
+  std::copy_n(stats.begin(), n, values);
+  return static_cast<int>(stats.size());
+}
+
+/**
+ * @brief Set all instrumentation counters to zero
+ */
+void f_fdate_stats_reset() { FDateStats::reset(); }
+
+/**
+ * @brief Get the format counted by one of the per format parse counters
+ *
+ * @param slot Index of the per format counter, from 0
+ * @param buffer Output buffer for the null terminated format, "explicit" for
+ * the slot counting parses with any other format
+ * @param buffer_size Size of the output buffer
+ */
+void f_fdate_stats_format_name(const int slot, char* buffer,
+                               const int buffer_size) {
+  if (buffer == nullptr || buffer_size <= 0) {
+    return;
+  }
+
+  const char* name = "";
+  if (slot >= 0) {
+    const auto index = static_cast<size_t>(slot);
+    if (index == FDateStats::EXPLICIT_FORMAT) {
+      name = "explicit";
+    } else if (const char* format = DateTime::auto_format(index);
+               format != nullptr) {
+      name = format;
+    }
+  }
+
+  const size_t copy_length =
+      std::min(static_cast<size_t>(buffer_size - 1), std::strlen(name));
+  std::memcpy(buffer, name, copy_length);
+  buffer[copy_length] = '\0';
+}
+
 }  // extern "C"
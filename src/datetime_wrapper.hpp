@@ -0,0 +1,326 @@
+/*
+ * FDate - A Fortran Date and Time Library based on C++
+ * Copyright (C) 2025 Zach Cobell
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+#include <cstdint>
+
+// C interface called by the Fortran module, defined and documented in
+// datetime_wrapper.cpp. DateTimes and TimeDeltas cross it as milliseconds
+// and objects as opaque handles.
+
+extern "C" {
+
+//=============================================================================
+// TimeDelta functions
+//=============================================================================
+
+auto f_timedelta_create(int days, int hours, int minutes, int seconds,
+                        int milliseconds) -> int64_t;
+auto f_timedelta_from_days(int64_t days) -> int64_t;
+auto f_timedelta_from_hours(int64_t hours) -> int64_t;
+auto f_timedelta_from_minutes(int64_t minutes) -> int64_t;
+auto f_timedelta_from_seconds(int64_t seconds) -> int64_t;
+auto f_timedelta_from_milliseconds(int64_t milliseconds) -> int64_t;
+auto f_timedelta_get_days(int64_t ts_ms) -> int64_t;
+auto f_timedelta_get_hours(int64_t ts_ms) -> int64_t;
+auto f_timedelta_get_minutes(int64_t ts_ms) -> int64_t;
+auto f_timedelta_get_seconds(int64_t ts_ms) -> int64_t;
+auto f_timedelta_get_milliseconds(int64_t ts_ms) -> int64_t;
+auto f_timedelta_get_total_days(int64_t ts_ms) -> int64_t;
+auto f_timedelta_get_total_hours(int64_t ts_ms) -> int64_t;
+auto f_timedelta_get_total_minutes(int64_t ts_ms) -> int64_t;
+auto f_timedelta_get_total_seconds(int64_t ts_ms) -> int64_t;
+auto f_timedelta_add(int64_t ts1_ms, int64_t ts2_ms) -> int64_t;
+auto f_timedelta_subtract(int64_t ts1_ms, int64_t ts2_ms) -> int64_t;
+auto f_timedelta_multiply(int64_t ts_ms, int factor) -> int64_t;
+auto f_timedelta_divide(int64_t ts_ms, int divisor) -> int64_t;
+void f_timedelta_to_string(int64_t ts_ms, char* buffer, int buffer_size);
+auto f_timedelta_parse(const char* str, int str_len, int64_t* ts_ms) -> bool;
+void f_timedelta_parse_array(const char* strs, int str_len, int count,
+                             int64_t* ts_ms, bool* valid);
+auto f_timedelta_equals(int64_t ts1_ms, int64_t ts2_ms) -> bool;
+auto f_timedelta_less_than(int64_t ts1_ms, int64_t ts2_ms) -> bool;
+auto f_timedelta_greater_than(int64_t ts1_ms, int64_t ts2_ms) -> bool;
+auto f_timedelta_less_equal(int64_t ts1_ms, int64_t ts2_ms) -> bool;
+auto f_timedelta_greater_equal(int64_t ts1_ms, int64_t ts2_ms) -> bool;
+
+//=============================================================================
+// DateTime functions
+//=============================================================================
+
+auto f_datetime_create(int year, int month, int day, int hour, int minute,
+                       int second, int millisecond) -> int64_t;
+auto f_datetime_now() -> int64_t;
+auto f_datetime_strptime(const char* str, const char* format, int str_len,
+                         int format_len) -> int64_t;
+auto f_datetime_get_year(int64_t dt_ms) -> int64_t;
+auto f_datetime_get_month(int64_t dt_ms) -> int64_t;
+auto f_datetime_get_day(int64_t dt_ms) -> int64_t;
+auto f_datetime_get_hour(int64_t dt_ms) -> int64_t;
+auto f_datetime_get_minute(int64_t dt_ms) -> int64_t;
+auto f_datetime_get_second(int64_t dt_ms) -> int64_t;
+auto f_datetime_get_millisecond(int64_t dt_ms) -> int64_t;
+void f_datetime_get_fields(int64_t dt_ms, int* year, int* month, int* day,
+                           int* hour, int* minute, int* second,
+                           int* millisecond);
+void f_datetime_get_fields_array(const int64_t* dt_ms, int count, int* year,
+                                 int* month, int* day, int* hour, int* minute,
+                                 int* second, int* millisecond);
+void f_datetime_get_fields_array_parallel(const int64_t* dt_ms, int count,
+                                          int* year, int* month, int* day,
+                                          int* hour, int* minute, int* second,
+                                          int* millisecond);
+void f_datetime_create_array(const int* year, const int* month, const int* day,
+                             const int* hour, const int* minute,
+                             const int* second, const int* millisecond,
+                             int count, int64_t* dt_ms);
+auto f_datetime_get_julian_day_number(int64_t dt_ms) -> int64_t;
+auto f_datetime_get_julian_day(int64_t dt_ms) -> double;
+auto f_datetime_get_julian_century(int64_t dt_ms) -> double;
+void f_datetime_get_julian_day_array(const int64_t* dt_ms, int count,
+                                     double* jd);
+void f_datetime_get_julian_century_array(const int64_t* dt_ms, int count,
+                                         double* jc);
+auto f_datetime_floor(int64_t dt_ms, int64_t interval_ms, int64_t origin_ms)
+    -> int64_t;
+auto f_datetime_ceil(int64_t dt_ms, int64_t interval_ms, int64_t origin_ms)
+    -> int64_t;
+auto f_datetime_round(int64_t dt_ms, int64_t interval_ms, int64_t origin_ms)
+    -> int64_t;
+auto f_datetime_floor_to_month(int64_t dt_ms, int months) -> int64_t;
+auto f_datetime_ceil_to_month(int64_t dt_ms, int months) -> int64_t;
+void f_datetime_round_array(const int64_t* dt_ms, int count,
+                            int64_t interval_ms, int64_t origin_ms,
+                            int rounding, int64_t* aligned_ms);
+void f_datetime_floor_to_month_array(const int64_t* dt_ms, int count,
+                                     int months, int64_t* aligned_ms);
+auto f_datetime_bin_by_interval(const int64_t* dt_ms, int count,
+                                int64_t interval_ms, int64_t origin_ms,
+                                int* starts, int64_t* bin_ms) -> int;
+auto f_datetime_bin_by_month(const int64_t* dt_ms, int count, int months,
+                             int* starts, int64_t* bin_ms) -> int;
+auto f_datetime_add_timedelta(int64_t dt_ms, int64_t ts_ms) -> int64_t;
+auto f_datetime_subtract_timedelta(int64_t dt_ms, int64_t ts_ms) -> int64_t;
+auto f_datetime_difference(int64_t dt1_ms, int64_t dt2_ms) -> int64_t;
+void f_datetime_add_timedelta_array(const int64_t* dt_ms, int dt_stride,
+                                    const int64_t* ts_ms, int ts_stride,
+                                    int count, int64_t* result);
+void f_datetime_subtract_timedelta_array(const int64_t* dt_ms, int dt_stride,
+                                         const int64_t* ts_ms, int ts_stride,
+                                         int count, int64_t* result);
+void f_datetime_difference_array(const int64_t* dt1_ms, int dt1_stride,
+                                 const int64_t* dt2_ms, int dt2_stride,
+                                 int count, int64_t* result);
+void f_datetime_strptime_array(const char* strs, int str_len, int count,
+                               const char* format, int format_len,
+                               int64_t* dt_ms, bool* valid);
+void f_datetime_strptime_array_parallel(const char* strs, int str_len,
+                                        int count, const char* format,
+                                        int format_len, int64_t* dt_ms,
+                                        bool* valid);
+auto f_datetime_strftime(int64_t dt_ms, const char* format, char* buffer,
+                         int format_len, int buffer_size) -> int;
+auto f_datetime_strftime_milliseconds(int64_t dt_ms, const char* format,
+                                      char* buffer, int format_len,
+                                      int buffer_size) -> int;
+void f_datetime_to_iso_string(int64_t dt_ms, char* buffer, int buffer_size);
+void f_datetime_to_iso_string_msec(int64_t dt_ms, char* buffer,
+                                   int buffer_size);
+void f_datetime_strftime_array(const int64_t* dt_ms, int count,
+                               const char* format, int format_len, char* buffer,
+                               int str_len, bool milliseconds);
+void f_datetime_strftime_array_parallel(const int64_t* dt_ms, int count,
+                                        const char* format, int format_len,
+                                        char* buffer, int str_len,
+                                        bool milliseconds);
+auto f_datetime_equals(int64_t dt1_ms, int64_t dt2_ms) -> bool;
+auto f_datetime_less_than(int64_t dt1_ms, int64_t dt2_ms) -> bool;
+auto f_datetime_greater_than(int64_t dt1_ms, int64_t dt2_ms) -> bool;
+auto f_datetime_less_equal(int64_t dt1_ms, int64_t dt2_ms) -> bool;
+auto f_datetime_greater_equal(int64_t dt1_ms, int64_t dt2_ms) -> bool;
+auto f_datetime_is_valid(int64_t dt_ms) -> bool;
+auto f_datetime_invalid_timestamp() -> int64_t;
+auto f_datetime_strptime_with_formats(const char* str, const char* formats,
+                                      int str_len, int format_len,
+                                      int num_formats) -> int64_t;
+auto f_datetime_strptime_auto_with_fallback(const char* str,
+                                            const char* fallback_formats,
+                                            int str_len, int format_len,
+                                            int num_formats) -> int64_t;
+
+//=============================================================================
+// DateTimeFormat functions
+//=============================================================================
+
+auto f_datetime_format_create(const char* format, int format_len) -> void*;
+void f_datetime_format_destroy(void* handle);
+auto f_datetime_strptime_compiled(const char* str, const void* handle,
+                                  int str_len) -> int64_t;
+auto f_datetime_strftime_compiled(int64_t dt_ms, const void* handle,
+                                  char* buffer, int buffer_size) -> int;
+auto f_datetime_strftime_compiled_milliseconds(int64_t dt_ms,
+                                               const void* handle, char* buffer,
+                                               int buffer_size) -> int;
+
+//=============================================================================
+// DateTimeFormatSet functions
+//=============================================================================
+
+auto f_datetime_format_set_create(int order) -> void*;
+void f_datetime_format_set_destroy(void* handle);
+auto f_datetime_format_set_add(void* handle, const char* format, int format_len)
+    -> int;
+auto f_datetime_format_set_size(const void* handle) -> int;
+auto f_datetime_format_set_parse(void* handle, const char* str, int str_len,
+                                 int* matched) -> int64_t;
+void f_datetime_format_set_parse_array(void* handle, const char* strs,
+                                       int str_len, int count, int64_t* dt_ms,
+                                       bool* valid, int* matched);
+auto f_datetime_format_set_hits(const void* handle, int index) -> int64_t;
+auto f_datetime_format_set_last_match(const void* handle) -> int;
+
+//=============================================================================
+// DateTimeRange functions
+//=============================================================================
+
+auto f_datetime_range_size(int64_t start_ms, int64_t end_ms, int64_t step_ms)
+    -> int64_t;
+auto f_datetime_range_at(int64_t start_ms, int64_t step_ms, int64_t index)
+    -> int64_t;
+void f_datetime_range_fill(int64_t start_ms, int64_t step_ms, int count,
+                           int64_t* dt_ms);
+
+//=============================================================================
+// DateTimeIndex functions
+//=============================================================================
+
+auto f_datetime_index_create(const int64_t* dt_ms, int count) -> void*;
+void f_datetime_index_destroy(void* handle);
+auto f_datetime_index_size(const void* handle) -> int;
+auto f_datetime_index_bracket(void* handle, int64_t dt_ms, int* index,
+                              double* weight) -> bool;
+
+//=============================================================================
+// TimeAxis functions
+//=============================================================================
+
+auto f_time_axis_create(const int64_t* dt_ms, int count) -> void*;
+auto f_time_axis_create_uniform(int64_t start_ms, int64_t step_ms,
+                                int64_t count) -> void*;
+auto f_time_axis_deserialize(const uint8_t* buffer, int64_t size) -> void*;
+void f_time_axis_destroy(void* handle);
+auto f_time_axis_size(const void* handle) -> int64_t;
+auto f_time_axis_is_uniform(const void* handle) -> bool;
+auto f_time_axis_at(const void* handle, int64_t index) -> int64_t;
+auto f_time_axis_decode(const void* handle, int64_t* dt_ms, int64_t count)
+    -> bool;
+auto f_time_axis_serialized_size(const void* handle) -> int64_t;
+auto f_time_axis_serialize(const void* handle, uint8_t* buffer, int64_t size)
+    -> int64_t;
+
+//=============================================================================
+// ModelClock functions
+//=============================================================================
+
+auto f_model_clock_create(int64_t start_ms) -> void*;
+void f_model_clock_destroy(void* handle);
+void f_model_clock_reset(void* handle, int64_t dt_ms);
+void f_model_clock_advance(void* handle, int64_t step_ms);
+auto f_model_clock_timestamp(const void* handle) -> int64_t;
+auto f_model_clock_year(const void* handle) -> int;
+auto f_model_clock_month(const void* handle) -> int;
+auto f_model_clock_day(const void* handle) -> int;
+auto f_model_clock_hour(const void* handle) -> int;
+auto f_model_clock_minute(const void* handle) -> int;
+auto f_model_clock_second(const void* handle) -> int;
+auto f_model_clock_millisecond(const void* handle) -> int;
+auto f_model_clock_day_of_year(const void* handle) -> int;
+auto f_model_clock_crossed_hour(const void* handle) -> bool;
+auto f_model_clock_crossed_day(const void* handle) -> bool;
+auto f_model_clock_crossed_month(const void* handle) -> bool;
+auto f_model_clock_crossed_year(const void* handle) -> bool;
+
+//=============================================================================
+// AlarmSet functions
+//=============================================================================
+
+auto f_alarm_set_create() -> void*;
+void f_alarm_set_destroy(void* handle);
+auto f_alarm_set_add_interval(void* handle, int64_t first_ms,
+                              int64_t interval_ms) -> int;
+auto f_alarm_set_add_monthly(void* handle, int64_t first_ms, int months) -> int;
+auto f_alarm_set_size(const void* handle) -> int;
+auto f_alarm_set_next_time(const void* handle) -> int64_t;
+auto f_alarm_set_alarm_next_time(const void* handle, int id) -> int64_t;
+auto f_alarm_set_due(const void* handle, int64_t now_ms) -> bool;
+auto f_alarm_set_pop(void* handle, int64_t now_ms) -> int;
+
+//=============================================================================
+// CF time units functions
+//=============================================================================
+
+auto f_datetime_cf_units_parse(const char* units, int units_len,
+                               int64_t* unit_ms, int64_t* epoch_ms) -> bool;
+void f_datetime_cf_decode_double(int64_t unit_ms, int64_t epoch_ms,
+                                 const double* values, int count,
+                                 int64_t* dt_ms);
+void f_datetime_cf_decode_int32(int64_t unit_ms, int64_t epoch_ms,
+                                const int32_t* values, int count,
+                                int64_t* dt_ms);
+void f_datetime_cf_decode_int64(int64_t unit_ms, int64_t epoch_ms,
+                                const int64_t* values, int count,
+                                int64_t* dt_ms);
+void f_datetime_cf_encode_double(int64_t unit_ms, int64_t epoch_ms,
+                                 const int64_t* dt_ms, int count,
+                                 double* values);
+void f_datetime_cf_encode_int64(int64_t unit_ms, int64_t epoch_ms,
+                                const int64_t* dt_ms, int count,
+                                int64_t* values);
+
+//=============================================================================
+// Delimited text functions
+//=============================================================================
+
+auto f_datetime_text_column_read(const char* filename, int filename_len,
+                                 const char* format, int format_len,
+                                 char delimiter, int column, int span,
+                                 int header_lines, char comment) -> void*;
+void f_datetime_text_column_destroy(void* handle);
+auto f_datetime_text_column_size(const void* handle) -> int64_t;
+void f_datetime_text_column_copy(const void* handle, int64_t count,
+                                 int64_t* dt_ms, bool* valid);
+
+//=============================================================================
+// Error reporting functions
+//=============================================================================
+
+auto f_fdate_last_error() -> int;
+void f_fdate_last_error_message(char* buffer, int buffer_size);
+void f_fdate_clear_error();
+auto f_fdate_max_threads() -> int;
+
+//=============================================================================
+// Instrumentation functions
+//=============================================================================
+
+auto f_fdate_stats_enabled() -> bool;
+auto f_fdate_stats_get(int64_t* values, int count) -> int;
+void f_fdate_stats_reset();
+void f_fdate_stats_format_name(int slot, char* buffer, int buffer_size);
+
+}  // extern "C"
@@ -1,10 +1,33 @@
 #define CATCH_CONFIG_MAIN
 #include <catch2/catch_approx.hpp>
 #include <catch2/catch_test_macros.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
 #include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <string_view>
 #include <thread>
+#include <vector>
 
+#include "AlarmSet.hpp"
+#include "CFTimeUnits.hpp"
+#include "CalendarKernels.hpp"
+#include "CalendarTable.hpp"
 #include "DateTime.hpp"
+#include "DateTimeFormatSet.hpp"
+#include "DateTimeIndex.hpp"
+#include "DateTimeRange.hpp"
+#include "DelimitedTimeReader.hpp"
+#include "FDateError.hpp"
+#include "FDateStats.hpp"
+#include "ModelClock.hpp"
+#include "ParallelBlocks.hpp"
+#include "TimeAxis.hpp"
 #include "TimeDelta.hpp"
 
 // ====================================================
@@ -318,6 +341,77 @@ TEST_CASE("TimeDelta string representation", "[timedelta]") {
   }
 }
 
+TEST_CASE("TimeDelta format_to and parse", "[timedelta]") {
+  SECTION("format_to matches toString and truncates like snprintf") {
+    const TimeDelta ts(1, 14, 30, 25, 123);
+    std::array<char, 32> buffer{};
+    CHECK(ts.format_to(buffer.data(), buffer.size()) == 15);
+    CHECK(std::string(buffer.data()) == "1d 14:30:25.123");
+
+    std::array<char, 6> small{};
+    CHECK(ts.format_to(small.data(), small.size()) == 15);
+    CHECK(std::string(small.data()) == "1d 14");
+    CHECK(ts.format_to(nullptr, 0) == 15);
+  }
+
+  SECTION("Negative and extreme values") {
+    CHECK(TimeDelta::fromMilliseconds(-86400250).toString() ==
+          "-1d 00:00:00.250");
+    CHECK(TimeDelta::fromSeconds(-90).toString() == "-00:01:30");
+    const auto lowest =
+        TimeDelta::fromMilliseconds(std::numeric_limits<int64_t>::min());
+    CHECK(lowest.toString() == "-106751991167d 07:12:55.808");
+    CHECK(lowest.toString().size() == TimeDelta::MAX_STRING_LENGTH);
+  }
+
+  SECTION("Round trip through toString") {
+    for (const int64_t ms : {int64_t{0}, int64_t{5}, int64_t{-5},
+                             int64_t{3723004}, int64_t{-90061001},
+                             int64_t{86400000} * 400}) {
+      TimeDelta parsed;
+      const auto ts = TimeDelta::fromMilliseconds(ms);
+      REQUIRE(TimeDelta::parse(ts.toString(), parsed));
+      CHECK(parsed == ts);
+    }
+  }
+
+  SECTION("Clock form") {
+    TimeDelta ts;
+    CHECK(TimeDelta::parse("  36:00:00.5 ", ts));
+    CHECK(ts.totalMilliseconds() == 129600500);
+    CHECK(TimeDelta::parse("+2d 00:00:01", ts));
+    CHECK(ts.totalMilliseconds() == 172801000);
+    CHECK(TimeDelta::parse("00:00:00.123456", ts));
+    CHECK(ts.totalMilliseconds() == 123);
+  }
+
+  SECTION("ISO 8601 durations") {
+    TimeDelta ts;
+    CHECK(TimeDelta::parse("P1DT2H30M", ts));
+    CHECK(ts == TimeDelta(1, 2, 30, 0, 0));
+    CHECK(TimeDelta::parse("PT90M", ts));
+    CHECK(ts == TimeDelta::fromMinutes(90));
+    CHECK(TimeDelta::parse("P2W", ts));
+    CHECK(ts == TimeDelta::fromDays(14));
+    CHECK(TimeDelta::parse("-PT0,25S", ts));
+    CHECK(ts == TimeDelta::fromMilliseconds(-250));
+    CHECK(TimeDelta::parse("P1W2DT3H4M5.006S", ts));
+    CHECK(ts == TimeDelta(9, 3, 4, 5, 6));
+  }
+
+  SECTION("Invalid strings leave the result unchanged") {
+    const auto sentinel = TimeDelta::fromSeconds(42);
+    for (const char* str :
+         {"", "   ", "-", "P", "PT", "P1Y", "P1M", "PT1H2D", "P1DT", "PT1.5H",
+          "PT1H1H", "P1D2W", "12:60:00", "12:00", "1:2:3", "1d", "1d12:00:00",
+          "12:00:00.", "12:00:00x", "PT1S2", "P99999999999999999999D"}) {
+      auto ts = sentinel;
+      CHECK_FALSE(TimeDelta::parse(str, ts));
+      CHECK(ts == sentinel);
+    }
+  }
+}
+
 TEST_CASE("DateTime constructors", "[datetime]") {
   SECTION("Default constructor") {
     DateTime dt;
@@ -1454,3 +1548,1583 @@ TEST_CASE("DateTime Julian Day functionality", "[datetime][julian]") {
           Catch::Approx(0.99999998835846782).epsilon(1e-6));
   }
 }
+
+TEST_CASE("DateTime fixed-width fast path parsing", "[datetime][fast_path]") {
+  SECTION("Matches the expected timestamps") {
+    const auto expected = DateTime(2024, 3, 15, 14, 30, 25).timestamp();
+    CHECK(DateTime::strptime("2024-03-15 14:30:25", "%Y-%m-%d %H:%M:%S")
+              .timestamp() == expected);
+    CHECK(DateTime::strptime("2024-03-15T14:30:25Z", "%Y-%m-%dT%H:%M:%SZ")
+              .timestamp() == expected);
+    CHECK(DateTime::strptime("2024-03-15T14:30:25", "%Y-%m-%dT%H:%M:%S")
+              .timestamp() == expected);
+    CHECK(DateTime::strptime("20240315143025", "%Y%m%d%H%M%S").timestamp() ==
+          expected);
+  }
+
+  SECTION("Millisecond suffix") {
+    const auto expected = DateTime(2024, 3, 15, 14, 30, 25, 123).timestamp();
+    CHECK(DateTime::strptime("2024-03-15 14:30:25.123", "%Y-%m-%d %H:%M:%S")
+              .timestamp() == expected);
+    CHECK(DateTime::strptime("2024-03-15T14:30:25.123", "%Y-%m-%dT%H:%M:%S")
+              .timestamp() == expected);
+    CHECK(DateTime::strptime("20240315143025.123", "%Y%m%d%H%M%S")
+              .timestamp() == expected);
+  }
+
+  SECTION("Out of range fields are rejected") {
+    CHECK_FALSE(
+        DateTime::strptime("2024-02-30 00:00:00", "%Y-%m-%d %H:%M:%S").valid());
+    CHECK_FALSE(
+        DateTime::strptime("2023-02-29T00:00:00", "%Y-%m-%dT%H:%M:%S").valid());
+    CHECK_FALSE(DateTime::strptime("20241301000000", "%Y%m%d%H%M%S").valid());
+    CHECK_FALSE(
+        DateTime::strptime("2024-03-15 24:00:00", "%Y-%m-%d %H:%M:%S").valid());
+    CHECK_FALSE(DateTime::strptime("2024-03-15T14:60:00Z", "%Y-%m-%dT%H:%M:%SZ")
+                    .valid());
+    CHECK_FALSE(
+        DateTime::strptime("2024-03-15 14:30:60", "%Y-%m-%d %H:%M:%S").valid());
+  }
+
+  SECTION("Non fixed-width input falls back to the stream parser") {
+    // Single digit fields are accepted by the stream based parser
+    const auto dt = DateTime::strptime("2024-3-5 4:05:06", "%Y-%m-%d %H:%M:%S");
+    REQUIRE(dt.valid());
+    CHECK(dt.timestamp() == DateTime(2024, 3, 5, 4, 5, 6).timestamp());
+
+    // Trailing whitespace is ignored by the stream based parser
+    CHECK(DateTime::strptime("2024-03-15 14:30:25 ", "%Y-%m-%d %H:%M:%S")
+              .valid());
+
+    CHECK_FALSE(DateTime::strptime("2024-03-15 14:30:25x", "%Y-%m-%d %H:%M:%S")
+                    .valid());
+    CHECK_FALSE(DateTime::strptime("2024-03-15T14:30:25.123Z",
+                                   "%Y-%m-%dT%H:%M:%SZ")
+                    .valid());
+  }
+}
+
+TEST_CASE("DateTime auto-detection shape classification", "[datetime][auto]") {
+  SECTION("Canonical shapes match the explicit format") {
+    const std::vector<std::pair<std::string, std::string>> cases = {
+        {"2024-03-15 14:30:25", "%Y-%m-%d %H:%M:%S"},
+        {"2024-03-15T14:30:25Z", "%Y-%m-%dT%H:%M:%SZ"},
+        {"2024-03-15T14:30:25.250", "%Y-%m-%dT%H:%M:%S"},
+        {"2024/03/15 14:30:25.500", "%Y/%m/%d %H:%M:%S"},
+        {"2024.03.15 14:30:25", "%Y.%m.%d %H:%M:%S"},
+        {"20240315143025", "%Y%m%d%H%M%S"},
+        {"2024/03/15 14:30", "%Y/%m/%d %H:%M"},
+        {"2024-03-15", "%Y-%m-%d"},
+        {"2024/03/15", "%Y/%m/%d"},
+        {"2024.03.15", "%Y.%m.%d"},
+        {"20240315", "%Y%m%d"}};
+
+    for (const auto& [str, fmt] : cases) {
+      INFO("Input: " << str);
+      const auto automatic = DateTime::strptime(str);
+      REQUIRE(automatic.valid());
+      CHECK(automatic.timestamp() == DateTime::strptime(str, fmt).timestamp());
+    }
+  }
+
+  SECTION("Invalid values in a canonical shape are rejected") {
+    CHECK_FALSE(DateTime::strptime("2024/02/30 14:30").valid());
+    CHECK_FALSE(DateTime::strptime("20241315").valid());
+    CHECK_FALSE(DateTime::strptime("2024.03.15 14:30:60").valid());
+    CHECK_FALSE(DateTime::strptime("20240315250000").valid());
+  }
+
+  SECTION("Non-canonical shapes still use the ordered format list") {
+    const auto dt = DateTime::strptime("2024-3-5 4:05:06");
+    REQUIRE(dt.valid());
+    CHECK(dt.timestamp() == DateTime(2024, 3, 5, 4, 5, 6).timestamp());
+
+    const auto compact = DateTime::strptime("2024031514305");
+    REQUIRE(compact.valid());
+    CHECK(compact.timestamp() == DateTime(2024, 3, 15, 14, 30, 5).timestamp());
+
+    CHECK_FALSE(DateTime::strptime("2024-03-15 14:30").valid());
+    CHECK_FALSE(DateTime::strptime("20240315.123").valid());
+  }
+}
+
+TEST_CASE("DateTime compiled format parsing and formatting",
+          "[datetime][format]") {
+  SECTION("Parsing matches the format string") {
+    const DateTimeFormat format("%Y-%m-%d %H:%M:%S");
+    REQUIRE(format.is_compiled());
+
+    const std::vector<std::string> inputs = {
+        "2024-03-15 14:30:25", "2024-03-15 14:30:25.123",
+        "2024-3-5 4:05:06",    "2024-03-15 14:30:25 ",
+        "2024-02-30 14:30:25", "2024-03-15 24:00:00",
+        "2024-03-15 14:30:25x", "not a date"};
+    for (const auto& input : inputs) {
+      const auto compiled = DateTime::strptime(input, format);
+      const auto reference = DateTime::strptime(input, format.pattern());
+      CHECK(compiled.valid() == reference.valid());
+      CHECK(compiled.timestamp() == reference.timestamp());
+    }
+  }
+
+  SECTION("Formatting matches the format string") {
+    const std::vector<std::string> patterns = {
+        "%Y-%m-%d %H:%M:%S", "%d/%m/%Y %H:%M", "%FT%T", "%Y%m%d%H%M%S",
+        "%Y %% %R", "%A, %d %B %Y"};
+    const std::vector<DateTime> values = {
+        DateTime(2024, 3, 15, 14, 30, 25, 123), DateTime(1970, 1, 1),
+        DateTime(int64_t{-1500}), DateTime(12000, 6, 1, 1, 2, 3)};
+    for (const auto& pattern : patterns) {
+      const DateTimeFormat format(pattern);
+      for (const auto& value : values) {
+        CHECK(value.strftime(format) == value.strftime(pattern));
+        CHECK(value.strftime_w_milliseconds(format) ==
+              value.strftime_w_milliseconds(pattern));
+      }
+    }
+  }
+
+  SECTION("Unsupported specifiers fall back to the stream") {
+    const DateTimeFormat format("%A %Y-%m-%d");
+    CHECK_FALSE(format.is_compiled());
+
+    const DateTime dt(2024, 3, 15);
+    CHECK(dt.strftime(format) == dt.strftime("%A %Y-%m-%d"));
+  }
+
+  SECTION("Auto format uses automatic detection") {
+    const DateTimeFormat format("auto");
+    CHECK(format.is_auto());
+
+    const auto dt = DateTime::strptime("2024/03/15 14:30", format);
+    REQUIRE(dt.valid());
+    CHECK(dt.timestamp() == DateTime(2024, 3, 15, 14, 30).timestamp());
+  }
+}
+
+TEST_CASE("DateTime format_to writes into a caller buffer",
+          "[datetime][format_to]") {
+  const DateTime dt(2024, 3, 15, 14, 30, 25, 123);
+  const std::string pattern = "%Y-%m-%d %H:%M:%S";
+
+  SECTION("Output matches strftime") {
+    std::array<char, 64> buffer{};
+    auto size = dt.format_to(buffer.data(), buffer.size(), pattern.data(),
+                             pattern.size());
+    CHECK(size == 19);
+    CHECK(std::string(buffer.data()) == dt.strftime(pattern));
+
+    size = dt.format_to(buffer.data(), buffer.size(), pattern.data(),
+                        pattern.size(), true);
+    CHECK(size == 23);
+    CHECK(std::string(buffer.data()) == dt.strftime_w_milliseconds(pattern));
+
+    const DateTimeFormat format(pattern);
+    size = dt.format_to(buffer.data(), buffer.size(), format, true);
+    CHECK(size == 23);
+    CHECK(std::string(buffer.data()) == "2024-03-15 14:30:25.123");
+  }
+
+  SECTION("Output is truncated and null terminated") {
+    std::array<char, 8> buffer{};
+    buffer.fill('x');
+    const auto size = dt.format_to(buffer.data(), buffer.size(),
+                                   pattern.data(), pattern.size());
+    CHECK(size == 19);
+    CHECK(std::string(buffer.data()) == "2024-03");
+
+    CHECK(dt.format_to(nullptr, 0, pattern.data(), pattern.size()) == 19);
+  }
+
+  SECTION("Unsupported specifiers use the stream") {
+    const std::string weekday = "%A %Y-%m-%d";
+    std::array<char, 64> buffer{};
+    const auto size = dt.format_to(buffer.data(), buffer.size(),
+                                   weekday.data(), weekday.size());
+    CHECK(std::string(buffer.data()) == "Friday 2024-03-15");
+    CHECK(size == 17);
+  }
+
+  SECTION("Negative timestamps truncate like strftime") {
+    const DateTime before_epoch(int64_t{-1500});
+    std::array<char, 64> buffer{};
+    before_epoch.format_to(buffer.data(), buffer.size(), pattern.data(),
+                           pattern.size());
+    CHECK(std::string(buffer.data()) == "1969-12-31 23:59:59");
+  }
+}
+
+TEST_CASE("DateTime format_array_to fills a fixed-width block",
+          "[datetime][format_to]") {
+  const std::vector<int64_t> timestamps = {
+      DateTime(2024, 3, 15, 14, 30, 25, 123).timestamp(),
+      DateTime(1970, 1, 1).timestamp(), int64_t{-1500},
+      DateTime(12000, 6, 1, 1, 2, 3).timestamp()};
+
+  SECTION("Each element matches strftime padded with blanks") {
+    const std::string pattern = "%Y-%m-%dT%H:%M:%S";
+    const DateTimeFormat format(pattern);
+    constexpr size_t width = 25;
+    for (const bool milliseconds : {false, true}) {
+      std::string block(timestamps.size() * width, 'x');
+      DateTime::format_array_to(timestamps.data(), timestamps.size(), format,
+                                &block[0], width, milliseconds);
+      for (size_t i = 0; i < timestamps.size(); ++i) {
+        const DateTime dt(timestamps[i]);
+        auto expected = milliseconds ? dt.strftime_w_milliseconds(pattern)
+                                     : dt.strftime(pattern);
+        expected.resize(width, ' ');
+        CHECK(block.substr(i * width, width) == expected);
+      }
+    }
+  }
+
+  SECTION("Long results are truncated to the width") {
+    const DateTimeFormat format("%Y-%m-%d %H:%M:%S");
+    constexpr size_t width = 10;
+    std::string block(timestamps.size() * width, 'x');
+    DateTime::format_array_to(timestamps.data(), timestamps.size(), format,
+                              &block[0], width);
+    CHECK(block.substr(0, width) == "2024-03-15");
+    CHECK(block.substr(width, width) == "1970-01-01");
+  }
+}
+
+TEST_CASE("DateTime to_fields matches the individual getters",
+          "[datetime][fields]") {
+  const std::vector<int64_t> timestamps = {
+      0,
+      DateTime(2024, 2, 29, 23, 59, 59, 999).timestamp(),
+      DateTime(1582, 10, 15, 12, 0, 0).timestamp(),
+      int64_t{-1},
+      int64_t{-86400001},
+      DateTime(9999, 12, 31, 1, 2, 3, 4).timestamp()};
+
+  for (const auto timestamp : timestamps) {
+    const DateTime dt(timestamp);
+    const auto fields = dt.to_fields();
+    CHECK(fields.year == dt.year());
+    CHECK(fields.month == dt.month());
+    CHECK(fields.day == dt.day());
+    CHECK(fields.hour == dt.hour());
+    CHECK(fields.minute == dt.minute());
+    CHECK(fields.second == dt.second());
+    CHECK(fields.millisecond == dt.millisecond());
+  }
+
+  const auto fields = DateTime(int64_t{-1}).to_fields();
+  CHECK(fields.year == 1969);
+  CHECK(fields.month == 12);
+  CHECK(fields.day == 31);
+  CHECK(fields.hour == 23);
+  CHECK(fields.minute == 59);
+  CHECK(fields.second == 59);
+  CHECK(fields.millisecond == 999);
+}
+
+TEST_CASE("CalendarKernels match the scalar getters and constructor",
+          "[datetime][kernels]") {
+  std::vector<int64_t> timestamps = {
+      0,
+      int64_t{-1},
+      int64_t{-86400000},
+      int64_t{-86400001},
+      DateTime(2024, 2, 29, 23, 59, 59, 999).timestamp(),
+      DateTime(1582, 10, 15, 12, 0, 0).timestamp(),
+      DateTime(1, 1, 1).timestamp(),
+      DateTime(9999, 12, 31, 23, 59, 59, 999).timestamp(),
+      DateTime::INVALID_TIMESTAMP,
+      std::numeric_limits<int64_t>::max()};
+
+  // Spread over several blocks with a partial block at the end
+  uint64_t state = 0x2545F4914F6CDD1DULL;
+  for (size_t i = 0; i < 3 * CalendarKernels::BLOCK_SIZE + 17; ++i) {
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    timestamps.push_back(static_cast<int64_t>(state % 600000000000000ULL) -
+                         300000000000000);
+  }
+
+  const size_t n = timestamps.size();
+  std::vector<int> year(n), month(n), day(n), hour(n), minute(n), second(n),
+      millisecond(n);
+  CalendarKernels::timestamps_to_fields(
+      timestamps.data(), n, year.data(), month.data(), day.data(), hour.data(),
+      minute.data(), second.data(), millisecond.data());
+
+  for (size_t i = 0; i < n; ++i) {
+    const DateTime dt(timestamps[i]);
+    REQUIRE(year[i] == dt.year());
+    REQUIRE(static_cast<unsigned>(month[i]) == dt.month());
+    REQUIRE(static_cast<unsigned>(day[i]) == dt.day());
+    REQUIRE(static_cast<unsigned>(hour[i]) == dt.hour());
+    REQUIRE(static_cast<unsigned>(minute[i]) == dt.minute());
+    REQUIRE(static_cast<unsigned>(second[i]) == dt.second());
+    REQUIRE(static_cast<unsigned>(millisecond[i]) == dt.millisecond());
+  }
+
+  // Round trip the representable values through the inverse kernel
+  timestamps.erase(timestamps.begin() + 8, timestamps.begin() + 10);
+  year.erase(year.begin() + 8, year.begin() + 10);
+  month.erase(month.begin() + 8, month.begin() + 10);
+  day.erase(day.begin() + 8, day.begin() + 10);
+  hour.erase(hour.begin() + 8, hour.begin() + 10);
+  minute.erase(minute.begin() + 8, minute.begin() + 10);
+  second.erase(second.begin() + 8, second.begin() + 10);
+  millisecond.erase(millisecond.begin() + 8, millisecond.begin() + 10);
+
+  std::vector<int64_t> round_trip(timestamps.size());
+  CalendarKernels::fields_to_timestamps(
+      year.data(), month.data(), day.data(), hour.data(), minute.data(),
+      second.data(), millisecond.data(), timestamps.size(), round_trip.data());
+  for (size_t i = 0; i < timestamps.size(); ++i) {
+    if (year[i] < DateTime::DATETIME_MIN_YEAR) {
+      REQUIRE(round_trip[i] == DateTime::INVALID_TIMESTAMP);
+    } else {
+      REQUIRE(round_trip[i] == timestamps[i]);
+    }
+  }
+
+  // Invalid components give an invalid timestamp
+  const std::array<int, 2> bad_year = {2024, 2024};
+  const std::array<int, 2> bad_month = {13, 1};
+  const std::array<int, 2> bad_day = {1, 1};
+  const std::array<int, 2> bad_hour = {0, 24};
+  const std::array<int, 2> zeros = {0, 0};
+  std::array<int64_t, 2> bad_result{};
+  CalendarKernels::fields_to_timestamps(
+      bad_year.data(), bad_month.data(), bad_day.data(), bad_hour.data(),
+      zeros.data(), zeros.data(), zeros.data(), 2, bad_result.data());
+  CHECK(bad_result[0] == DateTime::INVALID_TIMESTAMP);
+  CHECK(bad_result[1] == DateTime::INVALID_TIMESTAMP);
+
+  // Null outputs are skipped and null clock fields are taken as zero
+  std::vector<int> only_day(timestamps.size());
+  CalendarKernels::timestamps_to_fields(timestamps.data(), timestamps.size(),
+                                        nullptr, nullptr, only_day.data(),
+                                        nullptr, nullptr, nullptr, nullptr);
+  CHECK(only_day == day);
+
+  std::vector<int64_t> midnight(timestamps.size());
+  CalendarKernels::fields_to_timestamps(year.data(), month.data(), day.data(),
+                                        nullptr, nullptr, nullptr, nullptr,
+                                        timestamps.size(), midnight.data());
+  for (size_t i = 0; i < timestamps.size(); ++i) {
+    if (year[i] >= DateTime::DATETIME_MIN_YEAR) {
+      REQUIRE(midnight[i] == DateTime(year[i], month[i], day[i]).timestamp());
+    }
+  }
+}
+
+TEST_CASE("CalendarKernels Julian Day matches DateTime::julianDay",
+          "[datetime][kernels][julian]") {
+  std::vector<int64_t> timestamps = {
+      0,
+      int64_t{-1},
+      DateTime(2000, 1, 1, 12, 0, 0).timestamp(),
+      DateTime(1, 1, 1, 6, 30, 15, 250).timestamp(),
+      DateTime(9999, 12, 31, 23, 59, 59, 999).timestamp(),
+      DateTime::INVALID_TIMESTAMP,
+      std::numeric_limits<int64_t>::max()};
+
+  uint64_t state = 0x9E3779B97F4A7C15ULL;
+  for (size_t i = 0; i < 2 * CalendarKernels::BLOCK_SIZE + 5; ++i) {
+    state ^= state << 13U;
+    state ^= state >> 7U;
+    state ^= state << 17U;
+    timestamps.push_back(static_cast<int64_t>(state % 2000000000000000ULL) -
+                         1000000000000000);
+  }
+
+  const size_t n = timestamps.size();
+  std::vector<double> jd(n);
+  std::vector<double> jc(n);
+  CalendarKernels::julian_days(timestamps.data(), n, jd.data());
+  CalendarKernels::julian_centuries(timestamps.data(), n, jc.data());
+
+  for (size_t i = 0; i < n; ++i) {
+    const DateTime dt(timestamps[i]);
+    REQUIRE(jd[i] == dt.julianDay());
+    REQUIRE(jc[i] == dt.julianCentury());
+  }
+  CHECK(jd[2] == 2451545.0);
+  CHECK(jc[2] == 0.0);
+}
+
+TEST_CASE("DateTime rounds to intervals and calendar months",
+          "[datetime][rounding]") {
+  const DateTime dt(2024, 5, 17, 13, 45, 30, 250);
+  const auto hour = TimeDelta::fromHours(1);
+
+  SECTION("Interval rounding from the epoch") {
+    CHECK(dt.floor(hour) == DateTime(2024, 5, 17, 13, 0, 0));
+    CHECK(dt.ceil(hour) == DateTime(2024, 5, 17, 14, 0, 0));
+    CHECK(dt.round(hour) == DateTime(2024, 5, 17, 14, 0, 0));
+    CHECK(dt.round(TimeDelta::fromDays(1)) == DateTime(2024, 5, 18));
+    CHECK(DateTime(2024, 5, 17, 13, 30, 0).round(hour) ==
+          DateTime(2024, 5, 17, 14, 0, 0));
+    CHECK(DateTime(2024, 5, 17, 13).ceil(hour) == DateTime(2024, 5, 17, 13));
+  }
+
+  SECTION("Interval rounding before the epoch and from an origin") {
+    const DateTime before(1969, 12, 31, 23, 59, 59, 999);
+    CHECK(before.floor(hour) == DateTime(1969, 12, 31, 23, 0, 0));
+    CHECK(before.ceil(hour) == DateTime(1970, 1, 1));
+
+    const DateTime origin(2024, 5, 17, 0, 10, 0);
+    CHECK(dt.floor(TimeDelta::fromMinutes(30), origin) ==
+          DateTime(2024, 5, 17, 13, 40, 0));
+  }
+
+  SECTION("Invalid inputs give an invalid DateTime") {
+    CHECK_FALSE(dt.floor(TimeDelta()).valid());
+    CHECK_FALSE(dt.ceil(TimeDelta::fromHours(-1)).valid());
+    CHECK_FALSE(DateTime(DateTime::INVALID_TIMESTAMP).round(hour).valid());
+    CHECK_FALSE(dt.floor_to_month(0).valid());
+  }
+
+  SECTION("Calendar month rounding") {
+    CHECK(dt.floor_to_month() == DateTime(2024, 5, 1));
+    CHECK(dt.ceil_to_month() == DateTime(2024, 6, 1));
+    CHECK(dt.floor_to_month(3) == DateTime(2024, 4, 1));
+    CHECK(dt.floor_to_month(12) == DateTime(2024, 1, 1));
+    CHECK(dt.ceil_to_month(12) == DateTime(2025, 1, 1));
+    CHECK(DateTime(2024, 1, 1).ceil_to_month(12) == DateTime(2024, 1, 1));
+    CHECK(DateTime(1969, 2, 3).floor_to_month(3) == DateTime(1969, 1, 1));
+  }
+}
+
+TEST_CASE("CalendarKernels rounding and binning match DateTime",
+          "[datetime][rounding]") {
+  std::vector<int64_t> timestamps;
+  for (int64_t t = DateTime(1968, 11, 3).timestamp();
+       t < DateTime(1971, 2, 1).timestamp(); t += 7 * 3600 * 1000 + 1234) {
+    timestamps.push_back(t);
+  }
+  timestamps.push_back(DateTime(-30000, 6, 15).timestamp());
+  timestamps.push_back(DateTime::INVALID_TIMESTAMP);
+
+  const size_t n = timestamps.size();
+  const auto interval = TimeDelta::fromHours(6);
+  const DateTime origin(2000, 1, 1, 3);
+  std::vector<int64_t> floors(n);
+  std::vector<int64_t> ceils(n);
+  std::vector<int64_t> nearest(n);
+  std::vector<int64_t> quarters(n);
+
+  CalendarKernels::round_to_interval(
+      timestamps.data(), n, interval.totalMilliseconds(), origin.timestamp(),
+      CalendarKernels::e_Rounding::FLOOR, floors.data());
+  CalendarKernels::round_to_interval(
+      timestamps.data(), n, interval.totalMilliseconds(), origin.timestamp(),
+      CalendarKernels::e_Rounding::CEIL, ceils.data());
+  CalendarKernels::round_to_interval(
+      timestamps.data(), n, interval.totalMilliseconds(), origin.timestamp(),
+      CalendarKernels::e_Rounding::NEAREST, nearest.data());
+  CalendarKernels::floor_to_months(timestamps.data(), n, 3, quarters.data());
+
+  for (size_t i = 0; i < n; ++i) {
+    const DateTime dt(timestamps[i]);
+    REQUIRE(floors[i] == dt.floor(interval, origin).timestamp());
+    REQUIRE(ceils[i] == dt.ceil(interval, origin).timestamp());
+    REQUIRE(nearest[i] == dt.round(interval, origin).timestamp());
+    REQUIRE(quarters[i] == dt.floor_to_month(3).timestamp());
+  }
+
+  SECTION("Sorted arrays split into contiguous bins") {
+    const std::vector<int64_t> sorted(timestamps.begin(), timestamps.end() - 2);
+    std::vector<int> starts(sorted.size());
+    std::vector<int64_t> bin_times(sorted.size());
+    const auto day = TimeDelta::fromDays(1);
+
+    const size_t n_days = CalendarKernels::bin_by_interval(
+        sorted.data(), sorted.size(), day.totalMilliseconds(), 0,
+        starts.data(), bin_times.data());
+    REQUIRE(n_days > 0);
+    CHECK(starts[0] == 0);
+    for (size_t b = 0; b < n_days; ++b) {
+      const size_t end = b + 1 < n_days ? static_cast<size_t>(starts[b + 1])
+                                        : sorted.size();
+      for (auto i = static_cast<size_t>(starts[b]); i < end; ++i) {
+        REQUIRE(DateTime(sorted[i]).floor(day).timestamp() == bin_times[b]);
+      }
+    }
+
+    const size_t n_months = CalendarKernels::bin_by_months(
+        sorted.data(), sorted.size(), 1, starts.data(), bin_times.data());
+    CHECK(n_months == 27);
+    CHECK(bin_times[0] == DateTime(1968, 11, 1).timestamp());
+    CHECK(bin_times[n_months - 1] == DateTime(1971, 1, 1).timestamp());
+  }
+}
+
+TEST_CASE("DateTimeRange generates evenly spaced DateTimes",
+          "[datetime][range]") {
+  const DateTime start(2024, 1, 1);
+  const DateTimeRange hourly(start, DateTime(2024, 1, 2),
+                             TimeDelta::fromHours(1));
+
+  SECTION("Size includes the end point") {
+    CHECK(hourly.size() == 25);
+    CHECK_FALSE(hourly.empty());
+    CHECK(hourly[0] == start);
+    CHECK(hourly[24] == DateTime(2024, 1, 2));
+    CHECK(hourly[5] == start + TimeDelta::fromHours(5));
+  }
+
+  SECTION("End point not on a step is excluded") {
+    const DateTimeRange range(start, DateTime(2024, 1, 1, 2, 30, 0),
+                              TimeDelta::fromHours(1));
+    CHECK(range.size() == 3);
+  }
+
+  SECTION("Iteration matches repeated addition") {
+    DateTime expected = start;
+    size_t n = 0;
+    for (const auto& dt : hourly) {
+      CHECK(dt == expected);
+      expected = expected + TimeDelta::fromHours(1);
+      ++n;
+    }
+    CHECK(n == hourly.size());
+    CHECK(hourly.end() - hourly.begin() == 25);
+    CHECK(*(hourly.begin() + 3) == hourly[3]);
+  }
+
+  SECTION("Descending and empty ranges") {
+    const DateTimeRange descending(DateTime(2024, 1, 2), start,
+                                   TimeDelta::fromHours(-6));
+    CHECK(descending.size() == 5);
+    CHECK(descending[4] == start);
+
+    CHECK(DateTimeRange(start, DateTime(2023, 12, 31), TimeDelta::fromHours(1))
+              .empty());
+    CHECK(DateTimeRange(start, DateTime(2024, 1, 2), TimeDelta()).empty());
+    CHECK(DateTimeRange(start, start, TimeDelta::fromHours(1)).size() == 1);
+  }
+
+  SECTION("Invalid end points give an empty range") {
+    const DateTime invalid(DateTime::INVALID_TIMESTAMP);
+    CHECK(DateTimeRange(invalid, start, TimeDelta::fromHours(1)).empty());
+    CHECK(DateTimeRange(start, invalid, TimeDelta::fromHours(-1)).empty());
+    CHECK(DateTimeRange::count(DateTime::INVALID_TIMESTAMP, 0, 1) == 0);
+    CHECK(DateTimeRange::count(std::numeric_limits<int64_t>::max(),
+                               -std::numeric_limits<int64_t>::max() + 1,
+                               std::numeric_limits<int64_t>::min()) == 2);
+    CHECK(DateTimeRange::count(-std::numeric_limits<int64_t>::max() + 1,
+                               std::numeric_limits<int64_t>::max(), 1) ==
+          std::numeric_limits<int64_t>::max());
+  }
+
+  SECTION("Fill and from_count") {
+    const auto range =
+        DateTimeRange::from_count(start, TimeDelta::fromMinutes(15), 8);
+    std::vector<int64_t> timestamps(range.size());
+    range.fill(timestamps.data());
+    for (size_t i = 0; i < timestamps.size(); ++i) {
+      CHECK(timestamps[i] == range[i].timestamp());
+      CHECK(timestamps[i] == range.timestamp(i));
+    }
+    CHECK(range[7] == start + TimeDelta::fromMinutes(105));
+  }
+}
+
+TEST_CASE("DateTimeIndex brackets times on a sorted axis",
+          "[datetime][index]") {
+  const int64_t hour = 3600000;
+  const int64_t start = DateTime(2024, 1, 1).timestamp();
+
+  SECTION("Uniform axis") {
+    std::vector<int64_t> axis;
+    for (int64_t i = 0; i < 48; ++i) {
+      axis.push_back(start + i * hour);
+    }
+    DateTimeIndex index(axis);
+    REQUIRE(index.size() == 48);
+
+    auto result = index.bracket(start + 3 * hour + hour / 4);
+    CHECK(result.index == 3);
+    CHECK(result.weight == Catch::Approx(0.25));
+    CHECK(result.in_range);
+
+    result = index.bracket(DateTime(2024, 1, 1, 10, 0, 0));
+    CHECK(result.index == 10);
+    CHECK(result.weight == 0.0);
+
+    result = index.bracket(start - 1);
+    CHECK(result.index == 0);
+    CHECK(result.weight == 0.0);
+    CHECK_FALSE(result.in_range);
+
+    result = index.bracket(axis.back());
+    CHECK(result.index == 46);
+    CHECK(result.weight == 1.0);
+    CHECK(result.in_range);
+
+    result = index.bracket(axis.back() + 1);
+    CHECK(result.index == 46);
+    CHECK(result.weight == 1.0);
+    CHECK_FALSE(result.in_range);
+  }
+
+  SECTION("Irregular axis matches a binary search") {
+    std::vector<int64_t> axis = {start};
+    uint64_t state = 0x853C49E6748FEA9BULL;
+    auto next = [&state]() {
+      state ^= state << 13U;
+      state ^= state >> 7U;
+      state ^= state << 17U;
+      return state;
+    };
+    for (int i = 1; i < 500; ++i) {
+      axis.push_back(axis.back() + 1 + static_cast<int64_t>(next() % 100000));
+    }
+    DateTimeIndex index(axis.data(), axis.size());
+
+    const int64_t span = axis.back() - axis.front();
+    for (int i = 0; i < 5000; ++i) {
+      // Mostly stepping forward, with occasional jumps anywhere
+      int64_t t = 0;
+      if (i % 7 == 0) {
+        t = axis.front() - 1000 +
+            static_cast<int64_t>(next() % static_cast<uint64_t>(span + 2000));
+      } else {
+        t = axis.front() + span * (i % 700) / 700;
+      }
+
+      const auto result = index.bracket(t);
+      const auto upper = std::upper_bound(axis.begin(), axis.end(), t);
+      if (t < axis.front()) {
+        REQUIRE(result.index == 0);
+        REQUIRE_FALSE(result.in_range);
+      } else if (t >= axis.back()) {
+        REQUIRE(result.index == axis.size() - 2);
+        REQUIRE(result.weight == 1.0);
+      } else {
+        const auto expected = static_cast<size_t>(upper - axis.begin()) - 1;
+        REQUIRE(result.index == expected);
+        REQUIRE(result.in_range);
+        REQUIRE(result.weight >= 0.0);
+        REQUIRE(result.weight < 1.0);
+      }
+    }
+  }
+
+  SECTION("Caller held hint and validation") {
+    const std::vector<int64_t> axis = {0, 10, 20, 30};
+    const DateTimeIndex index(axis);
+    size_t hint = 0;
+    CHECK(index.bracket(25, hint).index == 2);
+    CHECK(hint == 2);
+    CHECK(index.bracket(5, hint).weight == 0.5);
+    CHECK(hint == 0);
+
+    CHECK(DateTimeIndex::is_strictly_increasing(axis.data(), axis.size()));
+    const std::vector<int64_t> repeated = {0, 10, 10, 20};
+    CHECK_FALSE(DateTimeIndex::is_strictly_increasing(repeated.data(),
+                                                      repeated.size()));
+    CHECK_FALSE(DateTimeIndex::is_strictly_increasing(axis.data(), 0));
+
+    DateTimeIndex single(std::vector<int64_t>{42});
+    CHECK(single.bracket(int64_t{42}).in_range);
+    CHECK(single.bracket(int64_t{43}).index == 0);
+  }
+}
+
+TEST_CASE("CFTimeUnits parses CF units attributes", "[datetime][cf]") {
+  SECTION("Units and reference dates") {
+    const CFTimeUnits hours("hours since 1990-01-01 00:00:00");
+    REQUIRE(hours.valid());
+    CHECK(hours.unit_milliseconds() == 3600000);
+    CHECK(hours.epoch() == DateTime(1990, 1, 1));
+
+    const CFTimeUnits days("days since 2000-1-1");
+    REQUIRE(days.valid());
+    CHECK(days.unit_milliseconds() == 86400000);
+    CHECK(days.epoch() == DateTime(2000, 1, 1));
+
+    const CFTimeUnits seconds("Seconds since 1970-01-01T00:00:00Z");
+    REQUIRE(seconds.valid());
+    CHECK(seconds.unit_milliseconds() == 1000);
+    CHECK(seconds.epoch().timestamp() == 0);
+
+    const CFTimeUnits fraction("minutes since 2020-06-15 12:30:15.25 UTC");
+    REQUIRE(fraction.valid());
+    CHECK(fraction.epoch() == DateTime(2020, 6, 15, 12, 30, 15, 250));
+
+    const CFTimeUnits short_time("hrs since 2020-06-15 6:00");
+    REQUIRE(short_time.valid());
+    CHECK(short_time.epoch() == DateTime(2020, 6, 15, 6, 0, 0));
+  }
+
+  SECTION("Time zone offsets") {
+    const CFTimeUnits ahead("hours since 2000-01-01 05:30:00 +05:30");
+    REQUIRE(ahead.valid());
+    CHECK(ahead.epoch() == DateTime(2000, 1, 1));
+
+    const CFTimeUnits behind("hours since 2000-01-01 00:00:00-0600");
+    REQUIRE(behind.valid());
+    CHECK(behind.epoch() == DateTime(2000, 1, 1, 6, 0, 0));
+  }
+
+  SECTION("Rejected attributes") {
+    CHECK_FALSE(CFTimeUnits("months since 2000-01-01").valid());
+    CHECK_FALSE(CFTimeUnits("hours after 2000-01-01").valid());
+    CHECK_FALSE(CFTimeUnits("hours since").valid());
+    CHECK_FALSE(CFTimeUnits("hours since 2000-02-30").valid());
+    CHECK_FALSE(CFTimeUnits("hours since 2000-01-01 25:00:00").valid());
+    CHECK_FALSE(CFTimeUnits("hours since 2000-01-01 junk").valid());
+    CHECK_FALSE(CFTimeUnits("").valid());
+  }
+}
+
+TEST_CASE("CFTimeUnits converts offset arrays", "[datetime][cf]") {
+  const CFTimeUnits hours("hours since 1990-01-01 00:00:00");
+  REQUIRE(hours.valid());
+  const auto epoch = hours.epoch();
+
+  SECTION("Floating point offsets") {
+    const std::vector<double> values = {0.0, 1.5, -24.0, 0.1, NAN, 9.96921e36};
+    std::vector<int64_t> timestamps(values.size());
+    hours.to_timestamps(values.data(), values.size(), timestamps.data());
+    CHECK(timestamps[0] == epoch.timestamp());
+    CHECK(DateTime(timestamps[1]) == epoch + TimeDelta::fromMinutes(90));
+    CHECK(DateTime(timestamps[2]) == epoch - TimeDelta::fromDays(1));
+    CHECK(DateTime(timestamps[3]) == epoch + TimeDelta::fromMinutes(6));
+    CHECK(timestamps[4] == DateTime::INVALID_TIMESTAMP);
+    CHECK(timestamps[5] == DateTime::INVALID_TIMESTAMP);
+
+    std::vector<double> round_trip(values.size());
+    hours.from_timestamps(timestamps.data(), timestamps.size(),
+                          round_trip.data());
+    CHECK(round_trip[1] == 1.5);
+    CHECK(round_trip[2] == -24.0);
+    CHECK(std::isnan(round_trip[4]));
+  }
+
+  SECTION("Integer offsets") {
+    const std::vector<int32_t> values32 = {0, 6, -6};
+    const std::vector<int64_t> values64 = {0, 6, -6};
+    std::vector<int64_t> from32(3);
+    std::vector<int64_t> from64(3);
+    hours.to_timestamps(values32.data(), values32.size(), from32.data());
+    hours.to_timestamps(values64.data(), values64.size(), from64.data());
+    CHECK(from32 == from64);
+    CHECK(DateTime(from32[2]) == epoch - TimeDelta::fromHours(6));
+
+    // NetCDF default fill values and offsets just past the range
+    const CFTimeUnits seconds("seconds since 2000-01-01");
+    const auto limit = (std::numeric_limits<int64_t>::max() -
+                        seconds.epoch().timestamp()) /
+                       1000;
+    const std::vector<int64_t> extremes = {
+        -9223372036854775806LL, std::numeric_limits<int64_t>::max(),
+        std::numeric_limits<int64_t>::min(), limit, limit + 1, -limit,
+        -limit - 1};
+    std::vector<int64_t> converted(extremes.size());
+    seconds.to_timestamps(extremes.data(), extremes.size(), converted.data());
+    CHECK(converted[0] == DateTime::INVALID_TIMESTAMP);
+    CHECK(converted[1] == DateTime::INVALID_TIMESTAMP);
+    CHECK(converted[2] == DateTime::INVALID_TIMESTAMP);
+    CHECK(converted[3] == seconds.epoch().timestamp() + limit * 1000);
+    CHECK(converted[4] == DateTime::INVALID_TIMESTAMP);
+    CHECK(converted[5] == seconds.epoch().timestamp() - limit * 1000);
+    CHECK(converted[6] == DateTime::INVALID_TIMESTAMP);
+
+    const std::vector<int32_t> fill32 = {-2147483647, 2147483647};
+    std::vector<int64_t> converted32(fill32.size());
+    const CFTimeUnits days("days since 2000-01-01");
+    days.to_timestamps(fill32.data(), fill32.size(), converted32.data());
+    CHECK(converted32[0] ==
+          days.epoch().timestamp() - int64_t{2147483647} * 86400000);
+
+    // Whole offsets round down
+    std::vector<int64_t> timestamps = {from64[1] + 1, from64[2] - 1,
+                                       DateTime::INVALID_TIMESTAMP};
+    std::vector<int64_t> offsets(3);
+    hours.from_timestamps(timestamps.data(), timestamps.size(), offsets.data());
+    CHECK(offsets[0] == 6);
+    CHECK(offsets[1] == -7);
+    CHECK(offsets[2] == std::numeric_limits<int64_t>::min());
+  }
+
+  SECTION("Invalid units") {
+    const CFTimeUnits months("months since 2000-01-01");
+    REQUIRE_FALSE(months.valid());
+
+    const std::vector<double> values = {0.0, 1.5};
+    const std::vector<int32_t> values32 = {0, 1};
+    const std::vector<int64_t> values64 = {0, 1};
+    std::vector<int64_t> timestamps(2, 0);
+    months.to_timestamps(values.data(), values.size(), timestamps.data());
+    CHECK(timestamps[0] == DateTime::INVALID_TIMESTAMP);
+    CHECK(timestamps[1] == DateTime::INVALID_TIMESTAMP);
+    std::fill(timestamps.begin(), timestamps.end(), 0);
+    months.to_timestamps(values32.data(), values32.size(), timestamps.data());
+    CHECK(timestamps[0] == DateTime::INVALID_TIMESTAMP);
+    std::fill(timestamps.begin(), timestamps.end(), 0);
+    months.to_timestamps(values64.data(), values64.size(), timestamps.data());
+    CHECK(timestamps[1] == DateTime::INVALID_TIMESTAMP);
+
+    const std::vector<int64_t> dates = {DateTime(2000, 1, 1).timestamp(),
+                                        DateTime(2000, 2, 1).timestamp()};
+    std::vector<double> offsets(2, 0.0);
+    std::vector<int64_t> whole(2, 0);
+    months.from_timestamps(dates.data(), dates.size(), offsets.data());
+    months.from_timestamps(dates.data(), dates.size(), whole.data());
+    CHECK(std::isnan(offsets[0]));
+    CHECK(std::isnan(offsets[1]));
+    CHECK(whole[0] == std::numeric_limits<int64_t>::min());
+    CHECK(whole[1] == std::numeric_limits<int64_t>::min());
+  }
+}
+
+TEST_CASE("FDateError records the last error per thread", "[error]") {
+  FDateError::clear();
+  CHECK(FDateError::code() == e_FDateError::NONE);
+  CHECK(std::string(FDateError::message()).empty());
+
+  FDateError::set(e_FDateError::PARSE, "Could not parse the string");
+  CHECK(FDateError::code() == e_FDateError::PARSE);
+  CHECK(std::string(FDateError::message()) == "Could not parse the string");
+
+  SECTION("Other threads keep their own record") {
+    e_FDateError other_code = e_FDateError::INTERNAL;
+    std::thread worker([&other_code]() {
+      other_code = FDateError::code();
+      FDateError::set(e_FDateError::IO, "Could not open file");
+    });
+    worker.join();
+    CHECK(other_code == e_FDateError::NONE);
+    CHECK(FDateError::code() == e_FDateError::PARSE);
+  }
+
+  SECTION("Long messages are truncated") {
+    const std::string long_message(2 * FDateError::MESSAGE_SIZE, 'x');
+    FDateError::set(e_FDateError::INVALID_INPUT, long_message.c_str());
+    CHECK(std::string(FDateError::message()).size() ==
+          FDateError::MESSAGE_SIZE - 1);
+  }
+
+  FDateError::clear();
+  CHECK(FDateError::code() == e_FDateError::NONE);
+}
+
+TEST_CASE("ParallelBlocks covers every element once", "[parallel]") {
+  for (const size_t count :
+       {size_t{0}, size_t{1}, size_t{1000}, size_t{10000}}) {
+    std::vector<int> visits(count, 0);
+    const bool success = ParallelBlocks::for_each_block(
+        count, 64, [&visits](const size_t begin, const size_t end) noexcept {
+          for (size_t i = begin; i < end; ++i) {
+            ++visits[i];
+          }
+          return true;
+        });
+    CHECK(success);
+    CHECK(std::all_of(visits.begin(), visits.end(),
+                      [](const int v) { return v == 1; }));
+  }
+
+  const bool failure = ParallelBlocks::for_each_block(
+      1000, 100, [](const size_t begin, const size_t) noexcept {
+        return begin != 500;
+      });
+  CHECK_FALSE(failure);
+  CHECK(ParallelBlocks::max_threads() >= 1);
+}
+
+TEST_CASE("FDateStats counts parses and formats", "[stats]") {
+  const auto at = [](const FDateStats::t_values& values,
+                     const e_FDateStat stat) {
+    return values[static_cast<size_t>(stat)];
+  };
+
+  CHECK(std::string(DateTime::auto_format(0)) == "%Y-%m-%d %H:%M:%S");
+  CHECK(DateTime::auto_format(FDateStats::AUTO_FORMATS) == nullptr);
+
+  FDateStats::reset();
+  const auto parsed = DateTime::strptime("2024-03-15 14:30:25");
+  const auto explicit_parsed = DateTime::strptime("2024-03-15", "%Y-%m-%d");
+  const auto failed = DateTime::strptime("not a date");
+  const auto iso = parsed.to_iso_string();
+  std::thread worker([]() {
+    static_cast<void>(DateTime::strptime("2024/03/15 14:30:25"));
+  });
+  worker.join();
+  REQUIRE(explicit_parsed.valid());
+  REQUIRE_FALSE(failed.valid());
+
+  const auto stats = FDateStats::get();
+  if (!FDateStats::enabled()) {
+    CHECK(std::all_of(stats.begin(), stats.end(),
+                      [](const int64_t v) { return v == 0; }));
+    return;
+  }
+
+  CHECK(at(stats, e_FDateStat::PARSE_CALLS) == 4);
+  CHECK(at(stats, e_FDateStat::PARSE_FAILURES) == 1);
+  CHECK(at(stats, e_FDateStat::FORMAT_CALLS) == 1);
+  CHECK(at(stats, e_FDateStat::FORMAT_BYTES) ==
+        static_cast<int64_t>(iso.size()));
+  CHECK(at(stats, e_FDateStat::PARSE_NANOSECONDS) > 0);
+
+  // The failed string is tried against every automatic format
+  const auto attempts = [&stats](const size_t slot) {
+    return stats[FDateStats::PARSE_ATTEMPTS_OFFSET + slot];
+  };
+  const auto successes = [&stats](const size_t slot) {
+    return stats[FDateStats::PARSE_SUCCESSES_OFFSET + slot];
+  };
+  CHECK(attempts(0) == 2);
+  CHECK(successes(0) == 1);
+  CHECK(attempts(3) == 2);
+  CHECK(successes(3) == 1);
+  CHECK(attempts(10) == 1);
+  CHECK(successes(10) == 0);
+  CHECK(attempts(FDateStats::EXPLICIT_FORMAT) == 1);
+  CHECK(successes(FDateStats::EXPLICIT_FORMAT) == 1);
+
+  FDateStats::reset();
+  const auto cleared = FDateStats::get();
+  CHECK(std::all_of(cleared.begin(), cleared.end(),
+                    [](const int64_t v) { return v == 0; }));
+}
+
+TEST_CASE("BasicDateTime compact and precise variants", "[datetime]") {
+  STATIC_REQUIRE(sizeof(CompactDateTime) == 4);
+  STATIC_REQUIRE(sizeof(CompactTimeDelta) == 4);
+  STATIC_REQUIRE(sizeof(DateTime) == 8);
+
+  SECTION("Compact seconds since 2000") {
+    const CompactDateTime epoch;
+    CHECK(epoch.to_iso_string() == "2000-01-01T00:00:00");
+    CHECK(epoch.timestamp() == 946684800000);
+
+    const auto dt = CompactDateTime::strptime("2024-03-15 14:30:25.750");
+    REQUIRE(dt.valid());
+    CHECK(dt.year() == 2024);
+    CHECK(dt.month() == 3);
+    CHECK(dt.day() == 15);
+    CHECK(dt.second() == 25);
+    CHECK(dt.millisecond() == 0);
+    CHECK(dt.count() == 763828225);
+    CHECK(CompactDateTime::from_count(dt.count()) == dt);
+    CHECK(dt.strftime("%Y-%m-%d %H:%M:%S") == "2024-03-15 14:30:25");
+
+    const auto later = dt + CompactTimeDelta(1, 2, 0, 5, 0);
+    CHECK(later.to_iso_string() == "2024-03-16T16:30:30");
+    CHECK((later - dt).totalSeconds() == 93605);
+
+    CHECK_FALSE(CompactDateTime(1900, 1, 1).valid());
+    CHECK_FALSE(CompactDateTime(2100, 1, 1).valid());
+    CHECK(CompactDateTime(1932, 1, 1).valid());
+    CHECK(CompactDateTime(2068, 1, 1).valid());
+    CHECK_FALSE(CompactDateTime::strptime("not a date").valid());
+    CHECK(CompactDateTime::strptime("not a date").timestamp() ==
+          DateTime::INVALID_TIMESTAMP);
+  }
+
+  SECTION("Precise microseconds") {
+    const auto dt =
+        PreciseDateTime(2024, 3, 15, 14, 30, 25, 123) +
+        PreciseTimeDelta::fromDuration(std::chrono::microseconds(456));
+    CHECK(dt.millisecond() == 123);
+    CHECK(dt.microsecond() == 123456);
+    CHECK(dt.timestamp() == DateTime(2024, 3, 15, 14, 30, 25, 123).timestamp());
+    CHECK(dt.to_iso_string_msec() == "2024-03-15T14:30:25.123");
+
+    const auto before = PreciseDateTime(1969, 12, 31, 23, 59, 59, 999);
+    CHECK(before.microsecond() == 999000);
+    CHECK((dt - before).totalMicroseconds() -
+              (dt - before).totalMilliseconds() * 1000 ==
+          456);
+  }
+
+  SECTION("Conversions between variants") {
+    const DateTime dt(2024, 3, 15, 14, 30, 25, 750);
+    const CompactDateTime compact(dt);
+    CHECK(compact.to_iso_string() == "2024-03-15T14:30:25");
+    CHECK(DateTime(compact).timestamp() ==
+          DateTime(2024, 3, 15, 14, 30, 25).timestamp());
+    CHECK(DateTime(PreciseDateTime(dt)) == dt);
+
+    CHECK_FALSE(CompactDateTime(DateTime(2200, 1, 1)).valid());
+    CHECK_FALSE(CompactDateTime(DateTime::strptime("bad")).valid());
+    CHECK_FALSE(DateTime(CompactDateTime::strptime("bad")).valid());
+
+    const TimeDelta span(0, 1, 30, 0, 500);
+    CHECK(CompactTimeDelta(span).totalMilliseconds() == 5400000);
+    CHECK(PreciseTimeDelta(span).totalMicroseconds() == 5400500000);
+  }
+}
+
+TEST_CASE("TimeAxis stores uniform and irregular axes", "[timeaxis]") {
+  SECTION("Uniform") {
+    const auto axis = TimeAxis::uniform(DateTime(2024, 1, 1),
+                                        TimeDelta::fromHours(1), 1000);
+    CHECK(axis.is_uniform());
+    CHECK(axis.size() == 1000);
+    CHECK(axis.step() == TimeDelta::fromHours(1));
+    CHECK(axis.at(999) == DateTime(2024, 2, 11, 15));
+    CHECK(axis.serialized_size() == TimeAxis::HEADER_SIZE);
+
+    const std::vector<int64_t> uniform{1000, 1500, 2000, 2500};
+    CHECK(TimeAxis(uniform).is_uniform());
+    CHECK(TimeAxis(uniform).decode() == uniform);
+    CHECK(TimeAxis(uniform.data(), 1).is_uniform());
+    CHECK(TimeAxis().empty());
+  }
+
+  SECTION("Irregular") {
+    // Hourly records with small jitter, a gap and a few out of order times
+    std::vector<int64_t> times;
+    int64_t t = DateTime(2024, 1, 1).timestamp();
+    for (int i = 0; i < 1000; ++i) {
+      t += 3600000 + (i % 7) * 13 - 40;
+      if (i == 500) {
+        t += 86400000;
+      }
+      times.push_back(i % 250 == 3 ? t - 7200000 : t);
+    }
+    times.push_back(std::numeric_limits<int64_t>::max());
+    times.push_back(std::numeric_limits<int64_t>::min());
+
+    const TimeAxis axis(times);
+    REQUIRE_FALSE(axis.is_uniform());
+    REQUIRE(axis.size() == times.size());
+    CHECK(axis.decode() == times);
+    for (size_t i = 0; i < times.size(); ++i) {
+      REQUIRE(axis[i] == times[i]);
+    }
+    CHECK(axis.serialized_size() < times.size() * 2);
+
+    const auto buffer = axis.serialize();
+    TimeAxis copy;
+    CHECK(TimeAxis::deserialize(buffer.data(), buffer.size(), copy) ==
+          buffer.size());
+    CHECK_FALSE(copy.is_uniform());
+    CHECK(copy.decode() == times);
+    CHECK(copy[777] == times[777]);
+  }
+
+  SECTION("Serialization is checked") {
+    const TimeAxis axis(std::vector<int64_t>{0, 10, 30, 60, 100});
+    auto buffer = axis.serialize();
+    CHECK(buffer.size() == TimeAxis::HEADER_SIZE + 4);
+    CHECK(buffer[0] == 'F');
+    CHECK(buffer[5] == 1);
+
+    // Trailing bytes are left for the caller
+    auto padded = buffer;
+    padded.push_back(0xFF);
+    TimeAxis copy;
+    CHECK(TimeAxis::deserialize(padded.data(), padded.size(), copy) ==
+          buffer.size());
+    CHECK(copy.decode() == axis.decode());
+
+    TimeAxis untouched;
+    for (size_t size = 0; size < buffer.size(); ++size) {
+      CHECK(TimeAxis::deserialize(buffer.data(), size, untouched) == 0);
+    }
+    auto corrupt = buffer;
+    corrupt[4] = 2;
+    CHECK(TimeAxis::deserialize(corrupt.data(), corrupt.size(), untouched) ==
+          0);
+    corrupt = buffer;
+    corrupt.back() |= 0x80U;
+    CHECK(TimeAxis::deserialize(corrupt.data(), corrupt.size(), untouched) ==
+          0);
+    CHECK(untouched.empty());
+
+    const auto uniform = TimeAxis::uniform(DateTime(1990, 1, 1),
+                                           TimeDelta::fromMinutes(-30), 5);
+    const auto uniform_buffer = uniform.serialize();
+    CHECK(TimeAxis::deserialize(uniform_buffer.data(), uniform_buffer.size(),
+                                copy) == TimeAxis::HEADER_SIZE);
+    CHECK(copy.is_uniform());
+    CHECK(copy.at(4) == DateTime(1989, 12, 31, 22));
+  }
+}
+
+namespace {
+struct FixedStamp {
+  static constexpr char PATTERN[] = "%Y%m%d_%H%M";
+};
+
+struct FixedLong {
+  static constexpr char PATTERN[] = "%F %T (%%)";
+};
+
+constexpr auto fixed_stamp_at_compile_time() -> std::array<char, 13> {
+  FixedDateTimeFormat<FixedStamp>::t_buffer out{};
+  FixedDateTimeFormat<FixedStamp>::format({2024, 3, 15, 14, 30, 25, 750}, out);
+  return out;
+}
+}  // namespace
+
+TEST_CASE("FixedDateTimeFormat writes formats fixed at compile time",
+          "[datetime][format]") {
+  STATIC_REQUIRE(FixedDateTimeFormat<FixedIso>::LENGTH == 19);
+  STATIC_REQUIRE(FixedDateTimeFormat<FixedIso, true>::LENGTH == 23);
+  STATIC_REQUIRE(FixedDateTimeFormat<FixedStamp>::LENGTH == 13);
+  STATIC_REQUIRE(FixedDateTimeFormat<FixedLong, true>::LENGTH == 27);
+  STATIC_REQUIRE(fixed_stamp_at_compile_time()[8] == '_');
+  STATIC_REQUIRE(fixed_stamp_at_compile_time()[12] == '0');
+
+  const DateTime dt(2024, 3, 15, 14, 30, 25, 750);
+  FixedDateTimeFormat<FixedIso>::t_buffer iso{};
+  REQUIRE(dt.format<FixedIso>(iso));
+  CHECK(std::string(iso.data(), iso.size()) == "2024-03-15T14:30:25");
+
+  FixedDateTimeFormat<FixedLong, true>::t_buffer long_form{};
+  REQUIRE((dt.format<FixedLong, true>(long_form)));
+  CHECK(std::string(long_form.data(), long_form.size()) ==
+        "2024-03-15 14:30:25.750 (%)");
+
+  FixedDateTimeFormat<FixedStamp>::t_buffer stamp{};
+  REQUIRE(DateTime(1, 2, 3, 4, 5).format<FixedStamp>(stamp));
+  CHECK(std::string(stamp.data(), stamp.size()) == "00010203_0405");
+
+  // Years that do not fit the fixed width are left to the stream formatter
+  auto untouched = stamp;
+  CHECK_FALSE(DateTime(12000, 1, 1).format<FixedStamp>(untouched));
+  CHECK(untouched == stamp);
+  CHECK(DateTime(12000, 1, 1).to_iso_string() == "12000-01-01T00:00:00");
+  CHECK(DateTime(-50, 1, 1).to_iso_string() ==
+        DateTime(-50, 1, 1).strftime("%Y-%m-%dT%H:%M:%S"));
+
+  for (int64_t t = -2208988800000; t < 4102444800000; t += 987654321987) {
+    const DateTime date(t);
+    CHECK(date.to_iso_string() == date.strftime("%Y-%m-%dT%H:%M:%S"));
+    CHECK(date.to_iso_string_msec() ==
+          date.strftime_w_milliseconds("%Y-%m-%dT%H:%M:%S"));
+  }
+}
+
+TEST_CASE("ModelClock advances cached calendar fields", "[modelclock]") {
+  const auto check_fields = [](const ModelClock& clock) {
+    const auto dt = clock.time();
+    REQUIRE(clock.year() == dt.year());
+    REQUIRE(clock.month() == dt.month());
+    REQUIRE(clock.day() == dt.day());
+    REQUIRE(clock.hour() == dt.hour());
+    REQUIRE(clock.minute() == dt.minute());
+    REQUIRE(clock.second() == dt.second());
+    REQUIRE(clock.millisecond() == dt.millisecond());
+    const DateTime new_year(static_cast<int>(dt.year()), 1, 1);
+    REQUIRE(static_cast<int64_t>(clock.day_of_year()) ==
+            (dt - new_year).totalDays() + 1);
+  };
+
+  SECTION("Fields match the DateTime getters across boundaries") {
+    for (const int64_t step_ms :
+         {int64_t{1}, int64_t{1234567}, int64_t{3600000}, int64_t{86399999},
+          int64_t{86400000}, int64_t{-5400000}, int64_t{40} * 86400000}) {
+      ModelClock clock(DateTime(1999, 12, 30, 22, 0, 0));
+      check_fields(clock);
+      const auto step = TimeDelta::fromMilliseconds(step_ms);
+      const auto n_steps = std::abs(step_ms) == 1 ? 1000 : 500;
+      for (int i = 0; i < n_steps; ++i) {
+        const auto before = clock.time();
+        clock.advance(step);
+        const auto after = clock.time();
+        REQUIRE(after == before + step);
+        check_fields(clock);
+        const auto day_of = [](const DateTime& dt) {
+          const auto ms = dt.timestamp();
+          return (ms >= 0 ? ms : ms - 86399999) / 86400000;
+        };
+        CHECK(clock.crossed_day() == (day_of(before) != day_of(after)));
+        CHECK(clock.crossed_month() == (before.month() != after.month() ||
+                                        before.year() != after.year()));
+        CHECK(clock.crossed_year() == (before.year() != after.year()));
+      }
+    }
+  }
+
+  SECTION("Boundary flags for one step") {
+    ModelClock clock(DateTime(2024, 2, 29, 23, 30, 0));
+    CHECK(clock.day_of_year() == 60);
+    clock += TimeDelta::fromMinutes(20);
+    CHECK_FALSE(clock.crossed_hour());
+    clock += TimeDelta::fromMinutes(20);
+    CHECK(clock.crossed_hour());
+    CHECK(clock.crossed_day());
+    CHECK(clock.crossed_month());
+    CHECK_FALSE(clock.crossed_year());
+    CHECK(clock.month() == 3);
+    CHECK(clock.day() == 1);
+    CHECK(clock.day_of_year() == 61);
+
+    clock.reset(DateTime(2023, 12, 31, 23, 59, 59));
+    CHECK_FALSE(clock.crossed_hour());
+    clock.advance(TimeDelta::fromSeconds(1));
+    CHECK(clock.crossed_year());
+    CHECK(clock.year() == 2024);
+    CHECK(clock.day_of_year() == 1);
+
+    clock.advance(TimeDelta());
+    CHECK_FALSE(clock.crossed_hour());
+  }
+
+  SECTION("Days in month") {
+    CHECK(CalendarMath::days_in_month(2024, 2) == 29);
+    CHECK(CalendarMath::days_in_month(1900, 2) == 28);
+    CHECK(CalendarMath::days_in_month(2000, 2) == 29);
+    CHECK(CalendarMath::days_in_month(2023, 4) == 30);
+    CHECK(CalendarMath::days_in_month(2023, 12) == 31);
+  }
+}
+
+TEST_CASE("AlarmSet fires interval and monthly alarms in order", "[alarmset]") {
+  SECTION("Firing matches a modulo check every step") {
+    const DateTime start(2024, 1, 1);
+    AlarmSet alarms;
+    const auto hourly =
+        alarms.add_interval(start, TimeDelta::fromSeconds(3600));
+    const auto stations =
+        alarms.add_interval(start + TimeDelta::fromSeconds(360),
+                            TimeDelta::fromSeconds(360));
+    const auto monthly = alarms.add_monthly(start);
+    CHECK(alarms.size() == 3);
+    CHECK(alarms.next_time() == start);
+
+    const auto step = TimeDelta::fromSeconds(120);
+    std::vector<int> fired;
+    auto now = start;
+    int hourly_count = 0;
+    int station_count = 0;
+    int monthly_count = 0;
+    for (int i = 0; i < 91 * 24 * 30; ++i) {
+      const auto since_start = (now - start).totalSeconds();
+      const bool expect_hourly = since_start % 3600 == 0;
+      const bool expect_station = since_start >= 360 && since_start % 360 == 0;
+      const bool expect_monthly =
+          now.day() == 1 && now.hour() == 0 && now.minute() == 0;
+
+      fired.clear();
+      CHECK(alarms.due(now) == (expect_hourly || expect_station ||
+                                expect_monthly));
+      alarms.poll(now, fired);
+      const auto has = [&fired](const int id) {
+        return std::find(fired.begin(), fired.end(), id) != fired.end();
+      };
+      REQUIRE(has(hourly) == expect_hourly);
+      REQUIRE(has(stations) == expect_station);
+      REQUIRE(has(monthly) == expect_monthly);
+      REQUIRE(std::is_sorted(fired.begin(), fired.end()));
+      CHECK_FALSE(alarms.due(now));
+
+      hourly_count += expect_hourly ? 1 : 0;
+      station_count += expect_station ? 1 : 0;
+      monthly_count += expect_monthly ? 1 : 0;
+      now = now + step;
+    }
+    CHECK(hourly_count == 91 * 24);
+    CHECK(monthly_count == 3);
+    CHECK(station_count == 91 * 24 * 10 - 1);
+  }
+
+  SECTION("Monthly alarms keep their day of the month") {
+    AlarmSet alarms;
+    const auto id = alarms.add_monthly(DateTime(2024, 1, 31, 6, 0, 0));
+    std::vector<DateTime> fires;
+    auto now = DateTime(2024, 1, 1);
+    while (fires.size() < 4) {
+      if (alarms.pop(now) == id) {
+        fires.push_back(now);
+      }
+      now = now + TimeDelta::fromHours(1);
+    }
+    CHECK(fires[0] == DateTime(2024, 1, 31, 6, 0, 0));
+    CHECK(fires[1] == DateTime(2024, 2, 29, 6, 0, 0));
+    CHECK(fires[2] == DateTime(2024, 3, 31, 6, 0, 0));
+    CHECK(fires[3] == DateTime(2024, 4, 30, 6, 0, 0));
+
+    const auto quarterly = alarms.add_monthly(DateTime(2023, 11, 1), 3);
+    CHECK(alarms.pop(DateTime(2024, 4, 30)) == quarterly);
+    CHECK(alarms.next_time(quarterly) == DateTime(2024, 5, 1));
+  }
+
+  SECTION("Alarms passed by a long step fire once") {
+    AlarmSet alarms;
+    const auto id = alarms.add_interval(DateTime(2024, 1, 1),
+                                        TimeDelta::fromMinutes(10));
+    CHECK(alarms.pop(DateTime(2024, 1, 1, 1, 5, 0)) == id);
+    CHECK(alarms.pop(DateTime(2024, 1, 1, 1, 5, 0)) ==
+          AlarmSet::INVALID_ALARM);
+    CHECK(alarms.next_time(id) == DateTime(2024, 1, 1, 1, 10, 0));
+  }
+
+  SECTION("Invalid alarms") {
+    AlarmSet alarms;
+    CHECK(alarms.empty());
+    CHECK_FALSE(alarms.next_time().valid());
+    CHECK_FALSE(alarms.due(DateTime(2024, 1, 1)));
+    CHECK(alarms.add_interval(DateTime(), TimeDelta()) ==
+          AlarmSet::INVALID_ALARM);
+    CHECK(alarms.add_monthly(DateTime(), 0) == AlarmSet::INVALID_ALARM);
+    CHECK_FALSE(alarms.next_time(0).valid());
+  }
+}
+
+TEST_CASE("CalendarTable matches the general calendar conversion",
+          "[calendartable]") {
+  SECTION("Every day of the window") {
+    for (auto days = CalendarTable::FIRST_DAY; days < CalendarTable::END_DAY;
+         ++days) {
+      const date::year_month_day ymd{date::sys_days(date::days(days))};
+      int year = 0;
+      unsigned month = 0;
+      unsigned day = 0;
+      CalendarTable::to_civil(days, year, month, day);
+      REQUIRE(year == static_cast<int>(ymd.year()));
+      REQUIRE(month == static_cast<unsigned>(ymd.month()));
+      REQUIRE(day == static_cast<unsigned>(ymd.day()));
+      REQUIRE(CalendarTable::year(days) == year);
+      REQUIRE(CalendarTable::month(days) == month);
+      REQUIRE(CalendarTable::day(days) == day);
+    }
+  }
+
+  SECTION("Window limits") {
+    using Table = BasicCalendarTable<2000, 2001>;
+    static_assert(Table::FIRST_DAY == 10957);
+    static_assert(Table::DAY_COUNT == 731);
+    static_assert(Table::MONTH_START[2] == 10957 + 31 + 29);
+    CHECK(Table::contains(10957));
+    CHECK_FALSE(Table::contains(10956));
+    CHECK_FALSE(Table::contains(10957 + 731));
+    CHECK(Table::day(10957 + 730) == 31);
+    CHECK(Table::month(10957 + 730) == 12);
+    CHECK(Table::year(10957 + 730) == 2001);
+  }
+
+  SECTION("DateTime getters inside and outside the window") {
+    for (const auto& dt :
+         {DateTime(1899, 12, 31, 23, 59, 59), DateTime(1900, 1, 1),
+          DateTime(2024, 2, 29, 12, 0, 0), DateTime(2200, 12, 31, 23, 0, 0),
+          DateTime(2201, 1, 1), DateTime(1066, 10, 14)}) {
+      const auto days = date::floor<date::days>(dt.get_time_point())
+                            .time_since_epoch()
+                            .count();
+      CHECK(dt.julianDayNumber() == CalendarTable::julian_day_number(days));
+      const date::year_month_day ymd{
+          date::floor<date::days>(dt.get_time_point())};
+      CHECK(dt.year() == static_cast<int>(ymd.year()));
+      CHECK(dt.month() == static_cast<unsigned>(ymd.month()));
+      CHECK(dt.day() == static_cast<unsigned>(ymd.day()));
+    }
+  }
+}
+
+TEST_CASE("DateTime parsing from string views", "[datetime][string_view]") {
+  // A blank padded record, as passed from a Fortran character variable
+  const char record[] = "2024-03-15 14:30:25    2024/03/16 08:00    ";
+  const std::string_view first(record, 19);
+  const std::string_view second(record + 23, 16);
+  const auto expected = DateTime(2024, 3, 15, 14, 30, 25).timestamp();
+
+  SECTION("Explicit formats read only the viewed characters") {
+    CHECK(DateTime::strptime(first, "%Y-%m-%d %H:%M:%S").timestamp() ==
+          expected);
+    const std::string_view format("%Y/%m/%d %H:%Mxx", 14);
+    CHECK(DateTime::strptime(second, format).timestamp() ==
+          DateTime(2024, 3, 16, 8, 0, 0).timestamp());
+  }
+
+  SECTION("Automatic detection and compiled formats") {
+    CHECK(DateTime::strptime(first).timestamp() == expected);
+    CHECK(DateTime::strptime(second).timestamp() ==
+          DateTime(2024, 3, 16, 8, 0, 0).timestamp());
+    const DateTimeFormat format("%Y-%m-%d %H:%M:%S");
+    CHECK(DateTime::strptime(first, format).timestamp() == expected);
+  }
+
+  SECTION("Stream fallback uses the viewed characters") {
+    const std::string_view format("%d.%m.%Y %H:%M", 14);
+    CHECK(DateTime::strptime(std::string_view("15.03.2024 14:30!", 16), format)
+              .timestamp() == DateTime(2024, 3, 15, 14, 30, 0).timestamp());
+    // Trailing blanks inside the view are ignored by the stream parser
+    CHECK(DateTime::strptime(std::string_view(record, 22), "%Y-%m-%d %H:%M:%S")
+              .timestamp() == expected);
+  }
+}
+
+TEST_CASE("DateTimeFormatSet adapts the order formats are tried in",
+          "[formatset]") {
+  SECTION("Reports the format that matched") {
+    DateTimeFormatSet formats;
+    CHECK(formats.add("%d.%m.%Y %H:%M") == 0);
+    CHECK(formats.add("%Y/%m/%d %H:%M") == 1);
+    CHECK(formats.add("%Y-%m-%d") == 2);
+    CHECK(formats.size() == 3);
+    CHECK(formats.last_match() == DateTimeFormatSet::NO_MATCH);
+
+    int matched = DateTimeFormatSet::NO_MATCH;
+    auto dt = formats.parse("2024/03/15 14:30", matched);
+    CHECK(matched == 1);
+    CHECK(dt.timestamp() == DateTime(2024, 3, 15, 14, 30, 0).timestamp());
+
+    dt = formats.parse("2024-03-16", matched);
+    CHECK(matched == 2);
+    CHECK(dt.timestamp() == DateTime(2024, 3, 16).timestamp());
+
+    dt = formats.parse("16.03.2024 08:00", matched);
+    CHECK(matched == 0);
+    CHECK(formats.last_match() == 0);
+
+    CHECK_FALSE(formats.parse("not a date", matched).valid());
+    CHECK(matched == DateTimeFormatSet::NO_MATCH);
+    CHECK(formats.last_match() == DateTimeFormatSet::NO_MATCH);
+
+    CHECK(formats.hits(0) == 1);
+    CHECK(formats.hits(1) == 1);
+    CHECK(formats.hits(2) == 1);
+    CHECK(formats.hits(3) == 0);
+  }
+
+  SECTION("Move to front parses repeated formats on the first try") {
+    DateTimeFormatSet formats(DateTimeFormatSet::e_FormatOrder::MOVE_TO_FRONT);
+    formats.add("%Y-%m-%d %H:%M:%S");
+    formats.add("%d.%m.%Y");
+
+    FDateStats::reset();
+    for (int day = 1; day <= 10; ++day) {
+      const auto str =
+          (day < 10 ? "0" : "") + std::to_string(day) + ".03.2024";
+      CHECK(formats.parse(str).valid());
+    }
+    if (FDateStats::enabled()) {
+      // One failed attempt with the first format, then one try per string
+      const auto stats = FDateStats::get();
+      CHECK(stats[FDateStats::PARSE_ATTEMPTS_OFFSET +
+                  FDateStats::EXPLICIT_FORMAT] == 11);
+      CHECK(stats[FDateStats::PARSE_SUCCESSES_OFFSET +
+                  FDateStats::EXPLICIT_FORMAT] == 10);
+    }
+    CHECK(formats.hits(0) == 0);
+    CHECK(formats.hits(1) == 10);
+  }
+
+  SECTION("Hit count keeps the most frequent format first") {
+    DateTimeFormatSet formats(DateTimeFormatSet::e_FormatOrder::HIT_COUNT);
+    formats.add("%Y-%m-%d");
+    formats.add("%d.%m.%Y");
+
+    int matched = DateTimeFormatSet::NO_MATCH;
+    for (int i = 0; i < 3; ++i) {
+      formats.parse("2024-03-15", matched);
+      CHECK(matched == 0);
+    }
+    // A single string in another format does not displace the first
+    formats.parse("15.03.2024", matched);
+    CHECK(matched == 1);
+    CHECK(formats.parse("2024-03-16", matched).valid());
+    CHECK(matched == 0);
+    CHECK(formats.hits(0) == 4);
+  }
+
+  SECTION("Fixed order and compiled auto detection") {
+    DateTimeFormatSet formats(DateTimeFormatSet::e_FormatOrder::FIXED);
+    formats.add("auto");
+    formats.add("%d.%m.%Y");
+    CHECK(formats.order() == DateTimeFormatSet::e_FormatOrder::FIXED);
+    CHECK(formats.format(0).is_auto());
+
+    int matched = DateTimeFormatSet::NO_MATCH;
+    CHECK(formats.parse("2024-03-15T14:30:25", matched).valid());
+    CHECK(matched == 0);
+    CHECK(formats.parse("15.03.2024", matched).valid());
+    CHECK(matched == 1);
+    CHECK(formats.parse("2024/03/15", matched).valid());
+    CHECK(matched == 0);
+  }
+}
+
+TEST_CASE("Delimited text timestamp columns", "[DelimitedTimeReader]") {
+  const auto path =
+      (std::filesystem::temp_directory_path() / "fdate_delimited_test.csv")
+          .string();
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "station,time,stage\n"
+         << "# gauge 42\n"
+         << "A,2024-03-15 14:30:25,1.5\r\n"
+         << "\n"
+         << "B, \"2024-03-15 15:30:25\" ,1.6\n"
+         << "C,not a date,1.7\n"
+         << "D\n";
+    for (int hour = 0; hour < 24; ++hour) {
+      file << "E,2024-03-16 " << (hour < 10 ? "0" : "") << hour
+           << ":00:00,2.0\n";
+    }
+    file << "F,2024-03-17 00:00:00,2.1";
+  }
+
+  const DateTimeFormat format("%Y-%m-%d %H:%M:%S");
+  DelimitedTimeReader::s_Options options;
+  options.column = 1;
+  options.header_lines = 1;
+
+  const auto check_times = [](const std::vector<int64_t>& times) {
+    REQUIRE(times.size() == 29);
+    CHECK(times[0] == DateTime(2024, 3, 15, 14, 30, 25).timestamp());
+    CHECK(times[1] == DateTime(2024, 3, 15, 15, 30, 25).timestamp());
+    CHECK(times[2] == DateTime::INVALID_TIMESTAMP);
+    CHECK(times[3] == DateTime::INVALID_TIMESTAMP);
+    for (unsigned hour = 0; hour < 24; ++hour) {
+      CHECK(times[4 + hour] == DateTime(2024, 3, 16, hour, 0, 0).timestamp());
+    }
+    CHECK(times[28] == DateTime(2024, 3, 17).timestamp());
+  };
+
+  SECTION("Memory mapped in small parallel blocks") {
+    DelimitedTimeReader reader(path);
+    REQUIRE(reader.valid());
+    std::vector<int64_t> times;
+    CHECK(reader.read(format, options, times, 16));
+    check_times(times);
+  }
+
+  SECTION("Read in chunks shorter than a line") {
+    DelimitedTimeReader reader(path, false, 8);
+    REQUIRE(reader.valid());
+    CHECK_FALSE(reader.mapped());
+    std::vector<int64_t> times;
+    CHECK(reader.read(format, options, times, 16));
+    check_times(times);
+
+    // The file can be read again with another layout
+    options.column = 2;
+    CHECK(reader.read(DateTimeFormat("auto"), options, times));
+    CHECK(times.size() == 29);
+  }
+
+  SECTION("Whitespace delimited date and time fields") {
+    const std::string_view line = "  42\t2024-03-15   14:30:25  1.5";
+    DelimitedTimeReader::s_Options blanks;
+    blanks.delimiter = DelimitedTimeReader::WHITESPACE;
+    blanks.column = 1;
+    blanks.span = 2;
+    const auto field = DelimitedTimeReader::find_field(line, blanks);
+    CHECK(field == "2024-03-15   14:30:25");
+    CHECK(DateTime::strptime(field, "%Y-%m-%d %H:%M:%S") ==
+          DateTime(2024, 3, 15, 14, 30, 25));
+    blanks.column = 3;
+    CHECK(DelimitedTimeReader::find_field(line, blanks).empty());
+  }
+
+  SECTION("Missing files report an error") {
+    DelimitedTimeReader reader(path + ".missing");
+    CHECK_FALSE(reader.valid());
+    CHECK_FALSE(reader.error().empty());
+    std::vector<int64_t> times{1};
+    CHECK_FALSE(reader.read(format, options, times));
+    CHECK(times.empty());
+  }
+
+  std::remove(path.c_str());
+}
@@ -0,0 +1,113 @@
+#define CATCH_CONFIG_MAIN
+#include "DateTimeCore.hpp"
+
+// The core header must stay usable without the stream and date library
+// headers, so it is included first and none of them may be pulled in here
+#ifdef DATE_H
+#error "DateTimeCore.hpp must not include date_hh.h"
+#endif
+#ifdef _GLIBCXX_SSTREAM
+#error "DateTimeCore.hpp must not include <sstream>"
+#endif
+
+#include <catch2/catch_approx.hpp>
+#include <catch2/catch_test_macros.hpp>
+
+// ====================================================
+// Compile-time tests using static_assert
+// ====================================================
+
+static_assert(DateTime(2024, 2, 29).day() == 29,
+              "Leap day construction failed");
+static_assert(DateTime(1969, 12, 31, 23, 59, 59, 999).timestamp() == -1,
+              "Pre-epoch timestamp failed");
+static_assert((DateTime(2024, 2, 28) + TimeDelta::fromDays(1)).month() == 2,
+              "Day arithmetic across a leap day failed");
+static_assert(DateTime(2000, 1, 1, 12).julianDayNumber() == 2451545,
+              "Julian Day Number failed");
+static_assert(CompactDateTime(2000, 1, 1).count() == 0,
+              "CompactDateTime epoch failed");
+static_assert(CalendarMath::julian_day(CalendarMath::s_Fields{
+                  2000, 1, 1, 12, 0, 0, 0}) == 2451545.0,
+              "CalendarMath Julian Day failed");
+
+TEST_CASE("DateTimeCore getters match the calendar", "[datetime_core]") {
+  const DateTime dt(2023, 12, 1, 14, 30, 25, 123);
+  CHECK(dt.year() == 2023);
+  CHECK(dt.month() == 12);
+  CHECK(dt.day() == 1);
+  CHECK(dt.hour() == 14);
+  CHECK(dt.minute() == 30);
+  CHECK(dt.second() == 25);
+  CHECK(dt.millisecond() == 123);
+  CHECK(dt.timestamp() == 1701441025123);
+
+  const auto fields = dt.to_fields();
+  CHECK(fields.year == 2023);
+  CHECK(fields.month == 12);
+  CHECK(fields.day == 1);
+  CHECK(fields.hour == 14);
+  CHECK(fields.minute == 30);
+  CHECK(fields.second == 25);
+  CHECK(fields.millisecond == 123);
+
+  const DateTime before_epoch(1969, 7, 20, 20, 17, 40);
+  CHECK(before_epoch.year() == 1969);
+  CHECK(before_epoch.month() == 7);
+  CHECK(before_epoch.day() == 20);
+  CHECK(before_epoch.hour() == 20);
+  CHECK(before_epoch.minute() == 17);
+  CHECK(before_epoch.second() == 40);
+
+  const PreciseDateTime precise(2023, 12, 1, 14, 30, 25, 123);
+  const auto fraction =
+      PreciseTimeDelta::fromDuration(std::chrono::microseconds(456));
+  CHECK((precise + fraction).microsecond() == 123456);
+}
+
+TEST_CASE("DateTimeCore arithmetic and Julian dates", "[datetime_core]") {
+  const DateTime start(2024, 1, 31);
+  const auto end = start + TimeDelta::fromDays(30);
+  CHECK(end.month() == 3);
+  CHECK(end.day() == 1);
+  CHECK((end - start).totalDays() == 30);
+  CHECK(end.timestamp() > start.timestamp());
+  CHECK(end.floor_to_month().timestamp() == DateTime(2024, 3, 1).timestamp());
+  CHECK(start.ceil_to_month().timestamp() ==
+        DateTime(2024, 2, 1).timestamp());
+
+  const DateTime j2000(2000, 1, 1, 12);
+  CHECK(j2000.julianDay() == Catch::Approx(2451545.0));
+  CHECK(j2000.julianCentury() == Catch::Approx(0.0));
+  CHECK(DateTime(2100, 1, 1, 12).julianCentury() ==
+        Catch::Approx(1.0).epsilon(1e-12));
+
+  const CompactDateTime compact(2030, 6, 15, 6);
+  CHECK(compact.year() == 2030);
+  CHECK(compact.hour() == 6);
+  CHECK(compact.timestamp() == DateTime(2030, 6, 15, 6).timestamp());
+}
+
+TEST_CASE("CalendarMath timestamp functions match DateTime",
+          "[datetime_core]") {
+  // One step is a prime number of milliseconds so the clock fields vary
+  const int64_t step = 7919LL * 3600000LL + 4817LL;
+  for (int64_t timestamp = -93000000000000; timestamp < 253402300800000;
+       timestamp += step * 3) {
+    const DateTime dt(timestamp);
+    CalendarMath::s_Fields fields{};
+    CalendarMath::timestamp_fields(timestamp, fields);
+    const auto expected = dt.to_fields();
+    REQUIRE(fields.year == expected.year);
+    REQUIRE(fields.month == expected.month);
+    REQUIRE(fields.day == expected.day);
+    REQUIRE(fields.hour == expected.hour);
+    REQUIRE(fields.minute == expected.minute);
+    REQUIRE(fields.second == expected.second);
+    REQUIRE(fields.millisecond == expected.millisecond);
+    REQUIRE(CalendarMath::fields_timestamp(fields) == timestamp);
+    REQUIRE(CalendarMath::julian_day(fields) == dt.julianDay());
+    REQUIRE(CalendarMath::julian_century(CalendarMath::julian_day(fields)) ==
+            dt.julianCentury());
+  }
+}
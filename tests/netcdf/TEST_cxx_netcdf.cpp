@@ -0,0 +1,212 @@
+#define CATCH_CONFIG_MAIN
+#include <netcdf.h>
+
+#include <catch2/catch_test_macros.hpp>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "DateTime.hpp"
+#include "NetCDFTimeReader.hpp"
+
+namespace {
+
+constexpr size_t TIME_LENGTH = 10;
+constexpr size_t FILL_INDEX = 3;
+
+/**
+ * @brief Adds a one dimensional time variable with CF attributes
+ *
+ * @param ncid The file being defined
+ * @param dimid The time dimension
+ * @param name Name of the variable
+ * @param type Type of the variable
+ * @param units The units attribute
+ * @param calendar The calendar attribute, or nullptr for none
+ * @return int The variable id
+ */
+auto define_time(const int ncid, const int dimid, const char* name,
+                 const nc_type type, const char* units, const char* calendar)
+    -> int {
+  int varid = -1;
+  REQUIRE(nc_def_var(ncid, name, type, 1, &dimid, &varid) == NC_NOERR);
+  REQUIRE(nc_put_att_text(ncid, varid, "units", std::strlen(units), units) ==
+          NC_NOERR);
+  if (calendar != nullptr) {
+    REQUIRE(nc_put_att_text(ncid, varid, "calendar", std::strlen(calendar),
+                            calendar) == NC_NOERR);
+  }
+  return varid;
+}
+
+/**
+ * @brief Writes a small CF file with every variable the tests read
+ *
+ * Each variable holds TIME_LENGTH values, 6 hours apart from the reference
+ * time, with a _FillValue at FILL_INDEX where one is defined.
+ *
+ * @param path Path of the file
+ */
+void write_cf_file(const std::string& path) {
+  int ncid = -1;
+  REQUIRE(nc_create(path.c_str(), NC_CLOBBER | NC_NETCDF4, &ncid) ==
+          NC_NOERR);
+  int dimid = -1;
+  REQUIRE(nc_def_dim(ncid, "time", TIME_LENGTH, &dimid) == NC_NOERR);
+
+  const int time_double = define_time(ncid, dimid, "time", NC_DOUBLE,
+                                      "hours since 2024-01-01 00:00:00",
+                                      "gregorian");
+  const double double_fill = -9999.0;
+  REQUIRE(nc_put_att_double(ncid, time_double, "_FillValue", NC_DOUBLE, 1,
+                            &double_fill) == NC_NOERR);
+
+  const int time_float = define_time(ncid, dimid, "time_float", NC_FLOAT,
+                                     "days since 2024-01-01", nullptr);
+  const float float_fill = 1.0e20F;
+  REQUIRE(nc_put_att_float(ncid, time_float, "_FillValue", NC_FLOAT, 1,
+                           &float_fill) == NC_NOERR);
+
+  const int time_int = define_time(ncid, dimid, "time_int", NC_INT,
+                                   "minutes since 2024-01-01T00:00:00",
+                                   "proleptic_gregorian");
+  const int int_fill = -1;
+  REQUIRE(nc_put_att_int(ncid, time_int, "_FillValue", NC_INT, 1,
+                         &int_fill) == NC_NOERR);
+  REQUIRE(nc_def_var_chunking(ncid, time_int, NC_CONTIGUOUS, nullptr) ==
+          NC_NOERR);
+
+  const int time_chunked = define_time(ncid, dimid, "time_chunked", NC_INT64,
+                                       "seconds since 2024-01-01", "standard");
+  const size_t storage_chunk = 4;
+  REQUIRE(nc_def_var_chunking(ncid, time_chunked, NC_CHUNKED,
+                              &storage_chunk) == NC_NOERR);
+
+  const int time_noleap = define_time(ncid, dimid, "time_noleap", NC_DOUBLE,
+                                      "hours since 2024-01-01", "noleap");
+  REQUIRE(nc_enddef(ncid) == NC_NOERR);
+
+  std::vector<double> hours(TIME_LENGTH);
+  std::vector<float> days(TIME_LENGTH);
+  std::vector<int> minutes(TIME_LENGTH);
+  std::vector<long long> seconds(TIME_LENGTH);
+  for (size_t i = 0; i < TIME_LENGTH; ++i) {
+    hours[i] = 6.0 * static_cast<double>(i);
+    days[i] = 0.25F * static_cast<float>(i);
+    minutes[i] = 360 * static_cast<int>(i);
+    seconds[i] = 21600 * static_cast<long long>(i);
+  }
+  hours[FILL_INDEX] = double_fill;
+  days[FILL_INDEX] = float_fill;
+  minutes[FILL_INDEX] = int_fill;
+
+  REQUIRE(nc_put_var_double(ncid, time_double, hours.data()) == NC_NOERR);
+  REQUIRE(nc_put_var_float(ncid, time_float, days.data()) == NC_NOERR);
+  REQUIRE(nc_put_var_int(ncid, time_int, minutes.data()) == NC_NOERR);
+  REQUIRE(nc_put_var_longlong(ncid, time_chunked, seconds.data()) ==
+          NC_NOERR);
+  REQUIRE(nc_put_var_double(ncid, time_noleap, hours.data()) == NC_NOERR);
+  REQUIRE(nc_close(ncid) == NC_NOERR);
+}
+
+/**
+ * @brief Checks the decoded times, 6 hours apart from 2024-01-01
+ *
+ * @param times The timestamps read from the file
+ * @param has_fill True if the value at FILL_INDEX is a _FillValue
+ */
+void check_times(const std::vector<int64_t>& times, const bool has_fill) {
+  REQUIRE(times.size() == TIME_LENGTH);
+  const auto reference = DateTime(2024, 1, 1);
+  for (size_t i = 0; i < TIME_LENGTH; ++i) {
+    if (has_fill && i == FILL_INDEX) {
+      CHECK(times[i] == DateTime::INVALID_TIMESTAMP);
+    } else {
+      CHECK(times[i] ==
+            (reference + TimeDelta::fromHours(6 * static_cast<int64_t>(i)))
+                .timestamp());
+    }
+  }
+}
+
+}  // namespace
+
+TEST_CASE("NetCDF CF time variables", "[NetCDFTimeReader]") {
+  const auto path =
+      (std::filesystem::temp_directory_path() / "fdate_netcdf_test.nc")
+          .string();
+  write_cf_file(path);
+
+  SECTION("Double values with a _FillValue") {
+    NetCDFTimeReader reader(path);
+    REQUIRE(reader.valid());
+    CHECK(reader.error().empty());
+    CHECK(reader.size() == TIME_LENGTH);
+    check_times(reader.read_all(), true);
+  }
+
+  SECTION("Float values with a _FillValue") {
+    NetCDFTimeReader reader(path, "time_float");
+    REQUIRE(reader.valid());
+    check_times(reader.read_all(), true);
+  }
+
+  SECTION("Integer values with a _FillValue") {
+    NetCDFTimeReader reader(path, "time_int");
+    REQUIRE(reader.valid());
+    check_times(reader.read_all(), true);
+
+    // A section inside the variable
+    std::vector<int64_t> section(4);
+    CHECK(reader.read(2, section.size(), section.data()));
+    CHECK(section[0] == DateTime(2024, 1, 1, 12).timestamp());
+    CHECK(section[1] == DateTime::INVALID_TIMESTAMP);
+    CHECK(section[3] == DateTime(2024, 1, 2, 6).timestamp());
+
+    CHECK_FALSE(reader.read(8, section.size(), section.data()));
+    CHECK_FALSE(reader.error().empty());
+  }
+
+  SECTION("Chunks smaller than the variable") {
+    NetCDFTimeReader small(path, "time_int", 3);
+    REQUIRE(small.valid());
+    CHECK(small.chunk_size() == 3);
+    check_times(small.read_all(), true);
+
+    // The chunk size is rounded up to whole storage chunks of 4 values
+    NetCDFTimeReader reader(path, "time_chunked", 3);
+    REQUIRE(reader.valid());
+    CHECK(reader.chunk_size() == 4);
+
+    std::vector<size_t> starts;
+    std::vector<int64_t> times;
+    CHECK(reader.for_each_chunk(
+        [&](const size_t start, const int64_t* timestamps, const size_t n) {
+          starts.push_back(start);
+          times.insert(times.end(), timestamps, timestamps + n);
+        }));
+    CHECK(starts == std::vector<size_t>{0, 4, 8});
+    check_times(times, false);
+  }
+
+  SECTION("Unsupported calendars are rejected") {
+    NetCDFTimeReader reader(path, "time_noleap");
+    CHECK_FALSE(reader.valid());
+    CHECK(reader.error().find("noleap") != std::string::npos);
+    CHECK(reader.read_all().empty());
+  }
+
+  SECTION("Missing files and variables report an error") {
+    NetCDFTimeReader missing_file(path + ".missing");
+    CHECK_FALSE(missing_file.valid());
+    CHECK_FALSE(missing_file.error().empty());
+
+    NetCDFTimeReader missing_variable(path, "missing");
+    CHECK_FALSE(missing_variable.valid());
+    CHECK_FALSE(missing_variable.error().empty());
+  }
+
+  std::remove(path.c_str());
+}